@@ -0,0 +1,117 @@
+//-------------------------------------------------------------------------//
+//
+// Copyright 2017 Sascha Kaden
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-------------------------------------------------------------------------//
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+#include <ippp/dataObj/Node.hpp>
+#include <ippp/modules/distanceMetrics/L2Metric.hpp>
+#include <ippp/modules/neighborFinders/KDTree.hpp>
+#include <ippp/modules/neighborFinders/SimdBruteForceNF.hpp>
+#include <ippp/modules/neighborFinders/StaticKDTree.hpp>
+
+using namespace ippp;
+
+const size_t numNNSQueries = 1000;
+const size_t numRSQueries = 100;
+
+double elapsedMs(const std::chrono::system_clock::time_point &startTime) {
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now() - startTime);
+    return duration.count() / 1000.0;
+}
+
+template <unsigned int dim>
+void benchmarkFinder(NeighborFinder<dim, std::shared_ptr<Node<dim>>> &finder, const std::vector<Vector<dim>> &queries,
+                     const double range, const double buildTime) {
+    auto startTime = std::chrono::system_clock::now();
+    size_t found = 0;
+    for (size_t i = 0; i < numNNSQueries; ++i)
+        if (finder.searchNearestNeighbor(queries[i]))
+            ++found;
+    double nnsTime = elapsedMs(startTime);
+
+    startTime = std::chrono::system_clock::now();
+    for (auto &node : finder.searchNearestNeighbors(queries))
+        if (node)
+            ++found;
+    double batchTime = elapsedMs(startTime);
+
+    startTime = std::chrono::system_clock::now();
+    for (size_t i = 0; i < numRSQueries; ++i)
+        found += finder.searchRange(queries[i], range).size();
+    double rsTime = elapsedMs(startTime);
+
+    std::cout << std::setw(16) << finder.getName() << std::setw(12) << buildTime << std::setw(12) << nnsTime
+              << std::setw(12) << batchTime << std::setw(12) << rsTime << std::setw(12) << found << std::endl;
+}
+
+template <unsigned int dim>
+void benchmark(const size_t numNodes) {
+    std::cout << "dim: " << dim << ", nodes: " << numNodes << std::endl;
+    std::cout << std::setw(16) << "finder" << std::setw(12) << "build [ms]" << std::setw(12) << "NNS [ms]" << std::setw(12)
+              << "batch [ms]" << std::setw(12) << "RS [ms]" << std::setw(12) << "results" << std::endl;
+
+    std::srand(1);
+    std::vector<std::shared_ptr<Node<dim>>> nodes;
+    nodes.reserve(numNodes);
+    for (size_t i = 0; i < numNodes; ++i)
+        nodes.push_back(std::make_shared<Node<dim>>(Vector<dim>::Random() * 100));
+    std::vector<Vector<dim>> queries;
+    for (size_t i = 0; i < numNNSQueries; ++i)
+        queries.push_back(Vector<dim>::Random() * 100);
+    // range with roughly 50 expected neighbors
+    double range = 200 * std::pow(50.0 / numNodes, 1.0 / dim) / 2;
+
+    auto metric = std::make_shared<L2Metric<dim>>();
+
+    auto startTime = std::chrono::system_clock::now();
+    KDTree<dim, std::shared_ptr<Node<dim>>> kdTree(metric);
+    for (auto &node : nodes)
+        kdTree.addNode(node->getValues(), node);
+    benchmarkFinder<dim>(kdTree, queries, range, elapsedMs(startTime));
+
+    startTime = std::chrono::system_clock::now();
+    StaticKDTree<dim, std::shared_ptr<Node<dim>>> staticKDTree(metric);
+    staticKDTree.rebaseSorted(nodes);
+    benchmarkFinder<dim>(staticKDTree, queries, range, elapsedMs(startTime));
+
+    // linear scan is only reasonable for small graphs
+    if (numNodes <= 100000) {
+        startTime = std::chrono::system_clock::now();
+        SimdBruteForceNF<dim, std::shared_ptr<Node<dim>>> simdBruteForce(metric, nodes);
+        benchmarkFinder<dim>(simdBruteForce, queries, range, elapsedMs(startTime));
+    }
+    std::cout << std::endl;
+}
+
+template <unsigned int dim>
+void benchmarkSizes() {
+    benchmark<dim>(10000);
+    benchmark<dim>(100000);
+    benchmark<dim>(1000000);
+}
+
+int main(int argc, char** argv) {
+    Logging::setLogLevel(LogLevel::off);
+
+    benchmarkSizes<2>();
+    benchmarkSizes<6>();
+    benchmarkSizes<7>();
+    return 0;
+}
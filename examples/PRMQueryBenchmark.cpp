@@ -0,0 +1,88 @@
+//-------------------------------------------------------------------------//
+//
+// Copyright 2017 Sascha Kaden
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-------------------------------------------------------------------------//
+
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#include <ippp/Core.h>
+#include <ippp/Environment.h>
+#include <ippp/Planner.h>
+#include <ippp/ui/EnvironmentConfigurator.h>
+#include <ippp/ui/ModuleConfigurator.hpp>
+
+using namespace ippp;
+
+const unsigned int dim = 2;
+const size_t numRoadmapNodes = 5000;
+const size_t numQueries = 2000;
+
+int main(int argc, char** argv) {
+    Logging::setLogLevel(LogLevel::off);
+
+    EnvironmentConfigurator environmentConfig;
+    environmentConfig.setWorkspaceProperties(2, AABB(Vector3(0, 0, 0), Vector3(1000, 1000, 1000)));
+    environmentConfig.setRobotType(RobotType::Point);
+    auto environment = environmentConfig.getEnvironment();
+
+    ModuleConfigurator<dim> moduleConfig;
+    moduleConfig.setEnvironment(environment);
+    moduleConfig.setCollisionType(CollisionType::Dim2);
+    moduleConfig.setMetricType(MetricType::L2);
+    moduleConfig.setNeighborFinderType(NeighborType::KDTree);
+    moduleConfig.setSamplerType(SamplerType::SamplerUniform);
+    moduleConfig.setSamplingType(SamplingType::Straight);
+    moduleConfig.setTrajectoryType(TrajectoryType::Linear);
+
+    // build the roadmap once and serve all queries from it
+    PRM<dim> prm(environment, moduleConfig.getPRMOptions(40), moduleConfig.getGraph());
+    prm.expand(numRoadmapNodes, 1);
+    prm.setFrozen(true);
+
+    std::srand(1);
+    std::vector<std::pair<Vector<dim>, Vector<dim>>> queries;
+    for (size_t i = 0; i < numQueries; ++i)
+        queries.push_back(std::make_pair(Vector<dim>::Random().cwiseAbs() * 1000, Vector<dim>::Random().cwiseAbs() * 1000));
+
+    std::cout << "roadmap nodes: " << moduleConfig.getGraph()->nodeSize() << ", queries: " << numQueries << std::endl;
+    std::cout << std::setw(12) << "threads" << std::setw(12) << "time [ms]" << std::setw(16) << "queries/sec"
+              << std::setw(12) << "solved" << std::endl;
+    for (unsigned int numThreads : {1, 2, 4, 8}) {
+        std::atomic<size_t> nextQuery(0);
+        std::atomic<size_t> solved(0);
+        auto startTime = std::chrono::system_clock::now();
+        std::vector<std::thread> threads;
+        for (unsigned int i = 0; i < numThreads; ++i) {
+            threads.push_back(std::thread([&]() {
+                for (size_t query = nextQuery++; query < numQueries; query = nextQuery++)
+                    if (!prm.queryRoadmap(queries[query].first, queries[query].second).empty())
+                        ++solved;
+            }));
+        }
+        for (auto &thread : threads)
+            thread.join();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now() - startTime);
+
+        double ms = duration.count() / 1000.0;
+        std::cout << std::setw(12) << numThreads << std::setw(12) << ms << std::setw(16) << numQueries / ms * 1000
+                  << std::setw(12) << solved << std::endl;
+    }
+    return 0;
+}
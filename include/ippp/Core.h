@@ -23,13 +23,16 @@
 #include <ippp/modules/collisionDetection/CollisionDetection2D.hpp>
 #include <ippp/modules/collisionDetection/CollisionDetectionAABB.hpp>
 #include <ippp/modules/collisionDetection/CollisionDetectionAlwaysValid.hpp>
+#include <ippp/modules/collisionDetection/CollisionDetectionCache.hpp>
 #include <ippp/modules/collisionDetection/CollisionDetectionFcl.hpp>
 #include <ippp/modules/collisionDetection/CollisionDetectionPqp.hpp>
 #include <ippp/modules/collisionDetection/CollisionDetectionSphere.hpp>
 #include <ippp/modules/collisionDetection/CollisionDetectionTriangleRobot.hpp>
 
+#include <ippp/dataObj/AStarScratch.hpp>
 #include <ippp/dataObj/Graph.hpp>
 #include <ippp/dataObj/Node.hpp>
+#include <ippp/dataObj/NodeArena.hpp>
 #include <ippp/dataObj/PointList.hpp>
 
 #include <ippp/modules/distanceMetrics/DistanceMetric.hpp>
@@ -47,8 +50,11 @@
 #include <ippp/modules/evaluator/TimeEvaluator.hpp>
 
 #include <ippp/modules/neighborFinders/BruteForceNF.hpp>
+#include <ippp/modules/neighborFinders/ConcurrentKDTree.hpp>
 #include <ippp/modules/neighborFinders/KDTree.hpp>
 #include <ippp/modules/neighborFinders/NeighborFinder.hpp>
+#include <ippp/modules/neighborFinders/SimdBruteForceNF.hpp>
+#include <ippp/modules/neighborFinders/StaticKDTree.hpp>
 
 #include <ippp/modules/pathModifier/DummyPathModifier.hpp>
 #include <ippp/modules/pathModifier/NodeCutPathModifier.hpp>
@@ -68,8 +74,10 @@
 #include <ippp/modules/sampling/SamplingNearObstacle.hpp>
 #include <ippp/modules/sampling/StraightSampling.hpp>
 
+#include <ippp/modules/trajectoryPlanner/ConservativeTrajectory.hpp>
 #include <ippp/modules/trajectoryPlanner/LinearTrajectory.hpp>
 #include <ippp/modules/trajectoryPlanner/RotateAtS.hpp>
+#include <ippp/modules/trajectoryPlanner/TrajectoryCache.hpp>
 
 #include <ippp/statistic/StatisticCollector.h>
 #include <ippp/statistic/StatisticContainer.h>
@@ -81,4 +89,5 @@
 #include <ippp/util/UtilGeo.hpp>
 #include <ippp/util/UtilIO.hpp>
 #include <ippp/util/UtilList.hpp>
+#include <ippp/util/UtilSimd.hpp>
 #include <ippp/util/UtilVec.hpp>
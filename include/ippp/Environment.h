@@ -28,11 +28,14 @@
 #include <ippp/environment/model/ModelPqp.h>
 #include <ippp/environment/model/ModelTriangle2D.h>
 
+#include <ippp/environment/robot/ForwardKinematics.hpp>
 #include <ippp/environment/robot/Jaco.h>
 #include <ippp/environment/robot/Joint.h>
+#include <ippp/environment/robot/KukaKR5.h>
 #include <ippp/environment/robot/MobileRobot.h>
 #include <ippp/environment/robot/PointRobot.h>
 #include <ippp/environment/robot/RobotBase.h>
+#include <ippp/environment/robot/SelfCollisionMatrix.h>
 #include <ippp/environment/robot/SerialRobot.h>
 #include <ippp/environment/robot/SerialRobot2D.h>
 #include <ippp/environment/robot/TriangleRobot2D.h>
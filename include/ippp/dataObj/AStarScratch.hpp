@@ -0,0 +1,347 @@
+//-------------------------------------------------------------------------//
+//
+// Copyright 2017 Sascha Kaden
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-------------------------------------------------------------------------//
+
+#ifndef ASTARSCRATCH_HPP
+#define ASTARSCRATCH_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <ippp/dataObj/Node.hpp>
+
+namespace ippp {
+
+/*!
+* \brief   Class AStarScratch holds the state of one A* query, indexed by the NodeId of the Nodes.
+* \details The open set is a binary heap with decrease key, the closed set a bitset. The Nodes of the Graph are not
+* modified by the search, with one scratch buffer per thread several queries can run concurrently on one roadmap. The
+* buffer can be reused, clear() only resets the touched entries.
+* \author  Sascha Kaden
+* \date    2017-11-28
+*/
+template <unsigned int dim>
+class AStarScratch {
+  public:
+    bool addNode(const std::shared_ptr<Node<dim>> &node);
+    bool contains(const NodeId id) const;
+
+    void updateOpen(const NodeId id, const double cost, const double estimate, const NodeId parent);
+    NodeId popOpen();
+    bool emptyOpen() const;
+
+    double getCost(const NodeId id) const;
+    std::shared_ptr<Node<dim>> getNode(const NodeId id) const;
+    bool isClosed(const NodeId id) const;
+    void setClosed(const NodeId id, const bool closed);
+    void setTargetEdge(const NodeId id, const double cost);
+    double getTargetEdge(const NodeId id) const;
+
+    std::vector<std::shared_ptr<Node<dim>>> getPath(const NodeId target) const;
+    void clear();
+
+  private:
+    void siftUp(size_t index);
+    void siftDown(size_t index);
+    void swapHeap(const size_t a, const size_t b);
+
+    static constexpr size_t m_notInHeap = std::numeric_limits<size_t>::max();
+
+    std::vector<std::shared_ptr<Node<dim>>> m_nodes;
+    std::vector<double> m_costs;
+    std::vector<double> m_estimates;
+    std::vector<NodeId> m_parents;
+    std::vector<double> m_targetEdges;
+    std::vector<size_t> m_heapIndices;
+    std::vector<uint64_t> m_closed;
+    std::vector<NodeId> m_heap;
+    std::vector<NodeId> m_touched;
+};
+
+template <unsigned int dim>
+constexpr size_t AStarScratch<dim>::m_notInHeap;
+
+/*!
+*  \brief      Register the Node inside of the buffer, the NodeId has to be unique (e.g. set by the Graph).
+*  \author     Sascha Kaden
+*  \param[in]  Node
+*  \param[out] false, if the Node has no id or another Node with the same id is registered
+*  \date       2017-11-28
+*/
+template <unsigned int dim>
+bool AStarScratch<dim>::addNode(const std::shared_ptr<Node<dim>> &node) {
+    const NodeId id = node->getId();
+    if (id == INVALID_NODE_ID)
+        return false;
+
+    if (id >= m_nodes.size()) {
+        size_t size = std::max<size_t>(id + 1, 2 * m_nodes.size());
+        m_nodes.resize(size);
+        m_costs.resize(size, std::numeric_limits<double>::max());
+        m_estimates.resize(size, std::numeric_limits<double>::max());
+        m_parents.resize(size, INVALID_NODE_ID);
+        m_targetEdges.resize(size, std::numeric_limits<double>::max());
+        m_heapIndices.resize(size, m_notInHeap);
+        m_closed.resize((size + 63) / 64, 0);
+    }
+    if (m_nodes[id])
+        return m_nodes[id] == node;
+
+    m_nodes[id] = node;
+    m_touched.push_back(id);
+    return true;
+}
+
+/*!
+*  \brief      Return true, if a Node with the id is registered
+*  \author     Sascha Kaden
+*  \param[in]  NodeId
+*  \param[out] result
+*  \date       2017-11-28
+*/
+template <unsigned int dim>
+bool AStarScratch<dim>::contains(const NodeId id) const {
+    return id < m_nodes.size() && m_nodes[id] != nullptr;
+}
+
+/*!
+*  \brief      Set cost and parent of the registered Node and insert it to the open set or decrease its key.
+*  \author     Sascha Kaden
+*  \param[in]  NodeId
+*  \param[in]  cost from the source
+*  \param[in]  estimated total cost (cost + heuristic)
+*  \param[in]  NodeId of the parent
+*  \date       2017-11-28
+*/
+template <unsigned int dim>
+void AStarScratch<dim>::updateOpen(const NodeId id, const double cost, const double estimate, const NodeId parent) {
+    m_costs[id] = cost;
+    m_parents[id] = parent;
+    const bool increased = estimate > m_estimates[id];
+    m_estimates[id] = estimate;
+    if (m_heapIndices[id] == m_notInHeap) {
+        m_heap.push_back(id);
+        m_heapIndices[id] = m_heap.size() - 1;
+        siftUp(m_heap.size() - 1);
+    } else if (increased) {
+        siftDown(m_heapIndices[id]);
+    } else {
+        siftUp(m_heapIndices[id]);
+    }
+}
+
+/*!
+*  \brief      Remove the Node with the smallest estimated cost from the open set and return its id.
+*  \author     Sascha Kaden
+*  \param[out] NodeId
+*  \date       2017-11-28
+*/
+template <unsigned int dim>
+NodeId AStarScratch<dim>::popOpen() {
+    const NodeId id = m_heap.front();
+    swapHeap(0, m_heap.size() - 1);
+    m_heap.pop_back();
+    m_heapIndices[id] = m_notInHeap;
+    if (!m_heap.empty())
+        siftDown(0);
+    return id;
+}
+
+/*!
+*  \brief      Return true, if the open set is empty
+*  \author     Sascha Kaden
+*  \param[out] result
+*  \date       2017-11-28
+*/
+template <unsigned int dim>
+bool AStarScratch<dim>::emptyOpen() const {
+    return m_heap.empty();
+}
+
+/*!
+*  \brief      Return the cost from the source to the Node, max double if it wasn't reached.
+*  \author     Sascha Kaden
+*  \param[in]  NodeId
+*  \param[out] cost
+*  \date       2017-11-28
+*/
+template <unsigned int dim>
+double AStarScratch<dim>::getCost(const NodeId id) const {
+    return m_costs[id];
+}
+
+/*!
+*  \brief      Return the registered Node of the id
+*  \author     Sascha Kaden
+*  \param[in]  NodeId
+*  \param[out] Node
+*  \date       2017-11-28
+*/
+template <unsigned int dim>
+std::shared_ptr<Node<dim>> AStarScratch<dim>::getNode(const NodeId id) const {
+    return m_nodes[id];
+}
+
+/*!
+*  \brief      Return true, if the Node is inside of the closed set
+*  \author     Sascha Kaden
+*  \param[in]  NodeId
+*  \param[out] result
+*  \date       2017-11-28
+*/
+template <unsigned int dim>
+bool AStarScratch<dim>::isClosed(const NodeId id) const {
+    return (m_closed[id / 64] >> (id % 64)) & 1;
+}
+
+/*!
+*  \brief      Add or remove the Node from the closed set
+*  \author     Sascha Kaden
+*  \param[in]  NodeId
+*  \param[in]  closed
+*  \date       2017-11-28
+*/
+template <unsigned int dim>
+void AStarScratch<dim>::setClosed(const NodeId id, const bool closed) {
+    if (closed)
+        m_closed[id / 64] |= uint64_t(1) << (id % 64);
+    else
+        m_closed[id / 64] &= ~(uint64_t(1) << (id % 64));
+}
+
+/*!
+*  \brief      Set an additional edge from the registered Node to the target, which is not stored at the Node.
+*  \author     Sascha Kaden
+*  \param[in]  NodeId
+*  \param[in]  edge cost
+*  \date       2017-11-29
+*/
+template <unsigned int dim>
+void AStarScratch<dim>::setTargetEdge(const NodeId id, const double cost) {
+    m_targetEdges[id] = cost;
+}
+
+/*!
+*  \brief      Return the cost of the additional edge to the target, max double if the Node has none.
+*  \author     Sascha Kaden
+*  \param[in]  NodeId
+*  \param[out] edge cost
+*  \date       2017-11-29
+*/
+template <unsigned int dim>
+double AStarScratch<dim>::getTargetEdge(const NodeId id) const {
+    return m_targetEdges[id];
+}
+
+/*!
+*  \brief      Return the path from the source to the target by following the parents.
+*  \author     Sascha Kaden
+*  \param[in]  NodeId of the target
+*  \param[out] Nodes of the path, beginning with the source
+*  \date       2017-11-28
+*/
+template <unsigned int dim>
+std::vector<std::shared_ptr<Node<dim>>> AStarScratch<dim>::getPath(const NodeId target) const {
+    std::vector<std::shared_ptr<Node<dim>>> path;
+    for (NodeId id = target; id != INVALID_NODE_ID; id = m_parents[id])
+        path.push_back(m_nodes[id]);
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+/*!
+*  \brief      Reset the entries of all touched Nodes, the reserved memory stays.
+*  \author     Sascha Kaden
+*  \date       2017-11-28
+*/
+template <unsigned int dim>
+void AStarScratch<dim>::clear() {
+    for (auto id : m_touched) {
+        m_nodes[id] = nullptr;
+        m_costs[id] = std::numeric_limits<double>::max();
+        m_estimates[id] = std::numeric_limits<double>::max();
+        m_parents[id] = INVALID_NODE_ID;
+        m_targetEdges[id] = std::numeric_limits<double>::max();
+        m_heapIndices[id] = m_notInHeap;
+        m_closed[id / 64] = 0;
+    }
+    m_touched.clear();
+    m_heap.clear();
+}
+
+/*!
+*  \brief      Move the heap entry up, until its parent has a smaller estimated cost
+*  \author     Sascha Kaden
+*  \param[in]  heap index
+*  \date       2017-11-28
+*/
+template <unsigned int dim>
+void AStarScratch<dim>::siftUp(size_t index) {
+    while (index > 0) {
+        size_t parent = (index - 1) / 2;
+        if (m_estimates[m_heap[parent]] <= m_estimates[m_heap[index]])
+            return;
+        swapHeap(index, parent);
+        index = parent;
+    }
+}
+
+/*!
+*  \brief      Move the heap entry down, until its children have larger estimated costs
+*  \author     Sascha Kaden
+*  \param[in]  heap index
+*  \date       2017-11-28
+*/
+template <unsigned int dim>
+void AStarScratch<dim>::siftDown(size_t index) {
+    const size_t size = m_heap.size();
+    while (true) {
+        size_t smallest = index;
+        size_t left = 2 * index + 1;
+        size_t right = left + 1;
+        if (left < size && m_estimates[m_heap[left]] < m_estimates[m_heap[smallest]])
+            smallest = left;
+        if (right < size && m_estimates[m_heap[right]] < m_estimates[m_heap[smallest]])
+            smallest = right;
+        if (smallest == index)
+            return;
+        swapHeap(index, smallest);
+        index = smallest;
+    }
+}
+
+/*!
+*  \brief      Swap two heap entries and update their indices
+*  \author     Sascha Kaden
+*  \param[in]  first heap index
+*  \param[in]  second heap index
+*  \date       2017-11-28
+*/
+template <unsigned int dim>
+void AStarScratch<dim>::swapHeap(const size_t a, const size_t b) {
+    std::swap(m_heap[a], m_heap[b]);
+    m_heapIndices[m_heap[a]] = a;
+    m_heapIndices[m_heap[b]] = b;
+}
+
+} /* namespace ippp */
+
+#endif /* ASTARSCRATCH_HPP */
@@ -0,0 +1,66 @@
+//-------------------------------------------------------------------------//
+//
+// Copyright 2017 Sascha Kaden
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-------------------------------------------------------------------------//
+
+
+#ifndef CONCURRENTKDNODE_HPP
+#define CONCURRENTKDNODE_HPP
+
+#include <atomic>
+
+#include <ippp/types.h>
+
+namespace ippp {
+
+/*!
+* \brief   Class ConcurrentKDNode is the node object of the ConcurrentKDTree
+* \details The child pointer are atomic, they are set once by a compare and swap and never changed afterwards. All other
+* members are written before the node is published inside of the tree.
+* \author  Sascha Kaden
+* \date    2017-11-23
+*/
+template <unsigned int dim, typename T>
+class ConcurrentKDNode {
+  public:
+    ConcurrentKDNode(const Vector<dim> &config, const T &node, const unsigned int axis);
+
+    std::atomic<ConcurrentKDNode<dim, T> *> left;
+    std::atomic<ConcurrentKDNode<dim, T> *> right;
+    Vector<dim> config;
+    T node;
+    unsigned int axis = 0;
+    double value = 0;
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+/*!
+*  \brief      Constructor of the class ConcurrentKDNode
+*  \author     Sascha Kaden
+*  \param[in]  position
+*  \param[in]  pointer to an extern object
+*  \param[in]  split axis
+*  \date       2017-11-23
+*/
+template <unsigned int dim, typename T>
+ConcurrentKDNode<dim, T>::ConcurrentKDNode(const Vector<dim> &config, const T &node, const unsigned int axis)
+    : left(nullptr), right(nullptr), config(config), node(node), axis(axis), value(config[axis]) {
+}
+
+} /* namespace ippp */
+
+#endif /* CONCURRENTKDNODE_HPP */
@@ -19,24 +19,34 @@
 #ifndef GRAPH_HPP
 #define GRAPH_HPP
 
+#include <atomic>
+
 #include <ippp/Identifier.h>
 #include <ippp/dataObj/Node.hpp>
+#include <ippp/dataObj/NodeArena.hpp>
 #include <ippp/modules/neighborFinders/KDTree.hpp>
 #include <ippp/util/Logging.h>
 
 namespace ippp {
 
+enum class NodeStorage { Shared, Arena };
+
 /*!
 * \brief   Class Graph contain all nodes of the planner and offers the nearest neighbor and range search through a KDTree.
+* \details With NodeStorage::Arena the Nodes are created by the Graph inside of a NodeArena, the Node pointer are
+* then not reference counted and are only valid as long as the Graph exists. The Graph owns the arena, its
+* NeighborFinder is cleared at the destruction of the Graph.
 * \author  Sascha Kaden
 * \date    2016-05-25
 */
 template <unsigned int dim>
 class Graph : public Identifier {
   public:
-    Graph(const size_t sortCount, const std::shared_ptr<NeighborFinder<dim, std::shared_ptr<Node<dim>>>> &neighborFinder);
+    Graph(const size_t sortCount, const std::shared_ptr<NeighborFinder<dim, std::shared_ptr<Node<dim>>>> &neighborFinder,
+          const NodeStorage storage = NodeStorage::Shared);
     ~Graph();
 
+    std::shared_ptr<Node<dim>> makeNode(const Vector<dim> &config);
     bool addNode(const std::shared_ptr<Node<dim>> &node);
     void addNodeList(const std::vector<std::shared_ptr<Node<dim>>> &nodes);
     bool containNode(const std::shared_ptr<Node<dim>> &node);
@@ -48,9 +58,12 @@ class Graph : public Identifier {
     std::shared_ptr<Node<dim>> getNearestNode(const Vector<dim> &config) const;
     std::shared_ptr<Node<dim>> getNearestNode(const Node<dim> &node) const;
     std::shared_ptr<Node<dim>> getNearestNode(const std::shared_ptr<Node<dim>> &node) const;
+    std::vector<std::shared_ptr<Node<dim>>> getNearestNodes(const std::vector<Vector<dim>> &configs) const;
     std::vector<std::shared_ptr<Node<dim>>> getNearNodes(const Vector<dim> &config, const double range) const;
     std::vector<std::shared_ptr<Node<dim>>> getNearNodes(const Node<dim> &node, const double range) const;
     std::vector<std::shared_ptr<Node<dim>>> getNearNodes(const std::shared_ptr<Node<dim>> node, const double range) const;
+    std::vector<std::shared_ptr<Node<dim>>> getKNearestNodes(const Vector<dim> &config, const size_t k) const;
+    std::vector<std::shared_ptr<Node<dim>>> getKNearestNodes(const std::shared_ptr<Node<dim>> &node, const size_t k) const;
 
     void sortTree();
     bool eraseNode(const std::shared_ptr<Node<dim>> &node);
@@ -60,6 +73,7 @@ class Graph : public Identifier {
     size_t edgeSize() const;
     size_t getSortCount() const;
     bool autoSort() const;
+    NodeStorage getNodeStorage() const;
     void preserveNodePtr();
 
     void clearParents();
@@ -77,34 +91,48 @@ class Graph : public Identifier {
 
   private:
     std::vector<std::shared_ptr<Node<dim>>> m_nodes;
+    std::atomic<size_t> m_nodeCount{0};    // size of m_nodes, readable without the lock
+    std::unique_ptr<NodeArena<dim>> m_arena = nullptr;
     std::shared_ptr<NeighborFinder<dim, std::shared_ptr<Node<dim>>>> m_neighborFinder = nullptr;
     std::mutex m_mutex;
     const size_t m_sortCount = 0;
     bool m_autoSort = false;
     bool m_preserveNodePtr = false;
+    const NodeStorage m_storage = NodeStorage::Shared;
 };
 
 /*!
 *  \brief      Default constructor of the class Graph
 *  \author     Sascha Kaden
+*  \param[in]  sort count
+*  \param[in]  NeighborFinder
+*  \param[in]  storage type of the Nodes
 *  \date       2016-06-02
 */
 template <unsigned int dim>
-Graph<dim>::Graph(const size_t sortCount, const std::shared_ptr<NeighborFinder<dim, std::shared_ptr<Node<dim>>>> &neighborFinder)
-    : Identifier("Graph"), m_sortCount(sortCount), m_neighborFinder(neighborFinder) {
+Graph<dim>::Graph(const size_t sortCount, const std::shared_ptr<NeighborFinder<dim, std::shared_ptr<Node<dim>>>> &neighborFinder,
+                  const NodeStorage storage)
+    : Identifier("Graph"), m_sortCount(sortCount), m_neighborFinder(neighborFinder), m_storage(storage) {
     m_autoSort = (sortCount != 0);
     // reserve memory for the node vector to reduce computation time at new memory allocation
     m_nodes.reserve(10000);
+    if (m_storage == NodeStorage::Arena)
+        m_arena = std::unique_ptr<NodeArena<dim>>(new NodeArena<dim>());
 }
 
 /*!
 *  \brief      Destructor of the class Graph
+*  \details    With NodeStorage::Arena the NeighborFinder is cleared, it must not keep pointer of the released arena.
 *  \author     Sascha Kaden
 *  \date       2017-01-07
 */
 template <unsigned int dim>
 Graph<dim>::~Graph() {
-    if (!m_preserveNodePtr) {
+    // arena Nodes hold no reference counted pointer, the arena releases them at once
+    if (m_storage == NodeStorage::Arena) {
+        std::vector<std::shared_ptr<Node<dim>>> noNodes;
+        m_neighborFinder->rebaseSorted(noNodes);
+    } else if (!m_preserveNodePtr) {
         for (auto &&node : m_nodes) {
             if (node) {
                 node->clearParent();
@@ -117,8 +145,28 @@ Graph<dim>::~Graph() {
     }
 }
 
+/*!
+* \brief      Create a new Node, which can be added to the Graph.
+* \details    With NodeStorage::Arena the Node is allocated inside of the arena of the Graph, otherwise a shared Node is
+* created.
+* \author     Sascha Kaden
+* \param[in]  configuration
+* \param[out] Node
+* \date       2017-11-20
+*/
+template <unsigned int dim>
+std::shared_ptr<Node<dim>> Graph<dim>::makeNode(const Vector<dim> &config) {
+    if (m_storage == NodeStorage::Shared)
+        return std::make_shared<Node<dim>>(config);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_arena->makeNode(config);
+}
+
 /*!
 * \brief      Add a Node to the graph
+* \details    The Node gets the index inside of the Graph as id. A concurrent NeighborFinder is filled without locking,
+* only the Node list is locked.
 * \author     Sascha Kaden
 * \param[in]  Node
 * \param[out] result, false if the Node is soon inside of the Graph
@@ -126,11 +174,18 @@ Graph<dim>::~Graph() {
 */
 template <unsigned int dim>
 bool Graph<dim>::addNode(const std::shared_ptr<Node<dim>> &node) {
+    if (m_neighborFinder->isConcurrent())
+        m_neighborFinder->addNode(node->getValues(), node);
+
     m_mutex.lock();
-    m_neighborFinder->addNode(node->getValues(), node);
+    if (!m_neighborFinder->isConcurrent())
+        m_neighborFinder->addNode(node->getValues(), node);
+    node->setId(static_cast<NodeId>(m_nodes.size()));
     m_nodes.push_back(node);
+    size_t nodeCount = m_nodes.size();
+    m_nodeCount = nodeCount;
     m_mutex.unlock();
-    if (m_autoSort && (m_nodes.size() % m_sortCount) == 0)
+    if (m_autoSort && (nodeCount % m_sortCount) == 0)
         sortTree();
 
     return true;
@@ -240,6 +295,18 @@ std::shared_ptr<Node<dim>> Graph<dim>::getNearestNode(const std::shared_ptr<Node
     return m_neighborFinder->searchNearestNeighbor(node->getValues());
 }
 
+/*!
+* \brief      Search the nearest nodes of a list of configurations at once
+* \author     Sascha Kaden
+* \param[in]  list of Vectors
+* \param[out] list of nearest nodes, the index equals the index of the Vector
+* \date       2017-11-25
+*/
+template <unsigned int dim>
+std::vector<std::shared_ptr<Node<dim>>> Graph<dim>::getNearestNodes(const std::vector<Vector<dim>> &configs) const {
+    return m_neighborFinder->searchNearestNeighbors(configs);
+}
+
 /*!
 * \brief      Search range
 * \author     Sascha Kaden
@@ -280,6 +347,33 @@ std::vector<std::shared_ptr<Node<dim>>> Graph<dim>::getNearNodes(const std::shar
     return m_neighborFinder->searchRange(node->getValues(), range);
 }
 
+/*!
+* \brief      Search the k nearest nodes
+* \author     Sascha Kaden
+* \param[in]  Vector for the search
+* \param[in]  number of nodes k
+* \param[out] list of the k nearest nodes, sorted by ascending distance
+* \date       2017-11-22
+*/
+template <unsigned int dim>
+std::vector<std::shared_ptr<Node<dim>>> Graph<dim>::getKNearestNodes(const Vector<dim> &config, const size_t k) const {
+    return m_neighborFinder->searchKNearest(config, k);
+}
+
+/*!
+* \brief      Search the k nearest nodes
+* \author     Sascha Kaden
+* \param[in]  Node for the search
+* \param[in]  number of nodes k
+* \param[out] list of the k nearest nodes, sorted by ascending distance
+* \date       2017-11-22
+*/
+template <unsigned int dim>
+std::vector<std::shared_ptr<Node<dim>>> Graph<dim>::getKNearestNodes(const std::shared_ptr<Node<dim>> &node,
+                                                                     const size_t k) const {
+    return m_neighborFinder->searchKNearest(node->getValues(), k);
+}
+
 /*!
 * \brief      Rebase the NeighborFinder with the node list from the graph.
 * \author     Sascha Kaden
@@ -320,7 +414,7 @@ bool Graph<dim>::eraseNode(const std::shared_ptr<Node<dim>> &node) {
 */
 template <unsigned int dim>
 bool Graph<dim>::empty() const {
-    if (m_nodes.empty())
+    if (m_nodeCount == 0)
         return true;
     else
         return false;
@@ -328,13 +422,14 @@ bool Graph<dim>::empty() const {
 
 /*!
 * \brief      Return size of the nodes of the graph
+* \details    Can be called while other threads add Nodes.
 * \author     Sascha Kaden
 * \param[out] size of Node vector
 * \date       2016-08-09
 */
 template <unsigned int dim>
 size_t Graph<dim>::nodeSize() const {
-    return m_nodes.size();
+    return m_nodeCount;
 }
 
 /*!
@@ -376,6 +471,17 @@ bool Graph<dim>::autoSort() const {
     return m_autoSort;
 }
 
+/*!
+* \brief      Return the storage type of the Nodes
+* \author     Sascha Kaden
+* \param[out] NodeStorage
+* \date       2017-11-20
+*/
+template <unsigned int dim>
+NodeStorage Graph<dim>::getNodeStorage() const {
+    return m_storage;
+}
+
 /*!
 * \brief      Clear all parent pointer from the nodes
 * \author     Sascha Kaden
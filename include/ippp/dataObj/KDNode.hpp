@@ -20,14 +20,17 @@
 #define KDNODE_HPP
 
 #include <Eigen/Core>
+#include <atomic>
 #include <cstdint>
+#include <memory>
 
 namespace ippp {
 
 /*!
 * \brief   Class KDNode is the node object of the KDTree
-* \details Owns the position of the node, pointer to left and right leaf, pointer to an extern object, axis split value and the
-* split value itself.
+* \details Owns the position of the node, pointer to left and right leaf, pointer to an extern object, axis split value, the
+* split value itself and the number of nodes of the subtree. The shared pointer own the leafs and are only used by the
+* inserting thread, the searches follow the atomic links, which are set at the same time by setLeft and setRight.
 * \author  Sascha Kaden
 * \date    2016-05-27
 */
@@ -36,12 +39,19 @@ class KDNode {
   public:
     KDNode(const Vector<dim> &config, const T &node);
 
+    void setLeft(const std::shared_ptr<KDNode<dim, T>> &leaf);
+    void setRight(const std::shared_ptr<KDNode<dim, T>> &leaf);
+
     std::shared_ptr<KDNode<dim, T>> left = nullptr;
     std::shared_ptr<KDNode<dim, T>> right = nullptr;
+    std::atomic<const KDNode<dim, T> *> leftLink;
+    std::atomic<const KDNode<dim, T> *> rightLink;
     Vector<dim> config;
     T node;
     unsigned int axis = 0;
     double value = 0;
+    size_t size = 1;
+    size_t stamp = 0;
 };
 
 /*!
@@ -52,10 +62,34 @@ class KDNode {
 *  \date       2016-05-27
 */
 template <unsigned int dim, typename T>
-KDNode<dim, T>::KDNode(const Vector<dim> &config, const T &node) {
+KDNode<dim, T>::KDNode(const Vector<dim> &config, const T &node) : leftLink(nullptr), rightLink(nullptr) {
     this->config = config;
     this->node = node;
 }
+
+/*!
+*  \brief      Set the left leaf and publish it for the searches
+*  \author     Sascha Kaden
+*  \param[in]  left leaf
+*  \date       2017-12-18
+*/
+template <unsigned int dim, typename T>
+void KDNode<dim, T>::setLeft(const std::shared_ptr<KDNode<dim, T>> &leaf) {
+    left = leaf;
+    leftLink.store(leaf.get(), std::memory_order_release);
+}
+
+/*!
+*  \brief      Set the right leaf and publish it for the searches
+*  \author     Sascha Kaden
+*  \param[in]  right leaf
+*  \date       2017-12-18
+*/
+template <unsigned int dim, typename T>
+void KDNode<dim, T>::setRight(const std::shared_ptr<KDNode<dim, T>> &leaf) {
+    right = leaf;
+    rightLink.store(leaf.get(), std::memory_order_release);
+}
 } /* namespace ippp */
 
 #endif /* KDNODE_HPP */
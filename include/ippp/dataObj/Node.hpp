@@ -20,20 +20,35 @@
 #define NODE_HPP
 
 #include <assert.h>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
+#include <limits>
 #include <memory>
+#include <thread>
 #include <vector>
 
 #include <Eigen/Core>
 
+#include <ippp/dataObj/NodeArena.hpp>
 #include <ippp/types.h>
 #include <ippp/util/UtilVec.hpp>
 
 namespace ippp {
 
+using NodeId = uint32_t;
+constexpr NodeId INVALID_NODE_ID = std::numeric_limits<NodeId>::max();
+
+/*!
+* \brief   Validity state of a child edge, edges of the lazy validation are unknown until they are checked.
+*/
+enum class EdgeState { Unknown, Valid, Invalid };
+
 /*!
 * \brief   Class Node to present nodes of the path planner.
-* \details Consists of the position by an Vec, a cost parameter, an Edge to the parent and a list of child Edges
+* \details Consists of the position by an Vec, a cost parameter, an Edge to the parent and a list of child Edges.
+* The child lists are guarded by a spin lock of the Node and are returned as copies. Children inside of the same
+* NodeArena are stored as index/cost pairs and are resolved by the arena.
 * \author  Sascha Kaden
 * \date    2016-05-23
 */
@@ -42,6 +57,8 @@ class Node {
   public:
     Node();
     Node(const Vector<dim> &config);
+    Node(const Node &node);
+    Node &operator=(const Node &node);
 
     bool empty() const;
 
@@ -59,28 +76,58 @@ class Node {
     std::pair<std::shared_ptr<Node<dim>>, double> getQueryParentEdge() const;
     void clearQueryParent();
 
-    void addChild(const std::shared_ptr<Node> &child, const double edgeCost);
+    void addChild(const std::shared_ptr<Node> &child, const double edgeCost, const EdgeState state = EdgeState::Valid);
     std::vector<std::shared_ptr<Node>> getChildNodes() const;
     std::vector<std::pair<std::shared_ptr<Node<dim>>, double>> getChildEdges() const;
     size_t getChildSize() const;
     bool isChild(const std::shared_ptr<Node> &child) const;
     void clearChildren();
 
+    EdgeState getChildState(const std::shared_ptr<Node> &child) const;
+    void setChildState(const std::shared_ptr<Node> &child, const EdgeState state);
+
     void addInvalidChild(const std::shared_ptr<Node> &child);
     bool isInvalidChild(const std::shared_ptr<Node> &node) const;
+    std::vector<std::shared_ptr<Node<dim>>> getInvalidChildren() const;
     void clearInvalidChildren();
 
     Vector<dim> getValues() const;
     double getValue(const unsigned int index) const;
 
+    void setId(const NodeId id);
+    NodeId getId() const;
+
   private:
+    friend class NodeArena<dim>;
+
+    /*!
+    * \brief   Child edge to a Node of the same NodeArena
+    */
+    struct ArenaEdge {
+        uint32_t index;
+        EdgeState state;
+        double cost;
+    };
+
+    bool isArenaNode(const std::shared_ptr<Node> &node) const;
+    void lockEdges() const;
+    void unlockEdges() const;
+
     Vector<dim> m_config;
     double m_cost = -1;
+    NodeId m_id = INVALID_NODE_ID;
 
     std::pair<std::shared_ptr<Node<dim>>, double> m_parent = std::make_pair(nullptr, 0);
     std::pair<std::shared_ptr<Node<dim>>, double> m_queryParent = std::make_pair(nullptr, 0);
     std::vector<std::pair<std::shared_ptr<Node<dim>>, double>> m_children;
+    std::vector<EdgeState> m_childStates;    // state of the edge at the same index of m_children
     std::vector<std::shared_ptr<Node>> m_invalidChildren;
+
+    NodeArena<dim> *m_arena = nullptr;    // arena of the Node, nullptr for shared Nodes
+    uint32_t m_arenaIndex = 0;
+    std::vector<ArenaEdge> m_arenaChildren;
+    std::vector<uint32_t> m_arenaInvalidChildren;
+    mutable std::atomic<bool> m_edgeLock{false};
 };
 
 /*!
@@ -106,6 +153,57 @@ Node<dim>::Node(const Vector<dim> &config) {
     m_config = config;
 }
 
+/*!
+*  \brief      Copy constructor of the class Node, the edges are copied under the lock of the passed Node.
+*  \author     Sascha Kaden
+*  \param[in]  Node
+*  \date       2017-12-18
+*/
+template <unsigned int dim>
+Node<dim>::Node(const Node &node) : m_config(node.m_config), m_cost(node.m_cost), m_id(node.m_id) {
+    node.lockEdges();
+    m_parent = node.m_parent;
+    m_queryParent = node.m_queryParent;
+    m_children = node.m_children;
+    m_childStates = node.m_childStates;
+    m_invalidChildren = node.m_invalidChildren;
+    m_arena = node.m_arena;
+    m_arenaIndex = node.m_arenaIndex;
+    m_arenaChildren = node.m_arenaChildren;
+    m_arenaInvalidChildren = node.m_arenaInvalidChildren;
+    node.unlockEdges();
+}
+
+/*!
+*  \brief      Assignment operator of the class Node, the lock of the Node isn't copied.
+*  \author     Sascha Kaden
+*  \param[in]  Node
+*  \param[out] reference of this Node
+*  \date       2017-12-18
+*/
+template <unsigned int dim>
+Node<dim> &Node<dim>::operator=(const Node &node) {
+    if (this == &node)
+        return *this;
+
+    Node copy(node);
+    lockEdges();
+    m_config = copy.m_config;
+    m_cost = copy.m_cost;
+    m_id = copy.m_id;
+    m_parent = std::move(copy.m_parent);
+    m_queryParent = std::move(copy.m_queryParent);
+    m_children = std::move(copy.m_children);
+    m_childStates = std::move(copy.m_childStates);
+    m_invalidChildren = std::move(copy.m_invalidChildren);
+    m_arena = copy.m_arena;
+    m_arenaIndex = copy.m_arenaIndex;
+    m_arenaChildren = std::move(copy.m_arenaChildren);
+    m_arenaInvalidChildren = std::move(copy.m_arenaInvalidChildren);
+    unlockEdges();
+    return *this;
+}
+
 /*!
 *  \brief      Return true, if the vector is empty
 *  \author     Sascha Kaden
@@ -244,14 +342,32 @@ void Node<dim>::clearQueryParent() {
 
 /*!
 *  \brief      Add a child Node to the child list
+*  \details    Edges of the lazy validation are added with an unknown state, invalid edges are added to the invalid
+*  children.
 *  \author     Sascha Kaden
 *  \param[in]  shared_ptr child Node
+*  \param[in]  edge cost
+*  \param[in]  state of the edge
 *  \date       2016-07-15
 */
 template <unsigned int dim>
-void Node<dim>::addChild(const std::shared_ptr<Node<dim>> &child, const double edgeCost) {
-    if (!child->empty())
+void Node<dim>::addChild(const std::shared_ptr<Node<dim>> &child, const double edgeCost, const EdgeState state) {
+    if (child->empty())
+        return;
+
+    if (state == EdgeState::Invalid) {
+        addInvalidChild(child);
+        return;
+    }
+
+    lockEdges();
+    if (isArenaNode(child)) {
+        m_arenaChildren.push_back(ArenaEdge{child->m_arenaIndex, state, edgeCost});
+    } else {
         m_children.push_back(std::make_pair(child, edgeCost));
+        m_childStates.push_back(state);
+    }
+    unlockEdges();
 }
 
 /*!
@@ -263,21 +379,34 @@ void Node<dim>::addChild(const std::shared_ptr<Node<dim>> &child, const double e
 template <unsigned int dim>
 std::vector<std::shared_ptr<Node<dim>>> Node<dim>::getChildNodes() const {
     std::vector<std::shared_ptr<Node>> childNodes;
+    lockEdges();
+    childNodes.reserve(m_arenaChildren.size() + m_children.size());
+    for (auto &child : m_arenaChildren)
+        childNodes.push_back(m_arena->getNode(child.index));
     for (auto &&child : m_children)
         childNodes.push_back(child.first);
+    unlockEdges();
 
     return childNodes;
 }
 
 /*!
-*  \brief      Return list of child edges
+*  \brief      Return a copy of the list of child edges, taken under the lock of the Node.
 *  \author     Sascha Kaden
 *  \param[out] list of child edges
 *  \date       2016-07-15
 */
 template <unsigned int dim>
 std::vector<std::pair<std::shared_ptr<Node<dim>>, double>> Node<dim>::getChildEdges() const {
-    return m_children;
+    std::vector<std::pair<std::shared_ptr<Node<dim>>, double>> childEdges;
+    lockEdges();
+    childEdges.reserve(m_arenaChildren.size() + m_children.size());
+    for (auto &child : m_arenaChildren)
+        childEdges.push_back(std::make_pair(m_arena->getNode(child.index), child.cost));
+    childEdges.insert(childEdges.end(), m_children.begin(), m_children.end());
+    unlockEdges();
+
+    return childEdges;
 }
 
 /*!
@@ -288,7 +417,10 @@ std::vector<std::pair<std::shared_ptr<Node<dim>>, double>> Node<dim>::getChildEd
 */
 template <unsigned int dim>
 size_t Node<dim>::getChildSize() const {
-    return m_children.size();
+    lockEdges();
+    size_t size = m_arenaChildren.size() + m_children.size();
+    unlockEdges();
+    return size;
 }
 
 /*!
@@ -300,11 +432,7 @@ size_t Node<dim>::getChildSize() const {
 */
 template <unsigned int dim>
 bool Node<dim>::isChild(const std::shared_ptr<Node<dim>> &node) const {
-    for (auto &child : m_children)
-        if (child.first == node)
-            return true;
-
-    return false;
+    return getChildState(node) != EdgeState::Invalid;
 }
 
 /*!
@@ -314,7 +442,87 @@ bool Node<dim>::isChild(const std::shared_ptr<Node<dim>> &node) const {
 */
 template <unsigned int dim>
 void Node<dim>::clearChildren() {
+    lockEdges();
     m_children.clear();
+    m_childStates.clear();
+    m_arenaChildren.clear();
+    unlockEdges();
+}
+
+/*!
+*  \brief      Return the state of the edge to the passed node
+*  \author     Sascha Kaden
+*  \param[in]  node
+*  \param[out] state of the edge, invalid if the node is no child
+*  \date       2017-12-04
+*/
+template <unsigned int dim>
+EdgeState Node<dim>::getChildState(const std::shared_ptr<Node<dim>> &node) const {
+    EdgeState state = EdgeState::Invalid;
+    lockEdges();
+    if (isArenaNode(node)) {
+        for (auto &child : m_arenaChildren) {
+            if (child.index == node->m_arenaIndex) {
+                state = child.state;
+                break;
+            }
+        }
+    } else {
+        for (size_t i = 0; i < m_children.size(); ++i) {
+            if (m_children[i].first == node) {
+                state = m_childStates[i];
+                break;
+            }
+        }
+    }
+    unlockEdges();
+    return state;
+}
+
+/*!
+*  \brief      Set the state of the edge to the passed child.
+*  \details    An invalid edge is removed from the children and added to the invalid children.
+*  \author     Sascha Kaden
+*  \param[in]  child node
+*  \param[in]  state of the edge
+*  \date       2017-12-04
+*/
+template <unsigned int dim>
+void Node<dim>::setChildState(const std::shared_ptr<Node<dim>> &node, const EdgeState state) {
+    bool invalid = false;
+    lockEdges();
+    if (isArenaNode(node)) {
+        for (size_t i = 0; i < m_arenaChildren.size(); ++i) {
+            if (m_arenaChildren[i].index != node->m_arenaIndex)
+                continue;
+
+            if (state == EdgeState::Invalid) {
+                m_arenaChildren.erase(m_arenaChildren.begin() + i);
+                invalid = true;
+            } else {
+                m_arenaChildren[i].state = state;
+            }
+            break;
+        }
+    } else {
+        for (size_t i = 0; i < m_children.size(); ++i) {
+            if (m_children[i].first != node)
+                continue;
+
+            if (state == EdgeState::Invalid) {
+                m_children.erase(m_children.begin() + i);
+                m_childStates.erase(m_childStates.begin() + i);
+                invalid = true;
+            } else {
+                m_childStates[i] = state;
+            }
+            break;
+        }
+    }
+    unlockEdges();
+
+    if (invalid)
+        addInvalidChild(node);
 }
 
 /*!
@@ -328,7 +536,12 @@ void Node<dim>::addInvalidChild(const std::shared_ptr<Node<dim>> &child) {
     if (child->empty())
         return;
 
-    m_invalidChildren.push_back(child);
+    lockEdges();
+    if (isArenaNode(child))
+        m_arenaInvalidChildren.push_back(child->m_arenaIndex);
+    else
+        m_invalidChildren.push_back(child);
+    unlockEdges();
 }
 
 /*!
@@ -340,11 +553,37 @@ void Node<dim>::addInvalidChild(const std::shared_ptr<Node<dim>> &child) {
 */
 template <unsigned int dim>
 bool Node<dim>::isInvalidChild(const std::shared_ptr<Node<dim>> &node) const {
-    for (auto &child : m_invalidChildren)
-        if (child == node)
-            return true;
+    bool invalid = false;
+    lockEdges();
+    if (isArenaNode(node)) {
+        for (auto index : m_arenaInvalidChildren)
+            if (index == node->m_arenaIndex)
+                invalid = true;
+    } else {
+        for (auto &child : m_invalidChildren)
+            if (child == node)
+                invalid = true;
+    }
+    unlockEdges();
+    return invalid;
+}
 
-    return false;
+/*!
+*  \brief      Return a copy of the list of invalid children, taken under the lock of the Node.
+*  \author     Sascha Kaden
+*  \param[out] list of invalid children
+*  \date       2017-12-15
+*/
+template <unsigned int dim>
+std::vector<std::shared_ptr<Node<dim>>> Node<dim>::getInvalidChildren() const {
+    std::vector<std::shared_ptr<Node<dim>>> invalidChildren;
+    lockEdges();
+    invalidChildren.reserve(m_arenaInvalidChildren.size() + m_invalidChildren.size());
+    for (auto index : m_arenaInvalidChildren)
+        invalidChildren.push_back(m_arena->getNode(index));
+    invalidChildren.insert(invalidChildren.end(), m_invalidChildren.begin(), m_invalidChildren.end());
+    unlockEdges();
+    return invalidChildren;
 }
 
 /*!
@@ -354,7 +593,10 @@ bool Node<dim>::isInvalidChild(const std::shared_ptr<Node<dim>> &node) const {
 */
 template <unsigned int dim>
 void Node<dim>::clearInvalidChildren() {
+    lockEdges();
     m_invalidChildren.clear();
+    m_arenaInvalidChildren.clear();
+    unlockEdges();
 }
 
 /*!
@@ -380,6 +622,61 @@ double Node<dim>::getValue(const unsigned int index) const {
     return m_config[index];
 }
 
+/*!
+*  \brief      Set the id of the Node, it is the index of the Node inside of the Graph
+*  \author     Sascha Kaden
+*  \param[in]  id
+*  \date       2017-11-20
+*/
+template <unsigned int dim>
+void Node<dim>::setId(const NodeId id) {
+    m_id = id;
+}
+
+/*!
+*  \brief      Return the id of the Node, INVALID_NODE_ID if the Node is not part of a Graph
+*  \author     Sascha Kaden
+*  \param[out] id
+*  \date       2017-11-20
+*/
+template <unsigned int dim>
+NodeId Node<dim>::getId() const {
+    return m_id;
+}
+
+/*!
+*  \brief      Return true, if the passed Node is inside of the NodeArena of this Node
+*  \author     Sascha Kaden
+*  \param[in]  Node
+*  \param[out] result
+*  \date       2017-12-18
+*/
+template <unsigned int dim>
+bool Node<dim>::isArenaNode(const std::shared_ptr<Node> &node) const {
+    return m_arena && node->m_arena == m_arena;
+}
+
+/*!
+*  \brief      Lock the edges of the Node, the critical sections are short and a spin lock keeps the Node small.
+*  \author     Sascha Kaden
+*  \date       2017-12-18
+*/
+template <unsigned int dim>
+void Node<dim>::lockEdges() const {
+    while (m_edgeLock.exchange(true, std::memory_order_acquire))
+        std::this_thread::yield();
+}
+
+/*!
+*  \brief      Unlock the edges of the Node
+*  \author     Sascha Kaden
+*  \date       2017-12-18
+*/
+template <unsigned int dim>
+void Node<dim>::unlockEdges() const {
+    m_edgeLock.store(false, std::memory_order_release);
+}
+
 } /* namespace ippp */
 
 #endif /* NODE_HPP */
@@ -0,0 +1,159 @@
+//-------------------------------------------------------------------------//
+//
+// Copyright 2017 Sascha Kaden
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-------------------------------------------------------------------------//
+
+#ifndef NODEARENA_HPP
+#define NODEARENA_HPP
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+#include <ippp/types.h>
+
+namespace ippp {
+
+template <unsigned int dim>
+class Node;
+
+/*!
+* \brief   Class NodeArena allocates Nodes inside of contiguous blocks, which are owned by the arena.
+* \details The returned Node pointer are non owning (no control block), copying them causes no reference counting. The
+* Nodes are valid as long as the arena exists, all blocks are released at once at the destruction.
+* Every Node gets its 32-bit index inside of the arena, the child edges between Nodes of one arena are stored as
+* index/cost pairs. Each block is twice as large as the previous one, the table of the blocks is never reallocated and
+* an index is resolved without a lock.
+* \author  Sascha Kaden
+* \date    2017-11-20
+*/
+template <unsigned int dim>
+class NodeArena {
+  public:
+    NodeArena(const size_t blockSize = 4096);
+
+    std::shared_ptr<Node<dim>> makeNode(const Vector<dim> &config);
+    std::shared_ptr<Node<dim>> getNode(const uint32_t index) const;
+
+    size_t size() const;
+    size_t capacity() const;
+
+  private:
+    size_t getBlockSize(const size_t block) const;
+
+    static const size_t m_maxBlocks = 32;
+    std::array<std::unique_ptr<Node<dim>[]>, m_maxBlocks> m_blocks;
+    const size_t m_blockSize;
+    size_t m_numBlocks = 0;
+    size_t m_size = 0;
+};
+
+/*!
+*  \brief      Constructor of the class NodeArena
+*  \author     Sascha Kaden
+*  \param[in]  number of Nodes of the first block
+*  \date       2017-11-20
+*/
+template <unsigned int dim>
+NodeArena<dim>::NodeArena(const size_t blockSize) : m_blockSize(blockSize > 0 ? blockSize : 1) {
+}
+
+/*!
+*  \brief      Create a new Node inside of the arena and return the non owning pointer of it.
+*  \details    Function is not thread safe, the owner (Graph) has to lock it.
+*  \author     Sascha Kaden
+*  \param[in]  configuration
+*  \param[out] Node pointer without control block
+*  \date       2017-11-20
+*/
+template <unsigned int dim>
+std::shared_ptr<Node<dim>> NodeArena<dim>::makeNode(const Vector<dim> &config) {
+    if (m_size == capacity()) {
+        if (m_numBlocks == m_maxBlocks || m_size >= std::numeric_limits<uint32_t>::max())
+            return nullptr;
+        m_blocks[m_numBlocks] = std::unique_ptr<Node<dim>[]>(new Node<dim>[getBlockSize(m_numBlocks)]);
+        ++m_numBlocks;
+    }
+
+    auto node = getNode(static_cast<uint32_t>(m_size));
+    *node = Node<dim>(config);
+    node->m_arena = this;
+    node->m_arenaIndex = static_cast<uint32_t>(m_size);
+    ++m_size;
+    return node;
+}
+
+/*!
+*  \brief      Return the non owning pointer of the Node with the passed index.
+*  \details    The index has to be created by makeNode before, the block of it is not modified anymore.
+*  \author     Sascha Kaden
+*  \param[in]  index inside of the arena
+*  \param[out] Node pointer without control block
+*  \date       2017-12-18
+*/
+template <unsigned int dim>
+std::shared_ptr<Node<dim>> NodeArena<dim>::getNode(const uint32_t index) const {
+    // block b starts at m_blockSize * (2^b - 1)
+    size_t offset = index / m_blockSize + 1;
+    size_t block = 0;
+    while (offset >>= 1)
+        ++block;
+    Node<dim> *node = &m_blocks[block][index - m_blockSize * ((size_t(1) << block) - 1)];
+
+    // aliasing constructor with an empty owner, the pointer is not reference counted
+    return std::shared_ptr<Node<dim>>(std::shared_ptr<Node<dim>>(), node);
+}
+
+/*!
+*  \brief      Return the number of allocated Nodes
+*  \author     Sascha Kaden
+*  \param[out] size
+*  \date       2017-11-20
+*/
+template <unsigned int dim>
+size_t NodeArena<dim>::size() const {
+    return m_size;
+}
+
+/*!
+*  \brief      Return the number of Nodes, which can be allocated without a new block
+*  \author     Sascha Kaden
+*  \param[out] capacity
+*  \date       2017-11-20
+*/
+template <unsigned int dim>
+size_t NodeArena<dim>::capacity() const {
+    return m_blockSize * ((size_t(1) << m_numBlocks) - 1);
+}
+
+/*!
+*  \brief      Return the number of Nodes of the passed block
+*  \author     Sascha Kaden
+*  \param[in]  block
+*  \param[out] block size
+*  \date       2017-12-18
+*/
+template <unsigned int dim>
+size_t NodeArena<dim>::getBlockSize(const size_t block) const {
+    return m_blockSize << block;
+}
+
+} /* namespace ippp */
+
+#include <ippp/dataObj/Node.hpp>
+
+#endif /* NODEARENA_HPP */
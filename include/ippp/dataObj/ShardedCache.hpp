@@ -0,0 +1,196 @@
+//-------------------------------------------------------------------------//
+//
+// Copyright 2017 Sascha Kaden
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-------------------------------------------------------------------------//
+
+#ifndef SHARDEDCACHE_HPP
+#define SHARDEDCACHE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace ippp {
+
+/*!
+* \brief   Class ShardedCache is a bounded, thread safe key value cache.
+* \details The cache is split into shards with own mutexes, the shard is selected by the hash of the key. Every shard
+* evicts its entries with the clock algorithm if it is full, entries which were read since the last pass of the clock
+* hand get a second chance.
+* \author  Sascha Kaden
+* \date    2017-12-06
+*/
+template <typename Key, typename Value, typename Hash>
+class ShardedCache {
+  public:
+    ShardedCache(const size_t capacity);
+
+    bool find(const Key &key, Value &value);
+    void insert(const Key &key, const Value &value);
+    void clear();
+    size_t size();
+    size_t getCapacity() const;
+
+  private:
+    struct Entry {
+        Key key;
+        Value value;
+        bool referenced;
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<Key, size_t, Hash> index;
+        std::vector<Entry> entries;
+        size_t clockHand = 0;
+    };
+
+    Shard &getShard(const Key &key);
+
+    static const size_t m_numShards = 16;
+
+    size_t m_shardCapacity;
+    std::array<Shard, m_numShards> m_shards;
+};
+
+/*!
+*  \brief      Constructor of the class ShardedCache
+*  \author     Sascha Kaden
+*  \param[in]  maximal number of entries
+*  \date       2017-12-06
+*/
+template <typename Key, typename Value, typename Hash>
+ShardedCache<Key, Value, Hash>::ShardedCache(const size_t capacity) : m_shardCapacity(std::max<size_t>(1, capacity / m_numShards)) {
+}
+
+/*!
+*  \brief      Search the key inside of the cache and mark the entry as referenced.
+*  \author     Sascha Kaden
+*  \param[in]  key
+*  \param[out] value of the key
+*  \param[out] true if the key was found
+*  \date       2017-12-06
+*/
+template <typename Key, typename Value, typename Hash>
+bool ShardedCache<Key, Value, Hash>::find(const Key &key, Value &value) {
+    Shard &shard = getShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto entry = shard.index.find(key);
+    if (entry == shard.index.end())
+        return false;
+
+    shard.entries[entry->second].referenced = true;
+    value = shard.entries[entry->second].value;
+    return true;
+}
+
+/*!
+*  \brief      Insert the key, if the shard is full an unreferenced entry is evicted.
+*  \details    An existing entry of the key is overwritten.
+*  \author     Sascha Kaden
+*  \param[in]  key
+*  \param[in]  value
+*  \date       2017-12-06
+*/
+template <typename Key, typename Value, typename Hash>
+void ShardedCache<Key, Value, Hash>::insert(const Key &key, const Value &value) {
+    Shard &shard = getShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto entry = shard.index.find(key);
+    if (entry != shard.index.end()) {
+        shard.entries[entry->second].value = value;
+        return;
+    }
+
+    if (shard.entries.size() < m_shardCapacity) {
+        shard.index[key] = shard.entries.size();
+        shard.entries.push_back(Entry{key, value, false});
+        return;
+    }
+
+    while (shard.entries[shard.clockHand].referenced) {
+        shard.entries[shard.clockHand].referenced = false;
+        shard.clockHand = (shard.clockHand + 1) % m_shardCapacity;
+    }
+    Entry &victim = shard.entries[shard.clockHand];
+    shard.index.erase(victim.key);
+    victim = Entry{key, value, false};
+    shard.index[key] = shard.clockHand;
+    shard.clockHand = (shard.clockHand + 1) % m_shardCapacity;
+}
+
+/*!
+*  \brief      Remove all entries of the cache
+*  \author     Sascha Kaden
+*  \date       2017-12-06
+*/
+template <typename Key, typename Value, typename Hash>
+void ShardedCache<Key, Value, Hash>::clear() {
+    for (auto &shard : m_shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.index.clear();
+        shard.entries.clear();
+        shard.clockHand = 0;
+    }
+}
+
+/*!
+*  \brief      Return the number of entries
+*  \author     Sascha Kaden
+*  \param[out] size
+*  \date       2017-12-06
+*/
+template <typename Key, typename Value, typename Hash>
+size_t ShardedCache<Key, Value, Hash>::size() {
+    size_t size = 0;
+    for (auto &shard : m_shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        size += shard.entries.size();
+    }
+    return size;
+}
+
+/*!
+*  \brief      Return the maximal number of entries
+*  \author     Sascha Kaden
+*  \param[out] capacity
+*  \date       2017-12-06
+*/
+template <typename Key, typename Value, typename Hash>
+size_t ShardedCache<Key, Value, Hash>::getCapacity() const {
+    return m_shardCapacity * m_numShards;
+}
+
+/*!
+*  \brief      Return the shard of the key, the upper bits of the hash are used to keep them independent of the
+*  buckets of the hash maps.
+*  \author     Sascha Kaden
+*  \param[in]  key
+*  \param[out] shard
+*  \date       2017-12-06
+*/
+template <typename Key, typename Value, typename Hash>
+typename ShardedCache<Key, Value, Hash>::Shard &ShardedCache<Key, Value, Hash>::getShard(const Key &key) {
+    uint64_t hash = static_cast<uint64_t>(Hash()(key));
+    return m_shards[(hash >> 32) % m_numShards];
+}
+
+} /* namespace ippp */
+
+#endif /* SHARDEDCACHE_HPP */
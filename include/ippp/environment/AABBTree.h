@@ -0,0 +1,103 @@
+//-------------------------------------------------------------------------//
+//
+// Copyright 2017 Sascha Kaden
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-------------------------------------------------------------------------//
+
+#ifndef AABBTREE_H
+#define AABBTREE_H
+
+#include <vector>
+
+#include <ippp/types.h>
+
+namespace ippp {
+
+/*!
+* \brief   Static bounding volume hierarchy over the AABBs of the obstacles, used as broadphase of the collision
+* detections.
+* \details The tree is built once and returns the indices of all obstacles, whose AABB intersects a query AABB. The
+* AABBs of a leaf are tested one by one, before the obstacle index is returned.
+* \author  Sascha Kaden
+* \date    2017-12-01
+*/
+class AABBTree {
+  public:
+    AABBTree();
+    AABBTree(const std::vector<AABB> &aabbs);
+    void build(const std::vector<AABB> &aabbs);
+
+    void query(const AABB &aabb, std::vector<size_t> &indices) const;
+    template <typename Function>
+    bool forEachCandidate(const AABB &aabb, Function fn) const;
+
+    size_t size() const;
+    bool empty() const;
+
+  private:
+    struct TreeNode {
+        AABB aabb;
+        size_t left;     // index of the left child or first entry of m_indices for leafs
+        size_t right;    // index of the right child or number of entries for leafs
+        bool leaf;
+    };
+
+    size_t buildNode(const std::vector<AABB> &aabbs, const std::vector<Vector3> &centers, const size_t begin,
+                     const size_t end);
+
+    std::vector<TreeNode> m_nodes;
+    std::vector<size_t> m_indices;
+    std::vector<AABB> m_aabbs;    // AABBs in the order of m_indices
+    static const size_t m_leafSize = 4;
+};
+
+/*!
+*  \brief      Calls the function for every obstacle index, whose AABB intersects the passed AABB.
+*  \details    The traversal stops, if the function returns true.
+*  \author     Sascha Kaden
+*  \param[in]  query AABB
+*  \param[in]  function with the signature bool(size_t)
+*  \param[out] true, if the function returned true
+*  \date       2017-12-01
+*/
+template <typename Function>
+bool AABBTree::forEachCandidate(const AABB &aabb, Function fn) const {
+    if (m_nodes.empty())
+        return false;
+
+    // the depth of the tree is logarithmic, a small fixed stack is sufficient
+    size_t stack[64];
+    size_t stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize > 0) {
+        const TreeNode &node = m_nodes[stack[--stackSize]];
+        if (!node.aabb.intersects(aabb))
+            continue;
+
+        if (node.leaf) {
+            for (size_t i = node.left; i < node.left + node.right; ++i)
+                if (m_aabbs[i].intersects(aabb) && fn(m_indices[i]))
+                    return true;
+        } else {
+            stack[stackSize++] = node.right;
+            stack[stackSize++] = node.left;
+        }
+    }
+    return false;
+}
+
+} /* namespace ippp */
+
+#endif /* AABBTREE_H */
@@ -20,10 +20,12 @@
 #define ENVIRONMENT_H
 
 #include <assert.h>
+#include <mutex>
 #include <string>
 #include <vector>
 
 #include <ippp/Identifier.h>
+#include <ippp/environment/AABBTree.h>
 #include <ippp/environment/robot/RobotBase.h>
 #include <ippp/environment/model/ModelContainer.h>
 
@@ -49,6 +51,8 @@ class Environment : public Identifier {
     std::shared_ptr<ModelContainer> getObstacle(const size_t index) const;
     std::vector<std::shared_ptr<ModelContainer>> getObstacles() const;
     size_t getObstacleNum() const;
+    std::vector<AABB> getObstacleAABBs() const;
+    const AABBTree &getObstacleTree() const;
 
     void addRobot(const std::shared_ptr<RobotBase> &robot);
     std::shared_ptr<RobotBase> getRobot() const;
@@ -74,6 +78,10 @@ class Environment : public Identifier {
     std::vector<unsigned int> m_robotDimSizes;
     std::vector<std::shared_ptr<RobotBase>> m_robots;
     std::vector<std::shared_ptr<ModelContainer>> m_obstacles;
+    std::vector<AABB> m_obstacleAABBs;
+    mutable AABBTree m_obstacleTree;    // build lazily at the first query after new obstacles
+    mutable bool m_obstacleTreeDirty = false;
+    mutable std::mutex m_obstacleTreeMutex;
     VectorX m_positionMask;
     VectorX m_rotationMask;
 };
@@ -45,6 +45,7 @@ std::vector<Vector3> computeNormals(const std::vector<Vector3> &vertices, const
 AABB computeAABB(const std::vector<Vector3> &vertices);
 AABB computeAABB(const Mesh &mesh);
 AABB computeAABB(const std::vector<Triangle2D> &triangles);
+BoundingSpheres computeBoundingSpheres(const Mesh &mesh, const size_t numLeaves = BoundingSpheres::maxLeaves);
 
 } /* namespace cad */
 
@@ -19,6 +19,7 @@
 #ifndef MESH_H
 #define MESH_H
 
+#include <array>
 #include <vector>
 
 #include <ippp/types.h>
@@ -38,6 +39,24 @@ public:
     AABB aabb;
 };
 
+/*!
+* \brief   Two level sphere hierarchy, which encloses all triangles of a mesh.
+* \details The root sphere encloses the whole mesh, the leaf spheres enclose the triangles of slabs along the longest
+* axis of the mesh. An empty hierarchy (negative root radius) can't be used to reject any pair.
+* \author  Sascha Kaden
+* \date    2017-12-13
+*/
+class BoundingSpheres {
+public:
+    static const size_t maxLeaves = 8;
+
+    Vector3 center = Vector3::Zero();
+    double radius = -1;
+    std::array<Vector3, maxLeaves> centers;
+    std::array<double, maxLeaves> radii;
+    size_t numLeaves = 0;
+};
+
 } /* namespace ippp */
 
 #endif //MESH_H
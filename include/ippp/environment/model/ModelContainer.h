@@ -40,11 +40,16 @@ class ModelContainer : public Identifier {
 
   public:
     AABB getAABB() const ;
+    void updateBoundingSpheres();
+    const BoundingSpheres &getBoundingSpheres() const;
     virtual bool empty() const = 0;
     virtual void transformModel(const Transform &T) = 0;
     virtual void transformModel(const Vector6 &config) = 0;
 
     Mesh m_mesh;
+
+  protected:
+    BoundingSpheres m_boundingSpheres;
 };
 
 } /* namespace ippp */
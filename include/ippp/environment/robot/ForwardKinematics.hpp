@@ -0,0 +1,414 @@
+//-------------------------------------------------------------------------//
+//
+// Copyright 2017 Sascha Kaden
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-------------------------------------------------------------------------//
+
+#ifndef FORWARDKINEMATICS_HPP
+#define FORWARDKINEMATICS_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include <ippp/environment/robot/SerialRobot.h>
+#include <ippp/util/UtilSimd.hpp>
+
+namespace ippp {
+
+/*!
+* \brief   Allocation free forward kinematics of a serial robot with D-H parameters.
+* \details The constant D-H parameters and the sine and cosine of the alpha angles are copied from the robot at
+* construction, the transformations are written into fixed size arrays of the caller. The D-H angle of a joint is
+* computed by scale * angle + offset of the robot. The pose and the base offset of the robot are copied as well, the
+* object has to be recreated after they have changed.
+* The link i depends only on the joints 0 to i - 1. A batch of configurations shares the leading links of the joints,
+* which are equal in all of them, the remaining links are computed for blocks of configurations in lock-step by the
+* SIMD link kernel.
+* \author  Sascha Kaden
+* \date    2017-12-10
+*/
+template <unsigned int dim>
+class ForwardKinematics {
+  public:
+    ForwardKinematics();
+    ForwardKinematics(const SerialRobot &robot);
+
+    void computeJointTrafos(const Vector<dim> &angles, std::array<Transform, dim> &jointTrafos) const;
+    void computeLinkTrafos(const Vector<dim> &angles, std::array<Transform, dim> &linkTrafos) const;
+    void computeLinkTrafos(const Vector<dim> &angles, std::array<Transform, dim> &linkTrafos,
+                           const unsigned int firstLink) const;
+    void computeLinkTrafos(const std::vector<Vector<dim>> &configs,
+                           std::vector<std::array<Transform, dim>, Eigen::aligned_allocator<std::array<Transform, dim>>>
+                               &linkTrafos) const;
+    void computeLinkTrafos(const Vector<dim> *configs, const size_t numConfigs,
+                           std::array<Transform, dim> *linkTrafos) const;
+    static unsigned int getFirstChangedLink(const Vector<dim> &previous, const Vector<dim> &angles);
+    Transform getPose() const;
+
+  private:
+    void computeTrafo(const unsigned int joint, const double angle, Transform &T) const;
+    void computeLinkBlock(const Vector<dim> *configs, const size_t numConfigs, const unsigned int firstLink,
+                          std::array<Transform, dim> *linkTrafos) const;
+
+    std::array<double, dim> m_sinAlpha;
+    std::array<double, dim> m_cosAlpha;
+    std::array<double, dim> m_a;
+    std::array<double, dim> m_d;
+    std::array<double, dim> m_scale;
+    std::array<double, dim> m_offset;
+    std::array<double, dim * util::jointCoefficients> m_jointConstants;
+    util::LinkBlockFunction m_linkBlockFunction;
+    Transform m_pose;
+    Transform m_base;
+
+  public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+/*!
+*  \brief      Default constructor of the ForwardKinematics, all joints are identities
+*  \author     Sascha Kaden
+*  \date       2017-12-10
+*/
+template <unsigned int dim>
+ForwardKinematics<dim>::ForwardKinematics() {
+    m_sinAlpha.fill(0);
+    m_cosAlpha.fill(1);
+    m_a.fill(0);
+    m_d.fill(0);
+    m_scale.fill(1);
+    m_offset.fill(0);
+    for (unsigned int i = 0; i < dim; ++i) {
+        m_jointConstants[i * util::jointCoefficients] = 0;
+        m_jointConstants[i * util::jointCoefficients + 1] = 1;
+        m_jointConstants[i * util::jointCoefficients + 2] = 0;
+        m_jointConstants[i * util::jointCoefficients + 3] = 0;
+    }
+    m_linkBlockFunction = util::getLinkBlockFunction();
+    m_pose = Transform::Identity();
+    m_base = Transform::Identity();
+}
+
+/*!
+*  \brief      Constructor of the ForwardKinematics, copies the D-H parameters of the robot
+*  \author     Sascha Kaden
+*  \param[in]  SerialRobot
+*  \date       2017-12-10
+*/
+template <unsigned int dim>
+ForwardKinematics<dim>::ForwardKinematics(const SerialRobot &robot) : ForwardKinematics() {
+    if (robot.getDim() != dim) {
+        Logging::error("Dimension of the robot does not fit", "ForwardKinematics");
+        return;
+    }
+
+    VectorX alpha = robot.getAlpha();
+    VectorX a = robot.getA();
+    VectorX d = robot.getD();
+    VectorX scale = robot.getDHScale();
+    VectorX offset = robot.getDHOffset();
+    for (unsigned int i = 0; i < dim; ++i) {
+        m_sinAlpha[i] = std::sin(alpha[i]);
+        m_cosAlpha[i] = std::cos(alpha[i]);
+        m_a[i] = a[i];
+        m_d[i] = d[i];
+        m_scale[i] = scale[i];
+        m_offset[i] = offset[i];
+        m_jointConstants[i * util::jointCoefficients] = m_sinAlpha[i];
+        m_jointConstants[i * util::jointCoefficients + 1] = m_cosAlpha[i];
+        m_jointConstants[i * util::jointCoefficients + 2] = m_a[i];
+        m_jointConstants[i * util::jointCoefficients + 3] = m_d[i];
+    }
+    m_pose = robot.getPose();
+    m_base = m_pose * robot.getBaseOffset();
+}
+
+/*!
+*  \brief      Compute the D-H transformations of all joints
+*  \author     Sascha Kaden
+*  \param[in]  joint angles
+*  \param[out] joint transformations
+*  \date       2017-12-10
+*/
+template <unsigned int dim>
+void ForwardKinematics<dim>::computeJointTrafos(const Vector<dim> &angles,
+                                                std::array<Transform, dim> &jointTrafos) const {
+    for (unsigned int i = 0; i < dim; ++i)
+        computeTrafo(i, angles[i], jointTrafos[i]);
+}
+
+/*!
+*  \brief      Compute the poses of all links in the world frame
+*  \details    The link i is placed at the frame of the joint i - 1, the first link at the base of the robot.
+*  Equivalent to SerialRobot::getLinkTrafos.
+*  \author     Sascha Kaden
+*  \param[in]  joint angles
+*  \param[out] link transformations
+*  \date       2017-12-10
+*/
+template <unsigned int dim>
+void ForwardKinematics<dim>::computeLinkTrafos(const Vector<dim> &angles,
+                                               std::array<Transform, dim> &linkTrafos) const {
+    computeLinkTrafos(angles, linkTrafos, 0);
+}
+
+/*!
+*  \brief      Compute the poses of the links from the first link on, the links before have to be up to date
+*  \author     Sascha Kaden
+*  \param[in]  joint angles
+*  \param[in,out] link transformations
+*  \param[in]  index of the first link to compute
+*  \date       2017-12-11
+*/
+template <unsigned int dim>
+void ForwardKinematics<dim>::computeLinkTrafos(const Vector<dim> &angles, std::array<Transform, dim> &linkTrafos,
+                                               const unsigned int firstLink) const {
+    if (firstLink == 0)
+        linkTrafos[0] = m_base;
+
+    Transform jointTrafo;
+    for (unsigned int i = std::max(firstLink, 1u); i < dim; ++i) {
+        computeTrafo(i - 1, angles[i - 1], jointTrafo);
+        linkTrafos[i] = linkTrafos[i - 1] * jointTrafo;
+    }
+}
+
+/*!
+*  \brief      Compute the poses of the links for all configurations, e.g. the samples of a trajectory
+*  \author     Sascha Kaden
+*  \param[in]  configurations
+*  \param[out] link transformations of every configuration
+*  \date       2017-12-11
+*/
+template <unsigned int dim>
+void ForwardKinematics<dim>::computeLinkTrafos(
+    const std::vector<Vector<dim>> &configs,
+    std::vector<std::array<Transform, dim>, Eigen::aligned_allocator<std::array<Transform, dim>>> &linkTrafos) const {
+    linkTrafos.resize(configs.size());
+    if (!configs.empty())
+        computeLinkTrafos(configs.data(), configs.size(), linkTrafos.data());
+}
+
+/*!
+*  \brief      Compute the poses of the links for all configurations
+*  \details    The links in front of the first joint, which differs inside of the batch, are computed once. The other
+*  links are computed by the SIMD link kernel for blocks of util::simdBlockSize configurations.
+*  \author     Sascha Kaden
+*  \param[in]  configurations
+*  \param[in]  number of configurations
+*  \param[out] link transformations of every configuration
+*  \date       2017-12-12
+*/
+template <unsigned int dim>
+void ForwardKinematics<dim>::computeLinkTrafos(const Vector<dim> *configs, const size_t numConfigs,
+                                               std::array<Transform, dim> *linkTrafos) const {
+    if (numConfigs == 0)
+        return;
+
+    unsigned int firstLink = dim;
+    for (size_t i = 1; i < numConfigs; ++i)
+        firstLink = std::min(firstLink, getFirstChangedLink(configs[0], configs[i]));
+
+    if (firstLink == dim) {
+        computeLinkTrafos(configs[0], linkTrafos[0], 0);
+        for (size_t i = 1; i < numConfigs; ++i)
+            linkTrafos[i] = linkTrafos[0];
+        return;
+    }
+
+    // shared leading links, firstLink is at least one
+    computeLinkTrafos(configs[0], linkTrafos[0], 0);
+    for (size_t i = 1; i < numConfigs; ++i)
+        for (unsigned int link = 0; link < firstLink; ++link)
+            linkTrafos[i][link] = linkTrafos[0][link];
+
+    for (size_t begin = 1; begin < numConfigs; begin += util::simdBlockSize)
+        computeLinkBlock(configs + begin, std::min<size_t>(util::simdBlockSize, numConfigs - begin), firstLink,
+                         linkTrafos + begin);
+}
+
+/*!
+*  \brief      Return the index of the first link, which is moved between the two configurations
+*  \details    Returns dim, if no link has to be updated.
+*  \author     Sascha Kaden
+*  \param[in]  previous joint angles
+*  \param[in]  joint angles
+*  \param[out] index of the first moved link
+*  \date       2017-12-11
+*/
+template <unsigned int dim>
+unsigned int ForwardKinematics<dim>::getFirstChangedLink(const Vector<dim> &previous, const Vector<dim> &angles) {
+    unsigned int joint = 0;
+    while (joint < dim && previous[joint] == angles[joint])
+        ++joint;
+    return std::min(joint + 1, dim);
+}
+
+/*!
+*  \brief      Return the pose of the robot
+*  \author     Sascha Kaden
+*  \param[out] pose
+*  \date       2017-12-10
+*/
+template <unsigned int dim>
+Transform ForwardKinematics<dim>::getPose() const {
+    return m_pose;
+}
+
+/*!
+*  \brief      Compute the links from firstLink on for up to util::simdBlockSize configurations in lock-step
+*  \details    The links in front of firstLink have to be set, missing lanes repeat the last configuration.
+*  \author     Sascha Kaden
+*  \param[in]  configurations
+*  \param[in]  number of configurations
+*  \param[in]  index of the first link to compute
+*  \param[in,out] link transformations
+*  \date       2017-12-12
+*/
+template <unsigned int dim>
+void ForwardKinematics<dim>::computeLinkBlock(const Vector<dim> *configs, const size_t numConfigs,
+                                              const unsigned int firstLink,
+                                              std::array<Transform, dim> *linkTrafos) const {
+    constexpr unsigned int n = util::simdBlockSize;
+    const unsigned int firstJoint = firstLink - 1;
+    const unsigned int numJoints = dim - firstLink;
+    std::array<double, dim * n> sinQ;
+    std::array<double, dim * n> cosQ;
+    std::array<double, dim * util::linkCoefficients * n> links;
+
+    for (unsigned int lane = 0; lane < n; ++lane) {
+        const Vector<dim> &config = configs[std::min<size_t>(lane, numConfigs - 1)];
+        for (unsigned int joint = 0; joint < numJoints; ++joint) {
+            double q = m_scale[firstJoint + joint] * config[firstJoint + joint] + m_offset[firstJoint + joint];
+            sinQ[joint * n + lane] = std::sin(q);
+            cosQ[joint * n + lane] = std::cos(q);
+        }
+    }
+
+    const double *base = linkTrafos[0][firstJoint].data();
+    for (unsigned int coef = 0; coef < util::linkCoefficients; ++coef)
+        std::fill_n(links.data() + coef * n, n, base[coef]);
+
+    m_linkBlockFunction(m_jointConstants.data() + firstJoint * util::jointCoefficients, numJoints, sinQ.data(),
+                        cosQ.data(), links.data());
+
+    for (size_t lane = 0; lane < numConfigs; ++lane) {
+        for (unsigned int link = firstLink; link < dim; ++link) {
+            const double *block = links.data() + (link - firstJoint) * util::linkCoefficients * n;
+            double *trafo = linkTrafos[lane][link].data();
+            for (unsigned int coef = 0; coef < util::linkCoefficients; ++coef)
+                trafo[coef] = block[coef * n + lane];
+        }
+    }
+}
+
+/*!
+*  \brief      Compute the D-H transformation of one joint with the precomputed alpha terms
+*  \author     Sascha Kaden
+*  \param[in]  joint index
+*  \param[in]  joint angle
+*  \param[out] transformation
+*  \date       2017-12-10
+*/
+template <unsigned int dim>
+void ForwardKinematics<dim>::computeTrafo(const unsigned int joint, const double angle, Transform &T) const {
+    const double q = m_scale[joint] * angle + m_offset[joint];
+    const double sinQ = std::sin(q);
+    const double cosQ = std::cos(q);
+
+    T(0, 0) = cosQ;
+    T(0, 1) = -sinQ * m_cosAlpha[joint];
+    T(0, 2) = sinQ * m_sinAlpha[joint];
+    T(0, 3) = m_a[joint] * cosQ;
+    T(1, 0) = sinQ;
+    T(1, 1) = cosQ * m_cosAlpha[joint];
+    T(1, 2) = -cosQ * m_sinAlpha[joint];
+    T(1, 3) = m_a[joint] * sinQ;
+    T(2, 0) = 0;
+    T(2, 1) = m_sinAlpha[joint];
+    T(2, 2) = m_cosAlpha[joint];
+    T(2, 3) = m_d[joint];
+}
+
+/*!
+* \brief   Incremental forward kinematics of consecutive configurations.
+* \details Holds the link transformations of the last configuration and recomputes only the links behind the first
+* changed joint. One cache can be used by one thread at a time, the ForwardKinematics has to outlive it.
+* \author  Sascha Kaden
+* \date    2017-12-11
+*/
+template <unsigned int dim>
+class ForwardKinematicsCache {
+  public:
+    ForwardKinematicsCache(const ForwardKinematics<dim> &kinematics);
+
+    const std::array<Transform, dim> &computeLinkTrafos(const Vector<dim> &angles);
+    void clear();
+
+  private:
+    const ForwardKinematics<dim> *m_kinematics;
+    Vector<dim> m_angles;
+    std::array<Transform, dim> m_linkTrafos;
+    bool m_valid = false;
+
+  public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+/*!
+*  \brief      Constructor of the ForwardKinematicsCache
+*  \author     Sascha Kaden
+*  \param[in]  ForwardKinematics
+*  \date       2017-12-11
+*/
+template <unsigned int dim>
+ForwardKinematicsCache<dim>::ForwardKinematicsCache(const ForwardKinematics<dim> &kinematics)
+    : m_kinematics(&kinematics) {
+}
+
+/*!
+*  \brief      Compute the poses of all links, the leading links of the last configuration are reused
+*  \author     Sascha Kaden
+*  \param[in]  joint angles
+*  \param[out] link transformations, valid until the next call
+*  \date       2017-12-11
+*/
+template <unsigned int dim>
+const std::array<Transform, dim> &ForwardKinematicsCache<dim>::computeLinkTrafos(const Vector<dim> &angles) {
+    unsigned int firstLink = 0;
+    if (m_valid)
+        firstLink = ForwardKinematics<dim>::getFirstChangedLink(m_angles, angles);
+
+    m_kinematics->computeLinkTrafos(angles, m_linkTrafos, firstLink);
+    m_angles = angles;
+    m_valid = true;
+    return m_linkTrafos;
+}
+
+/*!
+*  \brief      Invalidate the cached configuration
+*  \author     Sascha Kaden
+*  \date       2017-12-11
+*/
+template <unsigned int dim>
+void ForwardKinematicsCache<dim>::clear() {
+    m_valid = false;
+}
+
+} /* namespace ippp */
+
+#endif /* FORWARDKINEMATICS_HPP */
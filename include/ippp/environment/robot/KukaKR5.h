@@ -31,8 +31,8 @@ namespace ippp {
 class KukaKR5 : public SerialRobot {
   public:
     KukaKR5();
-    Transform directKinematic(const Vector6 &angles) const;
-    std::vector<Transform> getJointTrafos(const Vector6 &angles) const;
+    Transform directKinematic(const VectorX &angles) const;
+    std::vector<Transform> getJointTrafos(const VectorX &angles) const;
 };
 
 } /* namespace ippp */
@@ -51,6 +51,7 @@ class RobotBase : public Identifier {
     void setPose(const Transform &pose);
     Transform getPose() const;
     virtual Transform getTransformation(const VectorX &config) const = 0;
+    virtual double getMotionBound(const VectorX &source, const VectorX &target) const;
 
     void setBaseModel(const std::shared_ptr<ModelContainer> &model);
     std::shared_ptr<ModelContainer> getBaseModel() const;
@@ -62,6 +63,8 @@ class RobotBase : public Identifier {
     std::vector<DofType> getDofTypes() const;
 
   protected:
+    double getModelRadius(const std::shared_ptr<ModelContainer> &model) const;
+
     const RobotCategory m_robotType;
     const VectorX m_minBoundary;
     const VectorX m_maxBoundary;
@@ -0,0 +1,59 @@
+//-------------------------------------------------------------------------//
+//
+// Copyright 2017 Sascha Kaden
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-------------------------------------------------------------------------//
+
+#ifndef SELFCOLLISIONMATRIX_H
+#define SELFCOLLISIONMATRIX_H
+
+#include <string>
+#include <vector>
+
+namespace ippp {
+
+enum class PairCollision { never, sometimes, always };
+
+/*!
+* \brief   Symmetric matrix of the collision behavior of all model pairs of a serial robot.
+* \details Index 0 is the base model, index i + 1 the model of joint i. The matrix is created from sampled
+* configurations, pairs which never collided at the samples are skipped by the collision detections. Unknown pairs
+* (empty matrix) are always checked.
+* \author  Sascha Kaden
+* \date    2017-12-14
+*/
+class SelfCollisionMatrix {
+  public:
+    SelfCollisionMatrix();
+    SelfCollisionMatrix(const size_t numModels);
+    SelfCollisionMatrix(const size_t numModels, const std::vector<size_t> &collisionCounts, const size_t numSamples);
+
+    size_t size() const;
+    bool empty() const;
+    void setPair(const size_t first, const size_t second, const PairCollision collision);
+    PairCollision getPair(const size_t first, const size_t second) const;
+    bool isPairChecked(const size_t first, const size_t second) const;
+
+    std::string toString() const;
+    static SelfCollisionMatrix fromString(const std::string &data);
+
+  private:
+    size_t m_numModels = 0;
+    std::vector<PairCollision> m_pairs;
+};
+
+} /* namespace ippp */
+
+#endif    // SELFCOLLISIONMATRIX_H
@@ -21,6 +21,7 @@
 
 #include <ippp/environment/robot/Joint.h>
 #include <ippp/environment/robot/RobotBase.h>
+#include <ippp/environment/robot/SelfCollisionMatrix.h>
 
 namespace ippp {
 
@@ -35,6 +36,7 @@ class SerialRobot : public RobotBase {
                 const std::vector<DofType> &dofTypes);
 
     virtual Transform getTransformation(const VectorX &config) const;
+    double getMotionBound(const VectorX &source, const VectorX &target) const override;
     virtual Transform directKinematic(const VectorX &angles) const = 0;
     virtual std::vector<Transform> getJointTrafos(const VectorX &angles) const = 0;
     std::vector<Transform> getLinkTrafos(const VectorX &angles) const;
@@ -47,6 +49,15 @@ class SerialRobot : public RobotBase {
     void setJoints(const std::vector<Joint> &joints);
     size_t getNbJoints() const;
 
+    VectorX getAlpha() const;
+    VectorX getA() const;
+    VectorX getD() const;
+    VectorX getDHScale() const;
+    VectorX getDHOffset() const;
+
+    void setSelfCollisionMatrix(const SelfCollisionMatrix &matrix);
+    SelfCollisionMatrix getSelfCollisionMatrix() const;
+
     std::shared_ptr<ModelContainer> getModelFromJoint(const size_t jointIndex) const;
     std::vector<std::shared_ptr<ModelContainer>> getJointModels() const;
 
@@ -58,7 +69,10 @@ class SerialRobot : public RobotBase {
     VectorX m_alpha;
     VectorX m_a;
     VectorX m_d;
+    VectorX m_dhScale;
+    VectorX m_dhOffset;
     Transform m_baseOffset;
+    SelfCollisionMatrix m_selfCollisionMatrix;
 };
 
 } /* namespace ippp */
@@ -19,6 +19,8 @@
 #ifndef COLLISIONDETECTION_HPP
 #define COLLISIONDETECTION_HPP
 
+#include <thread>
+
 #include <Eigen/Core>
 
 #include <ippp/dataObj/Node.hpp>
@@ -41,11 +43,16 @@ class CollisionDetection : public Identifier {
     virtual bool checkConfig(const Vector<dim> &config, CollisionRequest *request = nullptr,
                              CollisionResult *result = nullptr) = 0;
     virtual bool checkTrajectory(std::vector<Vector<dim>> &config) = 0;
+    virtual bool checkTrajectoryRange(const std::vector<Vector<dim>> &configs, const size_t begin, const size_t end);
+    std::vector<bool> checkConfigs(const std::vector<Vector<dim>> &configs, const size_t numThreads = 1);
 
     void setRobotBoundings(const std::pair<Vector<dim>, Vector<dim>> &robotBoundings);
     bool checkRobotBounding(const Vector<dim> &config) const;
 
   protected:
+    virtual void checkConfigRange(const std::vector<Vector<dim>> &configs, const size_t begin, const size_t end,
+                                  std::vector<unsigned char> &validity);
+
     const std::shared_ptr<Environment> m_environment;
     std::pair<Vector<dim>, Vector<dim>> m_robotBounding;
     const CollisionRequest m_request;
@@ -65,6 +72,75 @@ CollisionDetection<dim>::CollisionDetection(const std::string &name, const std::
     Logging::debug("Initialize", this);
 }
 
+/*!
+*  \brief      Check a batch of configurations for collision.
+*  \details    Unlike checkConfig, the result holds the validity of the configurations, true if a configuration is
+*  collision free. With more than one thread, the configurations are split into equal ranges and the CollisionDetection
+*  has to be thread safe.
+*  \author     Sascha Kaden
+*  \param[in]  configurations
+*  \param[in]  number of threads
+*  \param[out] validity of the configurations
+*  \date       2017-12-02
+*/
+template <unsigned int dim>
+std::vector<bool> CollisionDetection<dim>::checkConfigs(const std::vector<Vector<dim>> &configs, const size_t numThreads) {
+    // the threads write into a byte vector, concurrent writes into a std::vector<bool> would race
+    std::vector<unsigned char> validity(configs.size(), 0);
+    if (numThreads <= 1 || configs.size() < numThreads) {
+        checkConfigRange(configs, 0, configs.size(), validity);
+    } else {
+        size_t rangeSize = configs.size() / numThreads;
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < numThreads; ++i) {
+            size_t end = (i + 1 == numThreads) ? configs.size() : (i + 1) * rangeSize;
+            threads.push_back(std::thread(&CollisionDetection<dim>::checkConfigRange, this, std::cref(configs),
+                                          i * rangeSize, end, std::ref(validity)));
+        }
+        for (auto &thread : threads)
+            thread.join();
+    }
+    return std::vector<bool>(validity.begin(), validity.end());
+}
+
+/*!
+*  \brief      Check collision of the configurations inside of the range of a trajectory.
+*  \details    Allows several threads to check parts of one trajectory without copies. Backends with a batched
+*  trajectory check override it.
+*  \author     Sascha Kaden
+*  \param[in]  configurations
+*  \param[in]  first index of the range
+*  \param[in]  end of the range
+*  \param[out] binary result of collision (true if in collision)
+*  \date       2017-12-18
+*/
+template <unsigned int dim>
+bool CollisionDetection<dim>::checkTrajectoryRange(const std::vector<Vector<dim>> &configs, const size_t begin,
+                                                   const size_t end) {
+    for (size_t i = begin; i < end; ++i)
+        if (checkConfig(configs[i]))
+            return true;
+
+    return false;
+}
+
+/*!
+*  \brief      Check the configurations inside of the range and set their validity.
+*  \details    Backends can override it to share data between the configurations of a batch.
+*  \author     Sascha Kaden
+*  \param[in]  configurations
+*  \param[in]  first index of the range
+*  \param[in]  end of the range
+*  \param[out] validity of the configurations
+*  \date       2017-12-02
+*/
+template <unsigned int dim>
+void CollisionDetection<dim>::checkConfigRange(const std::vector<Vector<dim>> &configs, const size_t begin,
+                                               const size_t end, std::vector<unsigned char> &validity) {
+    for (size_t i = begin; i < end; ++i)
+        validity[i] = !checkConfig(configs[i]);
+}
+
 /*!
 *  \brief      Sets the robot boundings of all robots, dimension should be the same.
 *  \author     Sascha Kaden
@@ -19,15 +19,23 @@
 #ifndef COLLISIONDETECTION2D_HPP
 #define COLLISIONDETECTION2D_HPP
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+
 #include <ippp/modules/collisionDetection/CollisionDetection.hpp>
 #include <ippp/environment/cad/CadProcessing.h>
 #include <ippp/environment/model/ModelTriangle2D.h>
 #include <ippp/environment/robot/PointRobot.h>
+#include <ippp/util/UtilSimd.hpp>
 
 namespace ippp {
 
 /*!
 * \brief   Class for 2D collision detection of an point robot.
+* \details The triangles of the obstacles are preprocessed to the gradients of their barycentric coordinates and stored
+* in blocks of util::simdBlockSize triangles (structure of arrays). The blocks are sorted into the cells of an uniform
+* grid over the workspace, a point is only tested against the blocks of its cell by a SIMD kernel.
 * \author  Sascha Kaden
 * \date    2017-02-19
 */
@@ -37,13 +45,28 @@ class CollisionDetection2D : public CollisionDetection<dim> {
     CollisionDetection2D(const std::shared_ptr<Environment> &environment, const CollisionRequest &request = CollisionRequest());
     bool checkConfig(const Vector<dim> &config, CollisionRequest *request = nullptr, CollisionResult *result = nullptr);
     bool checkTrajectory(std::vector<Vector<dim>> &configs);
+    bool checkTrajectoryRange(const std::vector<Vector<dim>> &configs, const size_t begin, const size_t end) override;
+
+  protected:
+    void checkConfigRange(const std::vector<Vector<dim>> &configs, const size_t begin, const size_t end,
+                          std::vector<unsigned char> &validity) override;
 
   private:
-    bool checkPoint2D(double x, double y);
+    void buildGrid(const std::vector<Mesh> &obstacles);
+    bool checkPoint2D(double x, double y) const;
+    bool outOfBounds(double x, double y) const;
+    size_t getCell(double x, double y) const;
+    bool checkCell(size_t cell, double x, double y) const;
 
     Vector2 m_minBoundary;
     Vector2 m_maxBoundary;
-    std::vector<Mesh> m_obstacles;
+
+    size_t m_cellsX = 1;
+    size_t m_cellsY = 1;
+    Vector2 m_invCellSize;
+    std::vector<size_t> m_cellOffsets;
+    std::vector<double> m_triangleBlocks;
+    util::TriangleBlockFunction m_triangleBlockFunction;
 
     using CollisionDetection<dim>::m_environment;
 };
@@ -63,21 +86,16 @@ CollisionDetection2D<dim>::CollisionDetection2D(const std::shared_ptr<Environmen
     m_minBoundary = Vector2(bound.min()[0], bound.min()[1]);
     m_maxBoundary = Vector2(bound.max()[0], bound.max()[1]);
 
+    std::vector<Mesh> obstacles;
     if (m_environment->getObstacleNum() == 0) {
         Logging::warning("Empty workspace", this);
     } else {
         for (auto obstacle : m_environment->getObstacles())
-            m_obstacles.push_back(obstacle->m_mesh);
+            obstacles.push_back(obstacle->m_mesh);
     }
 
-    // update obstacle models for the 2D collision check, extends the AABB of the obstacle in z direction
-    for (auto &obstacle : m_obstacles) {
-        Vector3 bottomLeft = obstacle.aabb.corner(AABB::CornerType::BottomLeft);
-        Vector3 topRight = obstacle.aabb.corner(AABB::CornerType::TopRight);
-        bottomLeft[2] = -1;
-        topRight[2] = 1;
-        obstacle.aabb = AABB(bottomLeft, topRight);
-    }
+    m_triangleBlockFunction = util::getTriangleBlockFunction();
+    buildGrid(obstacles);
 }
 
 /*!
@@ -94,6 +112,8 @@ bool CollisionDetection2D<dim>::checkConfig(const Vector<dim> &config, Collision
 
 /*!
 *  \brief      Check collision of a trajectory of points
+*  \details    The boundaries and the grid cells of all points are computed first, afterwards the points are tested
+*  in their order. Consecutive points inside of one cell share the lookup of the cell.
 *  \author     Sascha Kaden
 *  \param[in]  vector of configurations
 *  \param[out] binary result of collision (true if in collision)
@@ -101,16 +121,115 @@ bool CollisionDetection2D<dim>::checkConfig(const Vector<dim> &config, Collision
 */
 template <unsigned int dim>
 bool CollisionDetection2D<dim>::checkTrajectory(std::vector<Vector<dim>> &configs) {
-    if (configs.empty())
+    return checkTrajectoryRange(configs, 0, configs.size());
+}
+
+/*!
+*  \brief      Check collision of the points inside of the range of a trajectory
+*  \author     Sascha Kaden
+*  \param[in]  vector of configurations
+*  \param[in]  first index of the range
+*  \param[in]  end of the range
+*  \param[out] binary result of collision (true if in collision)
+*  \date       2017-12-18
+*/
+template <unsigned int dim>
+bool CollisionDetection2D<dim>::checkTrajectoryRange(const std::vector<Vector<dim>> &configs, const size_t begin,
+                                                     const size_t end) {
+    if (begin >= end)
         return false;
 
-    for (auto &config : configs)
-        if (checkPoint2D(config[0], config[1]))
+    std::vector<size_t> cells(end - begin);
+    for (size_t i = begin; i < end; ++i) {
+        if (outOfBounds(configs[i][0], configs[i][1]))
+            return true;
+        cells[i - begin] = getCell(configs[i][0], configs[i][1]);
+    }
+
+    for (size_t i = begin; i < end; ++i)
+        if (checkCell(cells[i - begin], configs[i][0], configs[i][1]))
             return true;
 
     return false;
 }
 
+/*!
+*  \brief      Check the configurations inside of the range without the virtual call of checkConfig.
+*  \author     Sascha Kaden
+*  \param[in]  configurations
+*  \param[in]  first index of the range
+*  \param[in]  end of the range
+*  \param[out] validity of the configurations
+*  \date       2017-12-09
+*/
+template <unsigned int dim>
+void CollisionDetection2D<dim>::checkConfigRange(const std::vector<Vector<dim>> &configs, const size_t begin,
+                                                 const size_t end, std::vector<unsigned char> &validity) {
+    for (size_t i = begin; i < end; ++i)
+        validity[i] = !checkPoint2D(configs[i][0], configs[i][1]);
+}
+
+/*!
+*  \brief      Preprocess the triangles of the obstacles and sort them into the grid.
+*  \details    The number of cells is chosen by the number of triangles, every triangle is added to all cells, which
+*  are overlapped by its AABB. Degenerated triangles are skipped, they can't contain a point.
+*  \author     Sascha Kaden
+*  \param[in]  obstacle meshes
+*  \date       2017-12-09
+*/
+template <unsigned int dim>
+void CollisionDetection2D<dim>::buildGrid(const std::vector<Mesh> &obstacles) {
+    // triangle: p3, gradient of alpha and gradient of beta
+    std::vector<std::array<double, util::triangleCoefficients>> triangles;
+    std::vector<std::pair<Vector2, Vector2>> triangleBounds;
+    for (auto &obstacle : obstacles) {
+        for (auto &face : obstacle.faces) {
+            const Vector3 &p1 = obstacle.vertices[face[0]];
+            const Vector3 &p2 = obstacle.vertices[face[1]];
+            const Vector3 &p3 = obstacle.vertices[face[2]];
+            double denominator = (p2[1] - p3[1]) * (p1[0] - p3[0]) + (p3[0] - p2[0]) * (p1[1] - p3[1]);
+            if (denominator == 0)
+                continue;
+
+            triangles.push_back({{p3[0], p3[1], (p2[1] - p3[1]) / denominator, (p3[0] - p2[0]) / denominator,
+                                  (p3[1] - p1[1]) / denominator, (p1[0] - p3[0]) / denominator}});
+            Vector2 min(std::min({p1[0], p2[0], p3[0]}), std::min({p1[1], p2[1], p3[1]}));
+            Vector2 max(std::max({p1[0], p2[0], p3[0]}), std::max({p1[1], p2[1], p3[1]}));
+            triangleBounds.push_back(std::make_pair(min, max));
+        }
+    }
+
+    // about one cell per triangle
+    m_cellsX = m_cellsY = std::min<size_t>(512, std::max<size_t>(1, static_cast<size_t>(std::sqrt(triangles.size()))));
+    Vector2 size = m_maxBoundary - m_minBoundary;
+    m_invCellSize = Vector2(size[0] > 0 ? m_cellsX / size[0] : 0, size[1] > 0 ? m_cellsY / size[1] : 0);
+
+    std::vector<std::vector<size_t>> cellTriangles(m_cellsX * m_cellsY);
+    for (size_t i = 0; i < triangles.size(); ++i) {
+        size_t minCell = getCell(triangleBounds[i].first[0], triangleBounds[i].first[1]);
+        size_t maxCell = getCell(triangleBounds[i].second[0], triangleBounds[i].second[1]);
+        for (size_t y = minCell / m_cellsX; y <= maxCell / m_cellsX; ++y)
+            for (size_t x = minCell % m_cellsX; x <= maxCell % m_cellsX; ++x)
+                cellTriangles[y * m_cellsX + x].push_back(i);
+    }
+
+    // padding lanes have alpha = 0 and contain no point
+    const size_t blockDoubles = util::triangleCoefficients * util::simdBlockSize;
+    m_cellOffsets.assign(1, 0);
+    m_triangleBlocks.clear();
+    for (auto &cell : cellTriangles) {
+        size_t numBlocks = (cell.size() + util::simdBlockSize - 1) / util::simdBlockSize;
+        size_t offset = m_triangleBlocks.size();
+        m_triangleBlocks.resize(offset + numBlocks * blockDoubles, 0);
+        for (size_t i = 0; i < cell.size(); ++i) {
+            double *block = &m_triangleBlocks[offset + (i / util::simdBlockSize) * blockDoubles];
+            for (unsigned int coefficient = 0; coefficient < util::triangleCoefficients; ++coefficient)
+                block[coefficient * util::simdBlockSize + i % util::simdBlockSize] = triangles[cell[i]][coefficient];
+        }
+        m_cellOffsets.push_back(m_cellOffsets.back() + numBlocks);
+    }
+}
+
 /*!
 *  \brief      Check for 2D point collision
 *  \author     Sascha Kaden
@@ -120,35 +239,63 @@ bool CollisionDetection2D<dim>::checkTrajectory(std::vector<Vector<dim>> &config
 *  \date       2016-06-30
 */
 template <unsigned int dim>
-bool CollisionDetection2D<dim>::checkPoint2D(double x, double y) {
-    if (m_minBoundary[0] >= x || x >= m_maxBoundary[0] || m_minBoundary[1] >= y || y >= m_maxBoundary[1]) {
+bool CollisionDetection2D<dim>::checkPoint2D(double x, double y) const {
+    if (outOfBounds(x, y)) {
         Logging::trace("Config out of bound", this);
         return true;
     }
 
-    double alpha, beta, gamma;
-    Vector3 p1, p2, p3;
-    for (auto &obstacle : m_obstacles) {
-        // check bounding box to point
-        if (obstacle.aabb.exteriorDistance(Vector3(x, y, 0)) != 0)
-            continue;
+    return checkCell(getCell(x, y), x, y);
+}
 
-        // check if point is in triangle
-        for (auto &face : obstacle.faces) {
-            p1 = obstacle.vertices[face[0]];
-            p2 = obstacle.vertices[face[1]];
-            p3 = obstacle.vertices[face[2]];
-            alpha = ((p2[1] - p3[1]) * (x - p3[0]) + (p3[0] - p2[0]) * (y - p3[1])) /
-                    ((p2[1] - p3[1]) * (p1[0] - p3[0]) + (p3[0] - p2[0]) * (p1[1] - p3[1]));
-            beta = ((p3[1] - p1[1]) * (x - p3[0]) + (p1[0] - p3[0]) * (y - p3[1])) /
-                   ((p2[1] - p3[1]) * (p1[0] - p3[0]) + (p3[0] - p2[0]) * (p1[1] - p3[1]));
-            gamma = 1.0f - alpha - beta;
-
-            if (alpha > 0 && beta > 0 && gamma > 0)
-                return true;
-        }
-    }
-    return false;
+/*!
+*  \brief      Return true if the point is outside of the workspace
+*  \author     Sascha Kaden
+*  \param[in]  x
+*  \param[in]  y
+*  \param[out] true if outside
+*  \date       2017-12-09
+*/
+template <unsigned int dim>
+bool CollisionDetection2D<dim>::outOfBounds(double x, double y) const {
+    return m_minBoundary[0] >= x || x >= m_maxBoundary[0] || m_minBoundary[1] >= y || y >= m_maxBoundary[1];
+}
+
+/*!
+*  \brief      Return the index of the grid cell of the point, points outside of the grid are clamped to the border cells.
+*  \author     Sascha Kaden
+*  \param[in]  x
+*  \param[in]  y
+*  \param[out] cell index
+*  \date       2017-12-09
+*/
+template <unsigned int dim>
+size_t CollisionDetection2D<dim>::getCell(double x, double y) const {
+    double cellX = std::max(0.0, std::floor((x - m_minBoundary[0]) * m_invCellSize[0]));
+    double cellY = std::max(0.0, std::floor((y - m_minBoundary[1]) * m_invCellSize[1]));
+    size_t indexX = std::min(m_cellsX - 1, static_cast<size_t>(std::min(cellX, static_cast<double>(m_cellsX))));
+    size_t indexY = std::min(m_cellsY - 1, static_cast<size_t>(std::min(cellY, static_cast<double>(m_cellsY))));
+    return indexY * m_cellsX + indexX;
+}
+
+/*!
+*  \brief      Test the point against the triangle blocks of the cell
+*  \author     Sascha Kaden
+*  \param[in]  cell index
+*  \param[in]  x
+*  \param[in]  y
+*  \param[out] binary result of collision (true if in collision)
+*  \date       2017-12-09
+*/
+template <unsigned int dim>
+bool CollisionDetection2D<dim>::checkCell(size_t cell, double x, double y) const {
+    size_t begin = m_cellOffsets[cell];
+    size_t numBlocks = m_cellOffsets[cell + 1] - begin;
+    if (numBlocks == 0)
+        return false;
+
+    return m_triangleBlockFunction(&m_triangleBlocks[begin * util::triangleCoefficients * util::simdBlockSize],
+                                   numBlocks, x, y);
 }
 
 } /* namespace ippp */
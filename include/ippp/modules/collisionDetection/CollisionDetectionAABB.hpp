@@ -22,6 +22,7 @@
 #include <Eigen/Geometry>
 
 #include <ippp/modules/collisionDetection/CollisionDetection.hpp>
+#include <ippp/environment/AABBTree.h>
 #include <ippp/environment/cad/CadProcessing.h>
 
 namespace ippp {
@@ -45,6 +46,7 @@ class CollisionDetectionAABB : public CollisionDetection<dim> {
     bool m_multiRobot = false;
     std::vector<AABB> m_robotAABBs;
     std::vector<AABB> m_obstacleAABBs;
+    AABBTree m_obstacleTree;
     std::vector<std::shared_ptr<RobotBase>> m_robots;
 
     using CollisionDetection<dim>::m_environment;
@@ -67,8 +69,9 @@ CollisionDetectionAABB<dim>::CollisionDetectionAABB(const std::shared_ptr<Enviro
     for (auto robot : environment->getRobots())
         m_robotAABBs.push_back(robot->getBaseModel()->getAABB());
 
-    for (auto obstacle : environment->getObstacles())
-        m_obstacleAABBs.push_back(obstacle->getAABB());
+    // broadphase of the environment, the copy matches the obstacle list of this collision detection
+    m_obstacleAABBs = environment->getObstacleAABBs();
+    m_obstacleTree = environment->getObstacleTree();
 }
 
 /*!
@@ -170,9 +173,7 @@ bool CollisionDetectionAABB<dim>::checkObstacles(const AABB &robotAABB, Collisio
             }
         }
     } else {
-        for (auto &obstacle : m_obstacleAABBs)
-            if (robotAABB.intersects(obstacle))
-                return true;
+        return m_obstacleTree.forEachCandidate(robotAABB, [](const size_t) { return true; });
     }
 
     return false;
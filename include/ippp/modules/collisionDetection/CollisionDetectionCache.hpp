@@ -0,0 +1,270 @@
+//-------------------------------------------------------------------------//
+//
+// Copyright 2017 Sascha Kaden
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-------------------------------------------------------------------------//
+
+#ifndef COLLISIONDETECTIONCACHE_HPP
+#define COLLISIONDETECTIONCACHE_HPP
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+
+#include <ippp/dataObj/ShardedCache.hpp>
+#include <ippp/modules/collisionDetection/CollisionDetection.hpp>
+
+namespace ippp {
+
+/*!
+* \brief   Decorator of a CollisionDetection, which caches the results of the configurations.
+* \details The configurations are quantized with the resolution, all configurations inside of one cell share the
+* result. The resolution has to be smaller than the required precision of the collision checks. The results are
+* stored inside of a ShardedCache.
+* \author  Sascha Kaden
+* \date    2017-12-05
+*/
+template <unsigned int dim>
+class CollisionDetectionCache : public CollisionDetection<dim> {
+  public:
+    CollisionDetectionCache(const std::shared_ptr<CollisionDetection<dim>> &collision,
+                            const std::shared_ptr<Environment> &environment, const double resolution = 0.001,
+                            const size_t capacity = 100000);
+    bool checkConfig(const Vector<dim> &config, CollisionRequest *request = nullptr, CollisionResult *result = nullptr) override;
+    bool checkTrajectory(std::vector<Vector<dim>> &configs) override;
+    bool checkTrajectoryRange(const std::vector<Vector<dim>> &configs, const size_t begin, const size_t end) override;
+
+    size_t getHits() const;
+    size_t getMisses() const;
+    void resetCounters();
+    void clear();
+
+  private:
+    using Key = std::array<int64_t, dim>;
+
+    struct KeyHash {
+        size_t operator()(const Key &key) const;
+    };
+
+    bool checkCached(const Vector<dim> &config);
+    Key quantize(const Vector<dim> &config) const;
+
+    std::shared_ptr<CollisionDetection<dim>> m_collision;
+    double m_resolution;
+    ShardedCache<Key, bool, KeyHash> m_cache;
+    std::atomic<size_t> m_hits;
+    std::atomic<size_t> m_misses;
+};
+
+/*!
+*  \brief      Constructor of the class CollisionDetectionCache
+*  \author     Sascha Kaden
+*  \param[in]  decorated CollisionDetection
+*  \param[in]  Environment
+*  \param[in]  resolution of the quantization
+*  \param[in]  maximal number of cached configurations
+*  \date       2017-12-05
+*/
+template <unsigned int dim>
+CollisionDetectionCache<dim>::CollisionDetectionCache(const std::shared_ptr<CollisionDetection<dim>> &collision,
+                                                      const std::shared_ptr<Environment> &environment,
+                                                      const double resolution, const size_t capacity)
+    : CollisionDetection<dim>("CollisionDetectionCache", environment),
+      m_collision(collision),
+      m_resolution(resolution),
+      m_cache(capacity),
+      m_hits(0),
+      m_misses(0) {
+    if (m_resolution <= 0) {
+        m_resolution = 0.001;
+        Logging::warning("Resolution has to be larger than 0, it was set to 0.001!", this);
+    }
+}
+
+/*!
+*  \brief      Check for collision, the result is taken from the cache if possible.
+*  \details    Requests and results are passed to the decorated CollisionDetection without the cache.
+*  \author     Sascha Kaden
+*  \param[in]  configuration
+*  \param[in]  CollisionRequest
+*  \param[out] CollisionResult
+*  \param[out] binary result of collision (true if in collision)
+*  \date       2017-12-05
+*/
+template <unsigned int dim>
+bool CollisionDetectionCache<dim>::checkConfig(const Vector<dim> &config, CollisionRequest *request,
+                                               CollisionResult *result) {
+    if (request || result)
+        return m_collision->checkConfig(config, request, result);
+
+    return checkCached(config);
+}
+
+/*!
+*  \brief      Check collision of a trajectory of configurations, each configuration is taken from the cache if possible.
+*  \details    All configurations are looked up first, the misses are passed in one batch to the trajectory check of
+*  the decorated CollisionDetection. Only a valid batch is inserted into the cache, a colliding batch does not tell
+*  which configurations are in collision.
+*  \author     Sascha Kaden
+*  \param[in]  vector of configurations
+*  \param[out] binary result of collision (true if in collision)
+*  \date       2017-12-05
+*/
+template <unsigned int dim>
+bool CollisionDetectionCache<dim>::checkTrajectory(std::vector<Vector<dim>> &configs) {
+    return checkTrajectoryRange(configs, 0, configs.size());
+}
+
+/*!
+*  \brief      Check collision of the configurations inside of the range of a trajectory, see checkTrajectory.
+*  \author     Sascha Kaden
+*  \param[in]  vector of configurations
+*  \param[in]  first index of the range
+*  \param[in]  end of the range
+*  \param[out] binary result of collision (true if in collision)
+*  \date       2017-12-18
+*/
+template <unsigned int dim>
+bool CollisionDetectionCache<dim>::checkTrajectoryRange(const std::vector<Vector<dim>> &configs, const size_t begin,
+                                                        const size_t end) {
+    std::vector<Vector<dim>> misses;
+    std::vector<Key> missKeys;
+    bool collision;
+    for (size_t i = begin; i < end; ++i) {
+        const Vector<dim> &config = configs[i];
+        Key key = quantize(config);
+        if (m_cache.find(key, collision)) {
+            ++m_hits;
+            if (collision)
+                return true;
+        } else {
+            misses.push_back(config);
+            missKeys.push_back(key);
+        }
+    }
+    if (misses.empty())
+        return false;
+
+    m_misses += misses.size();
+    if (m_collision->checkTrajectory(misses))
+        return true;
+
+    for (auto &key : missKeys)
+        m_cache.insert(key, false);
+    return false;
+}
+
+/*!
+*  \brief      Return the number of cache hits
+*  \author     Sascha Kaden
+*  \param[out] hits
+*  \date       2017-12-05
+*/
+template <unsigned int dim>
+size_t CollisionDetectionCache<dim>::getHits() const {
+    return m_hits;
+}
+
+/*!
+*  \brief      Return the number of cache misses
+*  \author     Sascha Kaden
+*  \param[out] misses
+*  \date       2017-12-05
+*/
+template <unsigned int dim>
+size_t CollisionDetectionCache<dim>::getMisses() const {
+    return m_misses;
+}
+
+/*!
+*  \brief      Reset the hit and miss counters
+*  \author     Sascha Kaden
+*  \date       2017-12-05
+*/
+template <unsigned int dim>
+void CollisionDetectionCache<dim>::resetCounters() {
+    m_hits = 0;
+    m_misses = 0;
+}
+
+/*!
+*  \brief      Remove all cached configurations, has to be called after the Environment was modified.
+*  \author     Sascha Kaden
+*  \date       2017-12-05
+*/
+template <unsigned int dim>
+void CollisionDetectionCache<dim>::clear() {
+    m_cache.clear();
+}
+
+/*!
+*  \brief      Return the cached result of the configuration, computes and inserts it at a miss.
+*  \details    The decorated CollisionDetection is called without a lock of the cache.
+*  \author     Sascha Kaden
+*  \param[in]  configuration
+*  \param[out] binary result of collision (true if in collision)
+*  \date       2017-12-05
+*/
+template <unsigned int dim>
+bool CollisionDetectionCache<dim>::checkCached(const Vector<dim> &config) {
+    Key key = quantize(config);
+    bool collision;
+    if (m_cache.find(key, collision)) {
+        ++m_hits;
+        return collision;
+    }
+
+    ++m_misses;
+    collision = m_collision->checkConfig(config);
+    m_cache.insert(key, collision);
+    return collision;
+}
+
+/*!
+*  \brief      Quantize the configuration with the resolution
+*  \author     Sascha Kaden
+*  \param[in]  configuration
+*  \param[out] key of the cell
+*  \date       2017-12-05
+*/
+template <unsigned int dim>
+typename CollisionDetectionCache<dim>::Key CollisionDetectionCache<dim>::quantize(const Vector<dim> &config) const {
+    Key key;
+    for (unsigned int i = 0; i < dim; ++i)
+        key[i] = static_cast<int64_t>(std::floor(config[i] / m_resolution));
+    return key;
+}
+
+/*!
+*  \brief      Hash of the quantized configuration
+*  \author     Sascha Kaden
+*  \param[in]  key
+*  \param[out] hash
+*  \date       2017-12-05
+*/
+template <unsigned int dim>
+size_t CollisionDetectionCache<dim>::KeyHash::operator()(const Key &key) const {
+    uint64_t hash = 14695981039346656037ULL;
+    for (auto value : key) {
+        hash ^= static_cast<uint64_t>(value);
+        hash *= 1099511628211ULL;
+    }
+    return static_cast<size_t>(hash ^ (hash >> 29));
+}
+
+} /* namespace ippp */
+
+#endif /* COLLISIONDETECTIONCACHE_HPP */
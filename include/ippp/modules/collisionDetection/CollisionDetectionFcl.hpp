@@ -19,18 +19,33 @@
 #ifndef COLLISIONDETECTIONFCL_HPP
 #define COLLISIONDETECTIONFCL_HPP
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <memory>
+#include <mutex>
+
 #include <fcl/BVH/BVH_model.h>
 #include <fcl/collision.h>
+#include <fcl/distance.h>
 
+#include <ippp/environment/AABBTree.h>
 #include <ippp/environment/model/ModelFcl.h>
+#include <ippp/environment/robot/ForwardKinematics.hpp>
 #include <ippp/environment/robot/SerialRobot.h>
 #include <ippp/modules/collisionDetection/CollisionDetection.hpp>
+#include <ippp/modules/sampler/SamplerUniform.hpp>
 #include <ippp/util/UtilCollision.hpp>
 
 namespace ippp {
 
 /*!
 * \brief   Class for collision detection with the fcl library
+* \details The collision objects are created once. The obstacle objects are shared by all threads, the robot objects
+* get new transformations at every check and each thread takes an own set of them from a pool. With a CollisionResult and
+* a request of the distance, the minimal distances are computed by fcl::distance. The penetration depth is not supported.
+* The kinematics of a serial robot are copied at construction, the detection has to be recreated after the pose or
+* the base offset of the robot has changed.
 * \author  Sascha Kaden
 * \date    2017-02-19
 */
@@ -40,25 +55,68 @@ class CollisionDetectionFcl : public CollisionDetection<dim> {
     CollisionDetectionFcl(const std::shared_ptr<Environment> &environment, const CollisionRequest &request = CollisionRequest());
     bool checkConfig(const Vector<dim> &config, CollisionRequest *request = nullptr, CollisionResult *result = nullptr);
     bool checkTrajectory(std::vector<Vector<dim>> &configs) override;
+    bool checkTrajectoryRange(const std::vector<Vector<dim>> &configs, const size_t begin, const size_t end) override;
+    SelfCollisionMatrix computeSelfCollisionMatrix(const std::vector<Vector<dim>> &configs);
+    SelfCollisionMatrix computeSelfCollisionMatrix(const size_t numSamples, const std::string &seed = "");
+
+  protected:
+    void checkConfigRange(const std::vector<Vector<dim>> &configs, const size_t begin, const size_t end,
+                          std::vector<unsigned char> &validity) override;
 
   private:
-    bool checkSerialRobot(const Vector<dim> &config, const CollisionRequest &request);
-    bool checkMobileRobot(const Vector<dim> &config, const CollisionRequest &request);
-    bool checkFCL(const std::shared_ptr<FCLModel> &model1, const std::shared_ptr<FCLModel> &model2, const Transform &T1,
-                  const Transform &T2);
+    /*!
+    * \brief   Collision objects of the robot, which are modified by one check at a time.
+    * \details The kinematics cache keeps the links of the last checked configuration of the set.
+    */
+    struct RobotObjects {
+        RobotObjects(const ForwardKinematics<dim> &forwardKinematics) : kinematics(forwardKinematics) {
+        }
 
-    // models for collision detection
-    fcl::CollisionObject *o1 = nullptr;
-    fcl::CollisionObject *o2 = nullptr;
+        std::unique_ptr<fcl::CollisionObject> base;
+        std::vector<std::unique_ptr<fcl::CollisionObject>> joints;
+        ForwardKinematicsCache<dim> kinematics;
+
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    };
+
+    bool checkSerialRobot(const Vector<dim> &config, RobotObjects &robotObjects);
+    bool checkSerialRobot(const std::array<Transform, dim> &linkTrafos, RobotObjects &robotObjects);
+    bool checkSerialRobots(const std::vector<Vector<dim>> &configs, const size_t begin, const size_t end,
+                           std::vector<unsigned char> *validity, RobotObjects &robotObjects);
+    bool checkMobileRobot(const Vector<dim> &config, RobotObjects &robotObjects);
+    bool distanceSerialRobot(const Vector<dim> &config, const CollisionRequest &request, CollisionResult &result,
+                             RobotObjects &robotObjects);
+    bool distanceMobileRobot(const Vector<dim> &config, const CollisionRequest &request, CollisionResult &result,
+                             RobotObjects &robotObjects);
+    void distanceObstacles(const fcl::CollisionObject &object, const AABB &aabb, const double tolerance,
+                           CollisionResult &result) const;
+    bool checkFCL(const fcl::CollisionObject &object1, const fcl::CollisionObject &object2) const;
+    double distanceFCL(const fcl::CollisionObject &object1, const fcl::CollisionObject &object2,
+                       const double tolerance) const;
+    void setTransform(fcl::CollisionObject &object, const Transform &T) const;
+
+    std::unique_ptr<RobotObjects> acquireRobotObjects();
+    void releaseRobotObjects(std::unique_ptr<RobotObjects> robotObjects);
 
     Transform m_identity;
     AABB m_workspaceBounding;
     std::vector<std::shared_ptr<FCLModel>> m_obstacles;
+    std::vector<std::unique_ptr<fcl::CollisionObject>> m_obstacleObjects;
+    std::vector<AABB> m_obstacleAABBs;
+    AABBTree m_obstacleTree;
     bool m_workspaceAvaible = false;
 
     std::shared_ptr<FCLModel> m_baseModel;
     bool m_baseMeshAvaible = false;
     std::vector<std::shared_ptr<FCLModel>> m_jointModels;
+    std::array<AABB, dim> m_jointAABBs;
+    AABB m_baseAABB;
+    ForwardKinematics<dim> m_kinematics;
+    std::vector<unsigned int> m_checkedBaseJoints;
+    std::vector<std::pair<unsigned int, unsigned int>> m_checkedJointPairs;
+
+    std::vector<std::unique_ptr<RobotObjects>> m_robotObjectsPool;
+    std::mutex m_poolMutex;
 
     using CollisionDetection<dim>::m_environment;
 };
@@ -81,6 +139,7 @@ CollisionDetectionFcl<dim>::CollisionDetectionFcl(const std::shared_ptr<Environm
     if (robot->getBaseModel() != nullptr && !robot->getBaseModel()->empty()) {
         m_baseModel =
             std::shared_ptr<FCLModel>(new FCLModel(std::static_pointer_cast<ModelFcl>(robot->getBaseModel())->m_fclModel));
+        m_baseAABB = robot->getBaseModel()->getAABB();
         m_baseMeshAvaible = true;
     } else {
         Logging::error("Empty base model", this);
@@ -97,8 +156,17 @@ CollisionDetectionFcl<dim>::CollisionDetectionFcl(const std::shared_ptr<Environm
         Logging::warning("No obstacles set", this);
     }
 
+    // broadphase of the environment, the copy matches the obstacle list of this collision detection
+    m_obstacleAABBs = environment->getObstacleAABBs();
+    m_obstacleTree = environment->getObstacleTree();
+
+    // obstacles don't move, their objects are created once and only read during the checks
+    for (auto &obstacle : m_obstacles)
+        m_obstacleObjects.push_back(std::unique_ptr<fcl::CollisionObject>(new fcl::CollisionObject(obstacle)));
+
     if (robot->getRobotCategory() == RobotCategory::serial) {
         std::shared_ptr<SerialRobot> serialRobot(std::static_pointer_cast<SerialRobot>(robot));
+        m_kinematics = ForwardKinematics<dim>(*serialRobot);
         std::vector<std::shared_ptr<ModelContainer>> jointModels = serialRobot->getJointModels();
         if (!jointModels.empty()) {
             bool emptyJoint = false;
@@ -111,7 +179,17 @@ CollisionDetectionFcl<dim>::CollisionDetectionFcl(const std::shared_ptr<Environm
                 for (unsigned int i = 0; i < dim; ++i) {
                     m_jointModels.push_back(std::shared_ptr<FCLModel>(
                         new FCLModel(std::static_pointer_cast<ModelFcl>(serialRobot->getModelFromJoint(i))->m_fclModel)));
+                    m_jointAABBs[i] = jointModels[i]->m_mesh.aabb;
                 }
+                // pairs which never collide inside of the self collision matrix are skipped at runtime
+                auto matrix = serialRobot->getSelfCollisionMatrix();
+                for (unsigned int i = 1; i < dim; ++i)
+                    if (matrix.isPairChecked(0, i + 1))
+                        m_checkedBaseJoints.push_back(i);
+                for (unsigned int i = 0; i < dim; ++i)
+                    for (unsigned int j = i + 2; j < dim; ++j)
+                        if (matrix.isPairChecked(i + 1, j + 1))
+                            m_checkedJointPairs.push_back(std::make_pair(i, j));
             } else {
                 Logging::error("Emtpy joint model", this);
             }
@@ -123,8 +201,12 @@ CollisionDetectionFcl<dim>::CollisionDetectionFcl(const std::shared_ptr<Environm
 
 /*!
 *  \brief      Check for collision
+*  \details    If a CollisionResult is passed and the distance is requested, the distances are computed and written
+*  to the result.
 *  \author     Sascha Kaden
 *  \param[in]  configuration
+*  \param[in]  CollisionRequest
+*  \param[out] CollisionResult
 *  \param[out] binary result of collision (true if in collision)
 *  \date       2017-02-19
 */
@@ -134,10 +216,21 @@ bool CollisionDetectionFcl<dim>::checkConfig(const Vector<dim> &config, Collisio
     if (request)
         collisionRequest = *request;
 
-    if (m_environment->getRobot()->getRobotCategory() == RobotCategory::mobile)
-        return checkMobileRobot(config, collisionRequest);
-    else
-        return checkSerialRobot(config, collisionRequest);
+    auto robotObjects = acquireRobotObjects();
+    bool collision;
+    bool mobile = m_environment->getRobot()->getRobotCategory() == RobotCategory::mobile;
+    if (result && collisionRequest.computeDistance) {
+        if (mobile)
+            collision = distanceMobileRobot(config, collisionRequest, *result, *robotObjects);
+        else
+            collision = distanceSerialRobot(config, collisionRequest, *result, *robotObjects);
+    } else if (mobile) {
+        collision = checkMobileRobot(config, *robotObjects);
+    } else {
+        collision = checkSerialRobot(config, *robotObjects);
+    }
+    releaseRobotObjects(std::move(robotObjects));
+    return collision;
 }
 
 /*!
@@ -149,65 +242,213 @@ bool CollisionDetectionFcl<dim>::checkConfig(const Vector<dim> &config, Collisio
 */
 template <unsigned int dim>
 bool CollisionDetectionFcl<dim>::checkTrajectory(std::vector<Vector<dim>> &configs) {
-    if (configs.empty())
+    return checkTrajectoryRange(configs, 0, configs.size());
+}
+
+/*!
+*  \brief      Check collision of the points inside of the range of a trajectory
+*  \author     Sascha Kaden
+*  \param[in]  vector of configurations
+*  \param[in]  first index of the range
+*  \param[in]  end of the range
+*  \param[out] binary result of collision (true if in collision)
+*  \date       2017-12-18
+*/
+template <unsigned int dim>
+bool CollisionDetectionFcl<dim>::checkTrajectoryRange(const std::vector<Vector<dim>> &configs, const size_t begin,
+                                                      const size_t end) {
+    if (begin >= end)
         return false;
 
+    auto robotObjects = acquireRobotObjects();
+    bool collision = false;
     if (m_environment->getRobot()->getRobotCategory() == RobotCategory::mobile) {
-        for (int i = 0; i < configs.size(); ++i)
-            if (checkMobileRobot(configs[i], this->m_request))
-                return true;
+        for (size_t i = begin; i < end && !collision; ++i)
+            collision = checkMobileRobot(configs[i], *robotObjects);
     } else {
-        for (int i = 0; i < configs.size(); ++i)
-            if (checkSerialRobot(configs[i], this->m_request))
-                return true;
+        collision = checkSerialRobots(configs, begin, end, nullptr, *robotObjects);
     }
+    releaseRobotObjects(std::move(robotObjects));
+    return collision;
+}
 
-    return false;
+/*!
+*  \brief      Check the configurations inside of the range, one set of robot collision objects is used for all of them.
+*  \author     Sascha Kaden
+*  \param[in]  configurations
+*  \param[in]  first index of the range
+*  \param[in]  end of the range
+*  \param[out] validity of the configurations
+*  \date       2017-12-02
+*/
+template <unsigned int dim>
+void CollisionDetectionFcl<dim>::checkConfigRange(const std::vector<Vector<dim>> &configs, const size_t begin,
+                                                  const size_t end, std::vector<unsigned char> &validity) {
+    auto robotObjects = acquireRobotObjects();
+    if (m_environment->getRobot()->getRobotCategory() == RobotCategory::mobile) {
+        for (size_t i = begin; i < end; ++i)
+            validity[i] = !checkMobileRobot(configs[i], *robotObjects);
+    } else {
+        checkSerialRobots(configs, begin, end, &validity, *robotObjects);
+    }
+    releaseRobotObjects(std::move(robotObjects));
+}
+
+/*!
+*  \brief      Compute the SelfCollisionMatrix of the serial robot from the passed sampled configurations.
+*  \details    All model pairs are checked at every configuration, pairs without collision are marked as never
+*              colliding. The result is only as reliable as the sampling of the joint space.
+*  \author     Sascha Kaden
+*  \param[in]  sampled configurations
+*  \param[out] SelfCollisionMatrix, empty if the robot is not a serial robot with models
+*  \date       2017-12-14
+*/
+template <unsigned int dim>
+SelfCollisionMatrix CollisionDetectionFcl<dim>::computeSelfCollisionMatrix(const std::vector<Vector<dim>> &configs) {
+    if (m_environment->getRobot()->getRobotCategory() != RobotCategory::serial || !m_baseMeshAvaible ||
+        m_jointModels.size() != dim) {
+        Logging::error("Self collision matrix needs a serial robot with base and joint models", this);
+        return SelfCollisionMatrix();
+    }
+
+    auto robotObjects = acquireRobotObjects();
+    std::vector<fcl::CollisionObject *> objects(1, robotObjects->base.get());
+    for (auto &joint : robotObjects->joints)
+        objects.push_back(joint.get());
+
+    const size_t numModels = dim + 1;
+    std::vector<size_t> counts(numModels * numModels, 0);
+    for (auto &config : configs) {
+        auto &linkTrafos = robotObjects->kinematics.computeLinkTrafos(config);
+        setTransform(*objects[0], m_kinematics.getPose());
+        for (unsigned int i = 0; i < dim; ++i)
+            setTransform(*objects[i + 1], linkTrafos[i]);
+
+        for (size_t first = 0; first < numModels; ++first)
+            for (size_t second = first + 1; second < numModels; ++second)
+                if (checkFCL(*objects[first], *objects[second]))
+                    ++counts[first * numModels + second];
+    }
+    releaseRobotObjects(std::move(robotObjects));
+    return SelfCollisionMatrix(numModels, counts, configs.size());
+}
+
+/*!
+*  \brief      Compute the SelfCollisionMatrix of the serial robot from uniform samples inside of the robot boundaries.
+*  \author     Sascha Kaden
+*  \param[in]  number of samples
+*  \param[in]  seed of the sampler, random if empty
+*  \param[out] SelfCollisionMatrix, empty if the robot is not a serial robot with models
+*  \date       2017-12-15
+*/
+template <unsigned int dim>
+SelfCollisionMatrix CollisionDetectionFcl<dim>::computeSelfCollisionMatrix(const size_t numSamples, const std::string &seed) {
+    SamplerUniform<dim> sampler(m_environment, seed);
+    std::vector<Vector<dim>> configs;
+    configs.reserve(numSamples);
+    for (size_t i = 0; i < numSamples; ++i)
+        configs.push_back(sampler.getSample());
+    return computeSelfCollisionMatrix(configs);
+}
+
+/*!
+*  \brief      Check the configurations of a serial robot inside of the range, the links are computed blockwise.
+*  \details    Without a validity vector the check stops at the first collision.
+*  \author     Sascha Kaden
+*  \param[in]  configurations
+*  \param[in]  first index of the range
+*  \param[in]  end of the range
+*  \param[out] optional validity of the configurations
+*  \param[in]  collision objects of the robot
+*  \param[out] true if one of the configurations is in collision
+*  \date       2017-12-12
+*/
+template <unsigned int dim>
+bool CollisionDetectionFcl<dim>::checkSerialRobots(const std::vector<Vector<dim>> &configs, const size_t begin,
+                                                   const size_t end, std::vector<unsigned char> *validity,
+                                                   RobotObjects &robotObjects) {
+    bool collision = false;
+    std::array<std::array<Transform, dim>, util::simdBlockSize> linkTrafos;
+    for (size_t blockBegin = begin; blockBegin < end; blockBegin += util::simdBlockSize) {
+        size_t blockEnd = std::min<size_t>(blockBegin + util::simdBlockSize, end);
+        m_kinematics.computeLinkTrafos(&configs[blockBegin], blockEnd - blockBegin, linkTrafos.data());
+        for (size_t i = blockBegin; i < blockEnd; ++i) {
+            bool configCollision =
+                this->checkRobotBounding(configs[i]) || checkSerialRobot(linkTrafos[i - blockBegin], robotObjects);
+            collision |= configCollision;
+            if (validity)
+                (*validity)[i] = !configCollision;
+            else if (collision)
+                return true;
+        }
+    }
+    return collision;
 }
 
 /*!
 *  \brief      Check for collision of a serial robot
 *  \author     Sascha Kaden
 *  \param[in]  configuration
+*  \param[in]  collision objects of the robot
 *  \param[out] binary result of collision
 *  \date       2017-02-19
 */
 template <unsigned int dim>
-bool CollisionDetectionFcl<dim>::checkSerialRobot(const Vector<dim> &config, const CollisionRequest &request) {
+bool CollisionDetectionFcl<dim>::checkSerialRobot(const Vector<dim> &config, RobotObjects &robotObjects) {
     if (this->checkRobotBounding(config))
         return true;
 
-    auto robot = std::dynamic_pointer_cast<SerialRobot>(this->m_environment->getRobot());
-    auto linkTrafos = robot->getLinkTrafos(config);
-    auto pose = robot->getPose();
+    return checkSerialRobot(robotObjects.kinematics.computeLinkTrafos(config), robotObjects);
+}
+
+/*!
+*  \brief      Check for collision of a serial robot with already computed link transformations
+*  \author     Sascha Kaden
+*  \param[in]  link transformations
+*  \param[in]  collision objects of the robot
+*  \param[out] binary result of collision
+*  \date       2017-12-12
+*/
+template <unsigned int dim>
+bool CollisionDetectionFcl<dim>::checkSerialRobot(const std::array<Transform, dim> &linkTrafos,
+                                                  RobotObjects &robotObjects) {
+    const Transform pose = m_kinematics.getPose();
 
     // check models against workspace boundaries
-    auto jointModels = robot->getJointModels();
-    for (unsigned int i = 0; i < dim; ++i)
-        if (!m_workspaceBounding.contains(util::transformAABB(jointModels[i]->m_mesh.aabb, linkTrafos[i])))
+    std::array<AABB, dim> jointAABBs;
+    for (unsigned int i = 0; i < dim; ++i) {
+        jointAABBs[i] = util::transformAABB(m_jointAABBs[i], linkTrafos[i]);
+        if (!m_workspaceBounding.contains(jointAABBs[i]))
             return true;
+    }
+
+    if (m_baseMeshAvaible)
+        setTransform(*robotObjects.base, pose);
+    for (unsigned int i = 0; i < dim; ++i)
+        setTransform(*robotObjects.joints[i], linkTrafos[i]);
 
     // control collision of the robot joints with themselves
     if (m_baseMeshAvaible)
-        for (unsigned int i = 1; i < dim; ++i)
-            if (checkFCL(m_baseModel, m_jointModels[i], pose, linkTrafos[i]))
+        for (auto &i : m_checkedBaseJoints)
+            if (checkFCL(*robotObjects.base, *robotObjects.joints[i]))
                 return true;
 
-    for (unsigned int i = 0; i < dim; ++i)
-        for (unsigned int j = i + 2; j < dim; ++j)
-            if (checkFCL(m_jointModels[i], m_jointModels[j], linkTrafos[i], linkTrafos[j]))
-                return true;
+    for (auto &pair : m_checkedJointPairs)
+        if (checkFCL(*robotObjects.joints[pair.first], *robotObjects.joints[pair.second]))
+            return true;
 
-    // control collision with workspace
+    // control collision with workspace, only with the obstacles of the broadphase
     if (m_workspaceAvaible) {
-        for (auto &obstacle : m_obstacles)
-            if (checkFCL(obstacle, m_baseModel, m_identity, pose))
-                return true;
+        if (m_obstacleTree.forEachCandidate(util::transformAABB(m_baseAABB, pose), [&](const size_t index) {
+                return checkFCL(*m_obstacleObjects[index], *robotObjects.base);
+            }))
+            return true;
 
         for (unsigned int i = 0; i < dim; ++i)
-            for (auto &obstacle : m_obstacles)
-                if (checkFCL(obstacle, m_jointModels[i], m_identity, linkTrafos[i]))
-                    return true;
+            if (m_obstacleTree.forEachCandidate(jointAABBs[i], [&](const size_t index) {
+                    return checkFCL(*m_obstacleObjects[index], *robotObjects.joints[i]);
+                }))
+                return true;
     }
     return false;
 }
@@ -216,60 +457,230 @@ bool CollisionDetectionFcl<dim>::checkSerialRobot(const Vector<dim> &config, con
 *  \brief      Check for collision of mobile robot (mesh with workspace)
 *  \author     Sascha Kaden
 *  \param[in]  configuration
+*  \param[in]  collision objects of the robot
 *  \param[out] binary result of collision
 *  \date       2017-02-19
 */
 template <unsigned int dim>
-bool CollisionDetectionFcl<dim>::checkMobileRobot(const Vector<dim> &config, const CollisionRequest &request) {
+bool CollisionDetectionFcl<dim>::checkMobileRobot(const Vector<dim> &config, RobotObjects &robotObjects) {
     if (this->checkRobotBounding(config))
         return true;
 
-    Transform T = m_environment->getRobot()->getTransformation(config);
-
     if (m_baseMeshAvaible && m_workspaceAvaible) {
-        for (auto obstacle : m_obstacles)
-            if (checkFCL(obstacle, m_baseModel, m_identity, T))
-                return true;
+        Transform T = m_environment->getRobot()->getTransformation(config);
+        setTransform(*robotObjects.base, T);
+        return m_obstacleTree.forEachCandidate(util::transformAABB(m_baseAABB, T), [&](const size_t index) {
+            return checkFCL(*m_obstacleObjects[index], *robotObjects.base);
+        });
     }
     return false;
 }
 
+/*!
+*  \brief      Compute the distances of a serial robot to the obstacles and between its joints.
+*  \details    The computation stops at the first found collision, configurations outside of the boundaries are
+*  collisions without distances.
+*  \author     Sascha Kaden
+*  \param[in]  configuration
+*  \param[in]  CollisionRequest
+*  \param[out] CollisionResult
+*  \param[in]  collision objects of the robot
+*  \param[out] binary result of collision
+*  \date       2017-12-07
+*/
+template <unsigned int dim>
+bool CollisionDetectionFcl<dim>::distanceSerialRobot(const Vector<dim> &config, const CollisionRequest &request,
+                                                     CollisionResult &result, RobotObjects &robotObjects) {
+    if (this->checkRobotBounding(config)) {
+        result.collision = true;
+        return true;
+    }
+
+    const std::array<Transform, dim> &linkTrafos = robotObjects.kinematics.computeLinkTrafos(config);
+    const Transform pose = m_kinematics.getPose();
+
+    std::array<AABB, dim> jointAABBs;
+    for (unsigned int i = 0; i < dim; ++i) {
+        jointAABBs[i] = util::transformAABB(m_jointAABBs[i], linkTrafos[i]);
+        if (!m_workspaceBounding.contains(jointAABBs[i])) {
+            result.collision = true;
+            return true;
+        }
+    }
+
+    if (m_baseMeshAvaible)
+        setTransform(*robotObjects.base, pose);
+    for (unsigned int i = 0; i < dim; ++i)
+        setTransform(*robotObjects.joints[i], linkTrafos[i]);
+
+    const double tolerance = request.distanceTolerance;
+    if (request.checkInterRobot) {
+        auto updateRobotDist = [&](const double dist) {
+            result.minRobotDist = std::min(result.minRobotDist, dist);
+            if (dist <= 0)
+                result.collision = true;
+        };
+        if (m_baseMeshAvaible)
+            for (unsigned int i = 1; i < dim && !result.collision; ++i)
+                updateRobotDist(distanceFCL(*robotObjects.base, *robotObjects.joints[i], tolerance));
+
+        for (unsigned int i = 0; i < dim && !result.collision; ++i)
+            for (unsigned int j = i + 2; j < dim && !result.collision; ++j)
+                updateRobotDist(distanceFCL(*robotObjects.joints[i], *robotObjects.joints[j], tolerance));
+    }
+
+    if (request.checkObstacle && m_workspaceAvaible && !result.collision) {
+        if (m_baseMeshAvaible)
+            distanceObstacles(*robotObjects.base, util::transformAABB(m_baseAABB, pose), tolerance, result);
+        for (unsigned int i = 0; i < dim && !result.collision; ++i)
+            distanceObstacles(*robotObjects.joints[i], jointAABBs[i], tolerance, result);
+    }
+
+    result.minDist = std::min(result.minRobotDist, result.minObstacleDist);
+    return result.collision;
+}
+
+/*!
+*  \brief      Compute the distance of a mobile robot to the obstacles.
+*  \author     Sascha Kaden
+*  \param[in]  configuration
+*  \param[in]  CollisionRequest
+*  \param[out] CollisionResult
+*  \param[in]  collision objects of the robot
+*  \param[out] binary result of collision
+*  \date       2017-12-07
+*/
+template <unsigned int dim>
+bool CollisionDetectionFcl<dim>::distanceMobileRobot(const Vector<dim> &config, const CollisionRequest &request,
+                                                     CollisionResult &result, RobotObjects &robotObjects) {
+    if (this->checkRobotBounding(config)) {
+        result.collision = true;
+        return true;
+    }
+
+    if (request.checkObstacle && m_baseMeshAvaible && m_workspaceAvaible) {
+        Transform T = m_environment->getRobot()->getTransformation(config);
+        setTransform(*robotObjects.base, T);
+        distanceObstacles(*robotObjects.base, util::transformAABB(m_baseAABB, T), request.distanceTolerance, result);
+    }
+
+    result.minDist = std::min(result.minRobotDist, result.minObstacleDist);
+    return result.collision;
+}
+
+/*!
+*  \brief      Compute the minimal distance of the robot object to the obstacles and update the result.
+*  \details    The distance of the AABBs is a lower bound of the distance of the meshes, obstacles whose AABB is
+*  farther away than the current minimal distance are skipped.
+*  \author     Sascha Kaden
+*  \param[in]  FCL collision object of the robot
+*  \param[in]  transformed AABB of the object
+*  \param[in]  absolute distance tolerance
+*  \param[out] CollisionResult
+*  \date       2017-12-07
+*/
+template <unsigned int dim>
+void CollisionDetectionFcl<dim>::distanceObstacles(const fcl::CollisionObject &object, const AABB &aabb,
+                                                   const double tolerance, CollisionResult &result) const {
+    if (result.collision)
+        return;
+
+    auto distance = [&](const size_t i) { return distanceFCL(*m_obstacleObjects[i], object, tolerance); };
+    if (util::updateObstacleDistance(aabb, m_obstacleAABBs, distance, result.minObstacleDist))
+        result.collision = true;
+}
+
 /*!
 *  \brief      Check for collision with FCL library
 *  \author     Sascha Kaden
-*  \param[in]  FCL mesh model one
-*  \param[in]  FCL mesh model two
-*  \param[in]  rotation matrix one
-*  \param[in]  rotation matrix two
-*  \param[in]  translation vector one
-*  \param[in]  translation vector two
+*  \param[in]  FCL collision object one
+*  \param[in]  FCL collision object two
 *  \param[out] binary result of collision
 *  \date       2017-02-19
 */
 template <unsigned int dim>
-bool CollisionDetectionFcl<dim>::checkFCL(const std::shared_ptr<FCLModel> &model1, const std::shared_ptr<FCLModel> &model2,
-                                          const Transform &T1, const Transform &T2) {
-    const Eigen::Matrix3f R1 = T1.rotation().cast<float>();
-    const Eigen::Vector3f t1 = T1.translation().cast<float>();
-    fcl::Matrix3f fclR1(R1(0), R1(1), R1(2), R1(3), R1(4), R1(5), R1(6), R1(7), R1(8));
-    fcl::Vec3f fclT1(t1(0), t1(1), t1(2));
-
-    const Eigen::Matrix3f R2 = T2.rotation().cast<float>();
-    const Eigen::Vector3f t2 = T2.translation().cast<float>();
-    fcl::Matrix3f fclR2(R2(0), R2(1), R2(2), R2(3), R2(4), R2(5), R2(6), R2(7), R2(8));
-    fcl::Vec3f fclT2(t2(0), t2(1), t2(2));
-
-    o1 = new fcl::CollisionObject(model1, fclR1, fclT1);
-    o2 = new fcl::CollisionObject(model2, fclR2, fclT2);
+bool CollisionDetectionFcl<dim>::checkFCL(const fcl::CollisionObject &object1, const fcl::CollisionObject &object2) const {
     fcl::CollisionRequest request;    // default setting
     fcl::CollisionResult result;
-    fcl::collide(o1, o2, request, result);
-    delete o1;
-    delete o2;
-
+    fcl::collide(&object1, &object2, request, result);
     return result.isCollision();
 }
 
+/*!
+*  \brief      Compute the distance of two objects with FCL library, intersecting objects have the distance 0.
+*  \details    The distance of intersecting meshes isn't defined by fcl::distance, they are checked for collision first.
+*  \author     Sascha Kaden
+*  \param[in]  FCL collision object one
+*  \param[in]  FCL collision object two
+*  \param[in]  absolute distance tolerance
+*  \param[out] distance
+*  \date       2017-12-07
+*/
+template <unsigned int dim>
+double CollisionDetectionFcl<dim>::distanceFCL(const fcl::CollisionObject &object1, const fcl::CollisionObject &object2,
+                                               const double tolerance) const {
+    if (checkFCL(object1, object2))
+        return 0;
+
+    fcl::DistanceRequest request(false, 0, tolerance);
+    fcl::DistanceResult result;
+    fcl::distance(&object1, &object2, request, result);
+    return std::max(0.0, static_cast<double>(result.min_distance));
+}
+
+/*!
+*  \brief      Set the transformation of a FCL collision object.
+*  \author     Sascha Kaden
+*  \param[in]  FCL collision object
+*  \param[in]  transformation
+*  \date       2017-11-30
+*/
+template <unsigned int dim>
+void CollisionDetectionFcl<dim>::setTransform(fcl::CollisionObject &object, const Transform &T) const {
+    const Matrix3 R = T.rotation();
+    const Vector3 t = T.translation();
+    object.setTransform(fcl::Matrix3f(R(0, 0), R(0, 1), R(0, 2), R(1, 0), R(1, 1), R(1, 2), R(2, 0), R(2, 1), R(2, 2)),
+                        fcl::Vec3f(t[0], t[1], t[2]));
+}
+
+/*!
+*  \brief      Take a set of robot collision objects from the pool, a new set is created if the pool is empty.
+*  \details    The pool grows up to the number of threads, which check at the same time.
+*  \author     Sascha Kaden
+*  \param[out] robot collision objects
+*  \date       2017-11-30
+*/
+template <unsigned int dim>
+std::unique_ptr<typename CollisionDetectionFcl<dim>::RobotObjects> CollisionDetectionFcl<dim>::acquireRobotObjects() {
+    {
+        std::lock_guard<std::mutex> lock(m_poolMutex);
+        if (!m_robotObjectsPool.empty()) {
+            auto robotObjects = std::move(m_robotObjectsPool.back());
+            m_robotObjectsPool.pop_back();
+            return robotObjects;
+        }
+    }
+
+    std::unique_ptr<RobotObjects> robotObjects(new RobotObjects(m_kinematics));
+    if (m_baseModel)
+        robotObjects->base.reset(new fcl::CollisionObject(m_baseModel));
+    for (auto &jointModel : m_jointModels)
+        robotObjects->joints.push_back(std::unique_ptr<fcl::CollisionObject>(new fcl::CollisionObject(jointModel)));
+    return robotObjects;
+}
+
+/*!
+*  \brief      Return a set of robot collision objects to the pool.
+*  \author     Sascha Kaden
+*  \param[in]  robot collision objects
+*  \date       2017-11-30
+*/
+template <unsigned int dim>
+void CollisionDetectionFcl<dim>::releaseRobotObjects(std::unique_ptr<RobotObjects> robotObjects) {
+    std::lock_guard<std::mutex> lock(m_poolMutex);
+    m_robotObjectsPool.push_back(std::move(robotObjects));
+}
+
 } /* namespace ippp */
 
 #endif /* COLLISIONDETECTIONFCL_HPP */
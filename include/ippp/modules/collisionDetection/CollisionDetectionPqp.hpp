@@ -19,15 +19,28 @@
 #ifndef COLLISIONDETECTIONPQP_HPP
 #define COLLISIONDETECTIONPQP_HPP
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <mutex>
+
+#include <ippp/environment/AABBTree.h>
 #include <ippp/environment/model/ModelPqp.h>
+#include <ippp/environment/robot/ForwardKinematics.hpp>
 #include <ippp/environment/robot/SerialRobot.h>
 #include <ippp/modules/collisionDetection/CollisionDetection.hpp>
+#include <ippp/modules/sampler/SamplerUniform.hpp>
 #include <ippp/util/UtilCollision.hpp>
 
 namespace ippp {
 
 /*!
 * \brief   Class collision detection with the pqp library
+* \details With a CollisionResult and a request of the distance, the minimal distances to the obstacles and between the
+* parts of the robot are computed by PQP_Distance. The penetration depth is not supported. PQP_Distance writes the
+* last triangle pair into the PQP_Models, the distance queries are serialized by a mutex.
+* The kinematics of a serial robot are copied at construction, the detection has to be recreated after the pose or
+* the base offset of the robot has changed. The bounding spheres of the robot models reject pairs before PQP_Collide.
 * \author  Sascha Kaden
 * \date    2017-02-19
 */
@@ -37,21 +50,43 @@ class CollisionDetectionPqp : public CollisionDetection<dim> {
     CollisionDetectionPqp(const std::shared_ptr<Environment> &environment, const CollisionRequest &request = CollisionRequest());
     bool checkConfig(const Vector<dim> &config, CollisionRequest *request = nullptr, CollisionResult *result = nullptr);
     bool checkTrajectory(std::vector<Vector<dim>> &configs) override;
+    bool checkTrajectoryRange(const std::vector<Vector<dim>> &configs, const size_t begin, const size_t end) override;
+    SelfCollisionMatrix computeSelfCollisionMatrix(const std::vector<Vector<dim>> &configs);
+    SelfCollisionMatrix computeSelfCollisionMatrix(const size_t numSamples, const std::string &seed = "");
 
   protected:
+    void checkConfigRange(const std::vector<Vector<dim>> &configs, const size_t begin, const size_t end,
+                          std::vector<unsigned char> &validity) override;
     bool checkSerialRobot(const Vector<dim> &config);
+    bool checkSerialRobot(const std::array<Transform, dim> &linkTrafos);
     bool checkMobileRobot(const Vector<dim> &config);
+    bool distanceSerialRobot(const Vector<dim> &config, const CollisionRequest &request, CollisionResult &result);
+    bool distanceMobileRobot(const Vector<dim> &config, const CollisionRequest &request, CollisionResult &result);
+    void distanceObstacles(PQP_Model *model, const Transform &T, const AABB &aabb, const double tolerance,
+                           CollisionResult &result);
 
     bool checkPQP(PQP_Model *model1, PQP_Model *model2, const Transform &T1, const Transform &T2);
+    double distancePQP(PQP_Model *model1, PQP_Model *model2, const Transform &T1, const Transform &T2,
+                       const double tolerance);
 
     Transform m_identity;
     AABB m_workspaceBounding;
+    std::mutex m_distanceMutex;
     std::vector<PQP_Model *> m_obstacles;
+    std::vector<AABB> m_obstacleAABBs;
+    AABBTree m_obstacleTree;
     bool m_workspaceAvaible = false;
 
     PQP_Model *m_baseModel = nullptr;
     bool m_baseMeshAvaible = false;
     std::vector<PQP_Model *> m_jointModels;
+    std::array<AABB, dim> m_jointAABBs;
+    std::array<BoundingSpheres, dim> m_jointSpheres;
+    AABB m_baseAABB;
+    BoundingSpheres m_baseSpheres;
+    ForwardKinematics<dim> m_kinematics;
+    std::vector<unsigned int> m_checkedBaseJoints;
+    std::vector<std::pair<unsigned int, unsigned int>> m_checkedJointPairs;
 
     using CollisionDetection<dim>::m_environment;
 };
@@ -74,6 +109,8 @@ CollisionDetectionPqp<dim>::CollisionDetectionPqp(const std::shared_ptr<Environm
 
     if (robot->getBaseModel() != nullptr && !robot->getBaseModel()->empty()) {
         m_baseModel = &std::static_pointer_cast<ModelPqp>(robot->getBaseModel())->m_pqpModel;
+        m_baseAABB = robot->getBaseModel()->getAABB();
+        m_baseSpheres = robot->getBaseModel()->getBoundingSpheres();
         m_baseMeshAvaible = true;
     } else {
         Logging::error("Empty base model", this);
@@ -89,8 +126,13 @@ CollisionDetectionPqp<dim>::CollisionDetectionPqp(const std::shared_ptr<Environm
         Logging::warning("No obstacles set", this);
     }
 
+    // broadphase of the environment, the copy matches the obstacle list of this collision detection
+    m_obstacleAABBs = environment->getObstacleAABBs();
+    m_obstacleTree = environment->getObstacleTree();
+
     if (robot->getRobotCategory() == RobotCategory::serial) {
         std::shared_ptr<SerialRobot> serialRobot(std::static_pointer_cast<SerialRobot>(robot));
+        m_kinematics = ForwardKinematics<dim>(*serialRobot);
         std::vector<std::shared_ptr<ModelContainer>> jointModels = serialRobot->getJointModels();
         if (!jointModels.empty()) {
             bool emptyJoint = false;
@@ -102,7 +144,18 @@ CollisionDetectionPqp<dim>::CollisionDetectionPqp(const std::shared_ptr<Environm
             if (!emptyJoint) {
                 for (unsigned int i = 0; i < dim; ++i) {
                     m_jointModels.push_back(&std::static_pointer_cast<ModelPqp>(serialRobot->getModelFromJoint(i))->m_pqpModel);
+                    m_jointAABBs[i] = jointModels[i]->m_mesh.aabb;
+                    m_jointSpheres[i] = jointModels[i]->getBoundingSpheres();
                 }
+                // pairs which never collide inside of the self collision matrix are skipped at runtime
+                auto matrix = serialRobot->getSelfCollisionMatrix();
+                for (unsigned int i = 1; i < dim; ++i)
+                    if (matrix.isPairChecked(0, i + 1))
+                        m_checkedBaseJoints.push_back(i);
+                for (unsigned int i = 0; i < dim; ++i)
+                    for (unsigned int j = i + 2; j < dim; ++j)
+                        if (matrix.isPairChecked(i + 1, j + 1))
+                            m_checkedJointPairs.push_back(std::make_pair(i, j));
             } else {
                 Logging::error("Emtpy joint model", this);
             }
@@ -114,14 +167,32 @@ CollisionDetectionPqp<dim>::CollisionDetectionPqp(const std::shared_ptr<Environm
 
 /*!
 *  \brief      Check for collision
+*  \details    If a CollisionResult is passed and the distance is requested, the distances are computed and written
+*  to the result.
 *  \author     Sascha Kaden
 *  \param[in]  configuration
+*  \param[in]  CollisionRequest
+*  \param[out] CollisionResult
 *  \param[out] binary result of collision (true if in collision)
 *  \date       2017-02-19
 */
 template <unsigned int dim>
 bool CollisionDetectionPqp<dim>::checkConfig(const Vector<dim> &config, CollisionRequest *request, CollisionResult *result) {
-    if (m_environment->getRobot()->getRobotCategory() == RobotCategory::mobile)
+    CollisionRequest collisionRequest = this->m_request;
+    if (request)
+        collisionRequest = *request;
+
+    bool mobile = m_environment->getRobot()->getRobotCategory() == RobotCategory::mobile;
+    if (result && collisionRequest.computeDistance) {
+        // PQP_Distance caches the last triangle pair inside of the shared PQP_Models
+        std::lock_guard<std::mutex> lock(m_distanceMutex);
+        if (mobile)
+            return distanceMobileRobot(config, collisionRequest, *result);
+        else
+            return distanceSerialRobot(config, collisionRequest, *result);
+    }
+
+    if (mobile)
         return checkMobileRobot(config);
     else
         return checkSerialRobot(config);
@@ -136,21 +207,124 @@ bool CollisionDetectionPqp<dim>::checkConfig(const Vector<dim> &config, Collisio
 */
 template <unsigned int dim>
 bool CollisionDetectionPqp<dim>::checkTrajectory(std::vector<Vector<dim>> &configs) {
-    if (configs.empty())
+    return checkTrajectoryRange(configs, 0, configs.size());
+}
+
+/*!
+*  \brief      Check collision of the points inside of the range of a trajectory
+*  \author     Sascha Kaden
+*  \param[in]  vector of configurations
+*  \param[in]  first index of the range
+*  \param[in]  end of the range
+*  \param[out] binary result of collision (true if in collision)
+*  \date       2017-12-18
+*/
+template <unsigned int dim>
+bool CollisionDetectionPqp<dim>::checkTrajectoryRange(const std::vector<Vector<dim>> &configs, const size_t begin,
+                                                      const size_t end) {
+    if (begin >= end)
         return false;
 
     if (m_environment->getRobot()->getRobotCategory() == RobotCategory::mobile) {
-        for (size_t i = 0; i < configs.size(); ++i)
+        for (size_t i = begin; i < end; ++i)
             if (checkMobileRobot(configs[i]))
                 return true;
     } else {
-        for (size_t i = 0; i < configs.size(); ++i)
-            if (checkSerialRobot(configs[i]))
-                return true;
+        // the links of a block of configurations are computed together
+        std::array<std::array<Transform, dim>, util::simdBlockSize> linkTrafos;
+        for (size_t blockBegin = begin; blockBegin < end; blockBegin += util::simdBlockSize) {
+            size_t blockEnd = std::min<size_t>(blockBegin + util::simdBlockSize, end);
+            m_kinematics.computeLinkTrafos(&configs[blockBegin], blockEnd - blockBegin, linkTrafos.data());
+            for (size_t i = blockBegin; i < blockEnd; ++i)
+                if (this->checkRobotBounding(configs[i]) || checkSerialRobot(linkTrafos[i - blockBegin]))
+                    return true;
+        }
     }
     return false;
 }
 
+/*!
+*  \brief      Check the configurations inside of the range, the links of serial robots are computed blockwise.
+*  \author     Sascha Kaden
+*  \param[in]  configurations
+*  \param[in]  first index of the range
+*  \param[in]  end of the range
+*  \param[out] validity of the configurations
+*  \date       2017-12-12
+*/
+template <unsigned int dim>
+void CollisionDetectionPqp<dim>::checkConfigRange(const std::vector<Vector<dim>> &configs, const size_t begin,
+                                                  const size_t end, std::vector<unsigned char> &validity) {
+    if (m_environment->getRobot()->getRobotCategory() == RobotCategory::mobile) {
+        for (size_t i = begin; i < end; ++i)
+            validity[i] = !checkMobileRobot(configs[i]);
+        return;
+    }
+
+    std::array<std::array<Transform, dim>, util::simdBlockSize> linkTrafos;
+    for (size_t blockBegin = begin; blockBegin < end; blockBegin += util::simdBlockSize) {
+        size_t blockEnd = std::min<size_t>(blockBegin + util::simdBlockSize, end);
+        m_kinematics.computeLinkTrafos(&configs[blockBegin], blockEnd - blockBegin, linkTrafos.data());
+        for (size_t i = blockBegin; i < blockEnd; ++i)
+            validity[i] = !this->checkRobotBounding(configs[i]) && !checkSerialRobot(linkTrafos[i - blockBegin]);
+    }
+}
+
+/*!
+*  \brief      Compute the SelfCollisionMatrix of the serial robot from the passed sampled configurations.
+*  \details    All model pairs are checked at every configuration, pairs without collision are marked as never
+*              colliding. The result is only as reliable as the sampling of the joint space.
+*  \author     Sascha Kaden
+*  \param[in]  sampled configurations
+*  \param[out] SelfCollisionMatrix, empty if the robot is not a serial robot with models
+*  \date       2017-12-14
+*/
+template <unsigned int dim>
+SelfCollisionMatrix CollisionDetectionPqp<dim>::computeSelfCollisionMatrix(const std::vector<Vector<dim>> &configs) {
+    if (m_environment->getRobot()->getRobotCategory() != RobotCategory::serial || !m_baseMeshAvaible ||
+        m_jointModels.size() != dim) {
+        Logging::error("Self collision matrix needs a serial robot with base and joint models", this);
+        return SelfCollisionMatrix();
+    }
+
+    const size_t numModels = dim + 1;
+    std::vector<PQP_Model *> models(1, m_baseModel);
+    models.insert(models.end(), m_jointModels.begin(), m_jointModels.end());
+    std::vector<size_t> counts(numModels * numModels, 0);
+    std::array<Transform, dim> linkTrafos;
+    std::vector<Transform, Eigen::aligned_allocator<Transform>> trafos(numModels);
+    for (auto &config : configs) {
+        m_kinematics.computeLinkTrafos(config, linkTrafos);
+        trafos[0] = m_kinematics.getPose();
+        for (unsigned int i = 0; i < dim; ++i)
+            trafos[i + 1] = linkTrafos[i];
+
+        for (size_t first = 0; first < numModels; ++first)
+            for (size_t second = first + 1; second < numModels; ++second)
+                if (checkPQP(models[first], models[second], trafos[first], trafos[second]))
+                    ++counts[first * numModels + second];
+    }
+    return SelfCollisionMatrix(numModels, counts, configs.size());
+}
+
+/*!
+*  \brief      Compute the SelfCollisionMatrix of the serial robot from uniform samples inside of the robot boundaries.
+*  \author     Sascha Kaden
+*  \param[in]  number of samples
+*  \param[in]  seed of the sampler, random if empty
+*  \param[out] SelfCollisionMatrix, empty if the robot is not a serial robot with models
+*  \date       2017-12-15
+*/
+template <unsigned int dim>
+SelfCollisionMatrix CollisionDetectionPqp<dim>::computeSelfCollisionMatrix(const size_t numSamples, const std::string &seed) {
+    SamplerUniform<dim> sampler(m_environment, seed);
+    std::vector<Vector<dim>> configs;
+    configs.reserve(numSamples);
+    for (size_t i = 0; i < numSamples; ++i)
+        configs.push_back(sampler.getSample());
+    return computeSelfCollisionMatrix(configs);
+}
+
 /*!
 *  \brief      Check for collision of a serial robot
 *  \author     Sascha Kaden
@@ -163,37 +337,63 @@ bool CollisionDetectionPqp<dim>::checkSerialRobot(const Vector<dim> &config) {
     if (this->checkRobotBounding(config))
         return true;
 
-    auto robot = std::dynamic_pointer_cast<SerialRobot>(this->m_environment->getRobot());
-    auto linkTrafos = robot->getLinkTrafos(config);
-    auto pose = robot->getPose();
+    std::array<Transform, dim> linkTrafos;
+    m_kinematics.computeLinkTrafos(config, linkTrafos);
+    return checkSerialRobot(linkTrafos);
+}
+
+/*!
+*  \brief      Check for collision of a serial robot with already computed link transformations
+*  \author     Sascha Kaden
+*  \param[in]  link transformations
+*  \param[out] binary result of collision (true if in collision)
+*  \date       2017-12-11
+*/
+template <unsigned int dim>
+bool CollisionDetectionPqp<dim>::checkSerialRobot(const std::array<Transform, dim> &linkTrafos) {
+    const Transform pose = m_kinematics.getPose();
 
     // check models against workspace boundaries
-    auto jointModels = robot->getJointModels();
-    for (unsigned int i = 0; i < dim; ++i)
-        if (!m_workspaceBounding.contains(util::transformAABB(jointModels[i]->m_mesh.aabb, linkTrafos[i])))
+    std::array<AABB, dim> jointAABBs;
+    for (unsigned int i = 0; i < dim; ++i) {
+        jointAABBs[i] = util::transformAABB(m_jointAABBs[i], linkTrafos[i]);
+        if (!m_workspaceBounding.contains(jointAABBs[i]))
             return true;
+    }
+
+    // pairs with separated bounding spheres are free, only the others are passed to PQP
+    const BoundingSpheres baseSpheres = util::transformSpheres(m_baseSpheres, pose);
+    std::array<BoundingSpheres, dim> jointSpheres;
+    for (unsigned int i = 0; i < dim; ++i)
+        jointSpheres[i] = util::transformSpheres(m_jointSpheres[i], linkTrafos[i]);
 
     // control collision of the robot joints with themselves
     if (m_baseMeshAvaible)
-        for (unsigned int i = 1; i < dim; ++i)
-            if (checkPQP(m_baseModel, m_jointModels[i], pose, linkTrafos[i]))
+        for (auto &i : m_checkedBaseJoints)
+            if (util::spheresOverlap(baseSpheres, jointSpheres[i]) &&
+                checkPQP(m_baseModel, m_jointModels[i], pose, linkTrafos[i]))
                 return true;
 
-    for (unsigned int i = 0; i < dim; ++i)
-        for (unsigned int j = i + 2; j < dim; ++j)
-            if (checkPQP(m_jointModels[i], m_jointModels[j], linkTrafos[i], linkTrafos[j]))
-                return true;
+    for (auto &pair : m_checkedJointPairs)
+        if (util::spheresOverlap(jointSpheres[pair.first], jointSpheres[pair.second]) &&
+            checkPQP(m_jointModels[pair.first], m_jointModels[pair.second], linkTrafos[pair.first],
+                     linkTrafos[pair.second]))
+            return true;
 
-    // control collision with workspace
+    // control collision with workspace, only with the obstacles of the broadphase
     if (m_workspaceAvaible) {
-        for (auto &obstacle : m_obstacles)
-            if (checkPQP(obstacle, m_baseModel, m_identity, pose))
-                return true;
+        if (m_obstacleTree.forEachCandidate(util::transformAABB(m_baseAABB, pose), [&](const size_t index) {
+                return util::spheresOverlap(baseSpheres, m_obstacleAABBs[index]) &&
+                       checkPQP(m_obstacles[index], m_baseModel, m_identity, pose);
+            }))
+            return true;
 
         for (unsigned int i = 0; i < dim; ++i)
-            for (auto &obstacle : m_obstacles)
-                if (checkPQP(obstacle, m_jointModels[i], m_identity, linkTrafos[i]))
-                    return true;
+            if (m_obstacleTree.forEachCandidate(jointAABBs[i], [&](const size_t index) {
+                    return util::spheresOverlap(jointSpheres[i], m_obstacleAABBs[index]) &&
+                           checkPQP(m_obstacles[index], m_jointModels[i], m_identity, linkTrafos[i]);
+                }))
+                return true;
     }
     return false;
 }
@@ -213,15 +413,123 @@ bool CollisionDetectionPqp<dim>::checkMobileRobot(const Vector<dim> &config) {
     auto T = m_environment->getRobot()->getTransformation(config);
 
     if (m_baseMeshAvaible && m_workspaceAvaible) {
-        for (auto obstacle : m_obstacles) {
-            if (checkPQP(obstacle, m_baseModel, m_identity, T)) {
-                return true;
-            }
-        }
+        const BoundingSpheres baseSpheres = util::transformSpheres(m_baseSpheres, T);
+        return m_obstacleTree.forEachCandidate(util::transformAABB(m_baseAABB, T), [&](const size_t index) {
+            return util::spheresOverlap(baseSpheres, m_obstacleAABBs[index]) &&
+                   checkPQP(m_obstacles[index], m_baseModel, m_identity, T);
+        });
     }
     return false;
 }
 
+/*!
+*  \brief      Compute the distances of a serial robot to the obstacles and between its joints.
+*  \details    The computation stops at the first found collision, configurations outside of the boundaries are
+*  collisions without distances.
+*  \author     Sascha Kaden
+*  \param[in]  configuration
+*  \param[in]  CollisionRequest
+*  \param[out] CollisionResult
+*  \param[out] binary result of collision (true if in collision)
+*  \date       2017-12-07
+*/
+template <unsigned int dim>
+bool CollisionDetectionPqp<dim>::distanceSerialRobot(const Vector<dim> &config, const CollisionRequest &request,
+                                                     CollisionResult &result) {
+    if (this->checkRobotBounding(config)) {
+        result.collision = true;
+        return true;
+    }
+
+    std::array<Transform, dim> linkTrafos;
+    m_kinematics.computeLinkTrafos(config, linkTrafos);
+    const Transform pose = m_kinematics.getPose();
+
+    std::array<AABB, dim> jointAABBs;
+    for (unsigned int i = 0; i < dim; ++i) {
+        jointAABBs[i] = util::transformAABB(m_jointAABBs[i], linkTrafos[i]);
+        if (!m_workspaceBounding.contains(jointAABBs[i])) {
+            result.collision = true;
+            return true;
+        }
+    }
+
+    const double tolerance = request.distanceTolerance;
+    if (request.checkInterRobot) {
+        auto updateRobotDist = [&](const double dist) {
+            result.minRobotDist = std::min(result.minRobotDist, dist);
+            if (dist <= 0)
+                result.collision = true;
+        };
+        if (m_baseMeshAvaible)
+            for (unsigned int i = 1; i < dim && !result.collision; ++i)
+                updateRobotDist(distancePQP(m_baseModel, m_jointModels[i], pose, linkTrafos[i], tolerance));
+
+        for (unsigned int i = 0; i < dim && !result.collision; ++i)
+            for (unsigned int j = i + 2; j < dim && !result.collision; ++j)
+                updateRobotDist(distancePQP(m_jointModels[i], m_jointModels[j], linkTrafos[i], linkTrafos[j], tolerance));
+    }
+
+    if (request.checkObstacle && m_workspaceAvaible && !result.collision) {
+        if (m_baseMeshAvaible)
+            distanceObstacles(m_baseModel, pose, util::transformAABB(m_baseAABB, pose), tolerance, result);
+        for (unsigned int i = 0; i < dim && !result.collision; ++i)
+            distanceObstacles(m_jointModels[i], linkTrafos[i], jointAABBs[i], tolerance, result);
+    }
+
+    result.minDist = std::min(result.minRobotDist, result.minObstacleDist);
+    return result.collision;
+}
+
+/*!
+*  \brief      Compute the distance of a mobile robot to the obstacles.
+*  \author     Sascha Kaden
+*  \param[in]  configuration
+*  \param[in]  CollisionRequest
+*  \param[out] CollisionResult
+*  \param[out] binary result of collision (true if in collision)
+*  \date       2017-12-07
+*/
+template <unsigned int dim>
+bool CollisionDetectionPqp<dim>::distanceMobileRobot(const Vector<dim> &config, const CollisionRequest &request,
+                                                     CollisionResult &result) {
+    if (this->checkRobotBounding(config)) {
+        result.collision = true;
+        return true;
+    }
+
+    if (request.checkObstacle && m_baseMeshAvaible && m_workspaceAvaible) {
+        auto T = m_environment->getRobot()->getTransformation(config);
+        distanceObstacles(m_baseModel, T, util::transformAABB(m_baseAABB, T), request.distanceTolerance, result);
+    }
+
+    result.minDist = std::min(result.minRobotDist, result.minObstacleDist);
+    return result.collision;
+}
+
+/*!
+*  \brief      Compute the minimal distance of the robot model to the obstacles and update the result.
+*  \details    The distance of the AABBs is a lower bound of the distance of the meshes, obstacles whose AABB is
+*  farther away than the current minimal distance are skipped.
+*  \author     Sascha Kaden
+*  \param[in]  PQP model of the robot
+*  \param[in]  transformation of the model
+*  \param[in]  transformed AABB of the model
+*  \param[in]  absolute distance tolerance
+*  \param[out] CollisionResult
+*  \date       2017-12-07
+*/
+template <unsigned int dim>
+void CollisionDetectionPqp<dim>::distanceObstacles(PQP_Model *model, const Transform &T, const AABB &aabb,
+                                                   const double tolerance, CollisionResult &result) {
+    if (result.collision)
+        return;
+
+    auto distance = [&](const size_t i) { return distancePQP(m_obstacles[i], model, m_identity, T, tolerance); };
+    if (util::updateObstacleDistance(aabb, m_obstacleAABBs, distance, result.minObstacleDist))
+        result.collision = true;
+}
+
 /*!
 *  \brief      Check for collision with PQP library
 *  \author     Sascha Kaden
@@ -255,6 +563,36 @@ bool CollisionDetectionPqp<dim>::checkPQP(PQP_Model *model1, PQP_Model *model2,
         return false;
 }
 
+/*!
+*  \brief      Compute the distance of two models with PQP library, intersecting models have the distance 0.
+*  \author     Sascha Kaden
+*  \param[in]  PQP mesh model one
+*  \param[in]  PQP mesh model two
+*  \param[in]  transformation one
+*  \param[in]  transformation two
+*  \param[in]  absolute distance tolerance
+*  \param[out] distance
+*  \date       2017-12-07
+*/
+template <unsigned int dim>
+double CollisionDetectionPqp<dim>::distancePQP(PQP_Model *model1, PQP_Model *model2, const Transform &T1,
+                                               const Transform &T2, const double tolerance) {
+    PQP_REAL pqpR1[3][3], pqpR2[3][3], pqpT1[3], pqpT2[3];
+
+    for (size_t i = 0; i < 3; ++i) {
+        for (size_t j = 0; j < 3; ++j) {
+            pqpR1[i][j] = T1.linear()(i, j);
+            pqpR2[i][j] = T2.linear()(i, j);
+        }
+        pqpT1[i] = T1.translation()(i);
+        pqpT2[i] = T2.translation()(i);
+    }
+
+    PQP_DistanceResult dres;
+    PQP_Distance(&dres, pqpR1, pqpT1, model1, pqpR2, pqpT2, model2, 0, tolerance);
+    return dres.Distance();
+}
+
 } /* namespace ippp */
 
 #endif /* COLLISIONDETECTIONPQP_HPP */
@@ -25,6 +25,8 @@ namespace ippp {
 
 /*!
 * \brief   Request for the CollisionDetection class and single collision method requests.
+* \details The distanceTolerance is the absolute error, which is allowed for the computed distances. Larger
+* tolerances let the distance queries of the mesh backends terminate earlier.
 * \author  Sascha Kaden
 * \date    2017-11-10
 */
@@ -33,6 +35,7 @@ struct CollisionRequest {
     bool checkObstacle = true;
     bool computeDistance = false;
     bool computePenetrationDepth = false;
+    double distanceTolerance = 0;
 };
 
 } /* namespace ippp */
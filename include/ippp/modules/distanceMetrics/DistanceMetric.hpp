@@ -33,6 +33,8 @@ class Node;
 
 /*!
 * \brief   Interface class for the computation of the distance costs between two nodes/configurations.
+* \details The implemented metrics are final, modules which get the metric as template parameter (e.g. KDTree<dim, T,
+* L2Metric<dim>>) call them without virtual dispatch.
 * \author  Sascha Kaden
 * \date    2017-01-02
 */
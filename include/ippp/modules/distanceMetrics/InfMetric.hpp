@@ -29,7 +29,7 @@ namespace ippp {
 * \date    2017-01-02
 */
 template <unsigned int dim>
-class InfMetric : public DistanceMetric<dim> {
+class InfMetric final : public DistanceMetric<dim> {
   public:
     InfMetric();
     double calcDist(const Vector<dim> &source, const Vector<dim> &target) const;
@@ -56,7 +56,7 @@ InfMetric<dim>::InfMetric() : DistanceMetric<dim>("Inf Metric") {
 */
 template <unsigned int dim>
 double InfMetric<dim>::calcDist(const Vector<dim> &source, const Vector<dim> &target) const {
-    return (source - target).maxCoeff();
+    return (source - target).cwiseAbs().maxCoeff();
 }
 
 /*!
@@ -69,7 +69,7 @@ double InfMetric<dim>::calcDist(const Vector<dim> &source, const Vector<dim> &ta
 */
 template <unsigned int dim>
 double InfMetric<dim>::calcSimpleDist(const Vector<dim> &source, const Vector<dim> &target) const {
-    return (source - target).maxCoeff();
+    return (source - target).cwiseAbs().maxCoeff();
 }
 
 /*!
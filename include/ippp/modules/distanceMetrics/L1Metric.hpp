@@ -29,7 +29,7 @@ namespace ippp {
 * \date    2017-01-02
 */
 template <unsigned int dim>
-class L1Metric : public DistanceMetric<dim> {
+class L1Metric final : public DistanceMetric<dim> {
   public:
     L1Metric();
     double calcDist(const Vector<dim> &source, const Vector<dim> &target) const;
@@ -56,7 +56,7 @@ L1Metric<dim>::L1Metric() : DistanceMetric<dim>("L1 Metric") {
 */
 template <unsigned int dim>
 double L1Metric<dim>::calcDist(const Vector<dim> &source, const Vector<dim> &target) const {
-    return (source - target).sum();
+    return (source - target).cwiseAbs().sum();
 }
 
 /*!
@@ -69,7 +69,7 @@ double L1Metric<dim>::calcDist(const Vector<dim> &source, const Vector<dim> &tar
 */
 template <unsigned int dim>
 double L1Metric<dim>::calcSimpleDist(const Vector<dim> &source, const Vector<dim> &target) const {
-    return (source - target).sum();
+    return (source - target).cwiseAbs().sum();
 }
 
 /*!
@@ -29,7 +29,7 @@ namespace ippp {
 * \date    2017-01-02
 */
 template <unsigned int dim>
-class L2Metric : public DistanceMetric<dim> {
+class L2Metric final : public DistanceMetric<dim> {
   public:
     L2Metric();
     double calcDist(const Vector<dim> &source, const Vector<dim> &target) const;
@@ -29,7 +29,7 @@ namespace ippp {
 * \date    2017-01-02
 */
 template <unsigned int dim>
-class WeightedInfMetric : public DistanceMetric<dim> {
+class WeightedInfMetric final : public DistanceMetric<dim> {
   public:
     WeightedInfMetric();
     WeightedInfMetric(const Vector<dim> &weightVec);
@@ -51,6 +51,7 @@ class WeightedInfMetric : public DistanceMetric<dim> {
 */
 template <unsigned int dim>
 WeightedInfMetric<dim>::WeightedInfMetric() : DistanceMetric<dim>("weightVecInf metric") {
+    m_weightVec = Vector<dim>::Ones();
 }
 
 /*!
@@ -74,7 +75,7 @@ WeightedInfMetric<dim>::WeightedInfMetric(const Vector<dim> &weightVec) : Distan
 */
 template <unsigned int dim>
 double WeightedInfMetric<dim>::calcDist(const Vector<dim> &source, const Vector<dim> &target) const {
-    return (source - target).cwiseProduct(m_weightVec).maxCoeff();
+    return (source - target).cwiseProduct(m_weightVec).cwiseAbs().maxCoeff();
 }
 
 /*!
@@ -87,7 +88,7 @@ double WeightedInfMetric<dim>::calcDist(const Vector<dim> &source, const Vector<
 */
 template <unsigned int dim>
 double WeightedInfMetric<dim>::calcSimpleDist(const Vector<dim> &source, const Vector<dim> &target) const {
-    return (source - target).cwiseProduct(m_weightVec).maxCoeff();
+    return (source - target).cwiseProduct(m_weightVec).cwiseAbs().maxCoeff();
 }
 
 /*!
@@ -29,7 +29,7 @@ namespace ippp {
 * \date    2017-01-02
 */
 template <unsigned int dim>
-class WeightedL1Metric : public DistanceMetric<dim> {
+class WeightedL1Metric final : public DistanceMetric<dim> {
   public:
     WeightedL1Metric();
     WeightedL1Metric(const Vector<dim> &weightVec);
@@ -51,6 +51,7 @@ class WeightedL1Metric : public DistanceMetric<dim> {
 */
 template <unsigned int dim>
 WeightedL1Metric<dim>::WeightedL1Metric() : DistanceMetric<dim>("weightVecL1 metric") {
+    m_weightVec = Vector<dim>::Ones();
 }
 
 /*!
@@ -74,7 +75,7 @@ WeightedL1Metric<dim>::WeightedL1Metric(const Vector<dim> &weightVec) : Distance
 */
 template <unsigned int dim>
 double WeightedL1Metric<dim>::calcDist(const Vector<dim> &source, const Vector<dim> &target) const {
-    return (source - target).cwiseProduct(m_weightVec).sum();
+    return (source - target).cwiseProduct(m_weightVec).cwiseAbs().sum();
 }
 
 /*!
@@ -87,7 +88,7 @@ double WeightedL1Metric<dim>::calcDist(const Vector<dim> &source, const Vector<d
 */
 template <unsigned int dim>
 double WeightedL1Metric<dim>::calcSimpleDist(const Vector<dim> &source, const Vector<dim> &target) const {
-    return (source - target).cwiseProduct(m_weightVec).sum();
+    return (source - target).cwiseProduct(m_weightVec).cwiseAbs().sum();
 }
 
 /*!
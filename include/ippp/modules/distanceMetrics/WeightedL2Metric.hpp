@@ -29,7 +29,7 @@ namespace ippp {
 * \date    2017-01-02
 */
 template <unsigned int dim>
-class WeightedL2Metric : public DistanceMetric<dim> {
+class WeightedL2Metric final : public DistanceMetric<dim> {
   public:
     WeightedL2Metric();
     WeightedL2Metric(const Vector<dim> &weightVec);
@@ -51,6 +51,7 @@ class WeightedL2Metric : public DistanceMetric<dim> {
 */
 template <unsigned int dim>
 WeightedL2Metric<dim>::WeightedL2Metric() : DistanceMetric<dim>("weightVecL2 metric") {
+    m_weightVec = Vector<dim>::Ones();
 }
 
 /*!
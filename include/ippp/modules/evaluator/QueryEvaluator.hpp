@@ -29,13 +29,14 @@ namespace ippp {
 
 /*!
 * \brief   Evaluator interface.
+* \details With a final Metric type (e.g. L2Metric<dim>) the distance computations of the evaluation are inlined.
 * \author  Sascha Kaden
 * \date    2017-09-30
 */
-template <unsigned int dim>
+template <unsigned int dim, class Metric = DistanceMetric<dim>>
 class QueryEvaluator : public Evaluator<dim> {
   public:
-    QueryEvaluator(const std::shared_ptr<DistanceMetric<dim>> &metric, const std::shared_ptr<Graph<dim>> &graph,
+    QueryEvaluator(const std::shared_ptr<Metric> &metric, const std::shared_ptr<Graph<dim>> &graph,
                    const double dist = 10);
 
     bool evaluate();
@@ -43,7 +44,7 @@ class QueryEvaluator : public Evaluator<dim> {
 
   protected:
     std::shared_ptr<Graph<dim>> m_graph = nullptr;
-    std::shared_ptr<DistanceMetric<dim>> m_metric = nullptr;
+    std::shared_ptr<Metric> m_metric = nullptr;
 
     double m_dist = 1;
     double m_simplifiedDist;
@@ -62,8 +63,8 @@ class QueryEvaluator : public Evaluator<dim> {
 *  \param[in]  maximum distance
 *  \date       2017-09-30
 */
-template <unsigned int dim>
-QueryEvaluator<dim>::QueryEvaluator(const std::shared_ptr<DistanceMetric<dim>> &metric, const std::shared_ptr<Graph<dim>> &graph,
+template <unsigned int dim, class Metric>
+QueryEvaluator<dim, Metric>::QueryEvaluator(const std::shared_ptr<Metric> &metric, const std::shared_ptr<Graph<dim>> &graph,
                                     const double dist)
     : Evaluator<dim>("QueryEvaluator"), m_graph(graph), m_metric(metric), m_dist(dist), m_simplifiedDist(dist) {
     m_metric->simplifyDist(m_simplifiedDist);
@@ -75,8 +76,8 @@ QueryEvaluator<dim>::QueryEvaluator(const std::shared_ptr<DistanceMetric<dim>> &
 *  \param[out] Evaluation result
 *  \date       2017-09-30
 */
-template <unsigned int dim>
-bool QueryEvaluator<dim>::evaluate() {
+template <unsigned int dim, class Metric>
+bool QueryEvaluator<dim, Metric>::evaluate() {
     for (size_t targetIndex = 0; targetIndex < m_targets.size(); ++targetIndex) {
         if (m_validTargets[targetIndex])
             continue;
@@ -106,8 +107,8 @@ bool QueryEvaluator<dim>::evaluate() {
 *  \param[in]  target Nodes
 *  \date       2017-09-30
 */
-template <unsigned int dim>
-void QueryEvaluator<dim>::setQuery(const std::vector<Vector<dim>> &targets) {
+template <unsigned int dim, class Metric>
+void QueryEvaluator<dim, Metric>::setQuery(const std::vector<Vector<dim>> &targets) {
     if (targets.empty())
         return;
 
@@ -27,15 +27,16 @@ namespace ippp {
 
 /*!
 * \brief   Class BruteForceNF for a brute force search
-* \details The brute force approach goes through all nodes and returns the matches of the search.
+* \details The brute force approach goes through all nodes and returns the matches of the search. With a final Metric
+* type (e.g. L2Metric<dim>) the distance computations are inlined, the default DistanceMetric<dim> uses the virtual calls.
 * \author  Sascha Kaden
 * \date    2017-05-16
 */
-template <unsigned int dim, class T>
+template <unsigned int dim, class T, class Metric = DistanceMetric<dim>>
 class BruteForceNF : public NeighborFinder<dim, T> {
   public:
-    BruteForceNF(const std::shared_ptr<DistanceMetric<dim>> &distanceMetric);
-    BruteForceNF(const std::shared_ptr<DistanceMetric<dim>> &distanceMetric, std::vector<T> &nodes);
+    BruteForceNF(const std::shared_ptr<Metric> &distanceMetric);
+    BruteForceNF(const std::shared_ptr<Metric> &distanceMetric, std::vector<T> &nodes);
     ~BruteForceNF();
 
     void addNode(const Vector<dim> &config, const T &node);
@@ -43,30 +44,34 @@ class BruteForceNF : public NeighborFinder<dim, T> {
 
     T searchNearestNeighbor(const Vector<dim> &config);
     std::vector<T> searchRange(const Vector<dim> &config, double range);
+    std::vector<T> searchKNearest(const Vector<dim> &config, size_t k);
 
   private:
+    std::shared_ptr<Metric> m_typedMetric;
     std::vector<std::pair<const Vector<dim>, T>> m_nodes;
 };
 
 /*!
 *  \brief      Default constructor of the class BruteForceNF
 *  \author     Sascha Kaden
+*  \param[in]  DistanceMetric
 * \date        2017-05-16
 */
-template <unsigned int dim, class T>
-BruteForceNF<dim, T>::BruteForceNF(const std::shared_ptr<DistanceMetric<dim>> &distanceMetric)
-    : NeighborFinder<dim, T>("BruteForceNF", distanceMetric) {
+template <unsigned int dim, class T, class Metric>
+BruteForceNF<dim, T, Metric>::BruteForceNF(const std::shared_ptr<Metric> &distanceMetric)
+    : NeighborFinder<dim, T>("BruteForceNF", distanceMetric), m_typedMetric(distanceMetric) {
 }
 
 /*!
 *  \brief      Constructor of the class BruteForceNF, builds a list with all nodes.
 *  \author     Sascha Kaden
+*  \param[in]  DistanceMetric
 *  \param[in]  vector of nodes
 * \date        2017-05-16
 */
-template <unsigned int dim, class T>
-BruteForceNF<dim, T>::BruteForceNF(const std::shared_ptr<DistanceMetric<dim>> &distanceMetric, std::vector<T> &nodes)
-    : NeighborFinder<dim, T>("BruteForceNF", distanceMetric) {
+template <unsigned int dim, class T, class Metric>
+BruteForceNF<dim, T, Metric>::BruteForceNF(const std::shared_ptr<Metric> &distanceMetric, std::vector<T> &nodes)
+    : NeighborFinder<dim, T>("BruteForceNF", distanceMetric), m_typedMetric(distanceMetric) {
     for (auto &node : nodes)
         m_nodes.push_back(std::make_pair(node->getValues(), node));
 }
@@ -76,8 +81,8 @@ BruteForceNF<dim, T>::BruteForceNF(const std::shared_ptr<DistanceMetric<dim>> &d
 *  \author     Sascha Kaden
 * \date        2017-05-16
 */
-template <unsigned int dim, class T>
-BruteForceNF<dim, T>::~BruteForceNF() {
+template <unsigned int dim, class T, class Metric>
+BruteForceNF<dim, T, Metric>::~BruteForceNF() {
     m_nodes.clear();
 }
 
@@ -86,8 +91,8 @@ BruteForceNF<dim, T>::~BruteForceNF() {
 *  \author     Sascha Kaden
 * \date        2017-05-16
 */
-template <unsigned int dim, class T>
-void BruteForceNF<dim, T>::rebaseSorted(std::vector<T> &nodes) {
+template <unsigned int dim, class T, class Metric>
+void BruteForceNF<dim, T, Metric>::rebaseSorted(std::vector<T> &nodes) {
     if (m_nodes.size() != nodes.size()) {
         m_nodes.clear();
         for (auto &node : nodes)
@@ -102,8 +107,8 @@ void BruteForceNF<dim, T>::rebaseSorted(std::vector<T> &nodes) {
 *  \param[in]  pointer to the Node
 * \date        2017-05-16
 */
-template <unsigned int dim, class T>
-void BruteForceNF<dim, T>::addNode(const Vector<dim> &config, const T &node) {
+template <unsigned int dim, class T, class Metric>
+void BruteForceNF<dim, T, Metric>::addNode(const Vector<dim> &config, const T &node) {
     m_nodes.push_back(std::make_pair(node->getValues(), node));
 }
 
@@ -114,13 +119,14 @@ void BruteForceNF<dim, T>::addNode(const Vector<dim> &config, const T &node) {
 *  \param[out] pointer to the nearest Node
 * \date        2017-05-16
 */
-template <unsigned int dim, class T>
-T BruteForceNF<dim, T>::searchNearestNeighbor(const Vector<dim> &config) {
+template <unsigned int dim, class T, class Metric>
+T BruteForceNF<dim, T, Metric>::searchNearestNeighbor(const Vector<dim> &config) {
     double minDist = std::numeric_limits<double>::max();
     T nodePtr = nullptr;
     for (auto &node : m_nodes) {
-        if (this->m_metric->calcSimpleDist(config, node.first) < minDist && !config.isApprox(node.first, EPSILON)) {
-            minDist = this->m_metric->calcSimpleDist(config, node.first);
+        double dist = m_typedMetric->calcSimpleDist(config, node.first);
+        if (dist < minDist && config != node.first) {
+            minDist = dist;
             nodePtr = node.second;
         }
     }
@@ -135,18 +141,40 @@ T BruteForceNF<dim, T>::searchNearestNeighbor(const Vector<dim> &config) {
 *  \param[out] list of near nodes to the position
 * \date        2017-05-16
 */
-template <unsigned int dim, class T>
-std::vector<T> BruteForceNF<dim, T>::searchRange(const Vector<dim> &config, double range) {
+template <unsigned int dim, class T, class Metric>
+std::vector<T> BruteForceNF<dim, T, Metric>::searchRange(const Vector<dim> &config, double range) {
     std::vector<T> nodePtrs;
-    this->m_metric->simplifyDist(range);
+    m_typedMetric->simplifyDist(range);
 
     for (auto &node : m_nodes)
-        if (this->m_metric->calcSimpleDist(config, node.first) < range && !config.isApprox(node.first, EPSILON))
+        if (m_typedMetric->calcSimpleDist(config, node.first) < range && config != node.first)
             nodePtrs.push_back(node.second);
     
     return nodePtrs;
 }
 
+/*!
+*  \brief      Search for the k nearest neighbors, the search is always exact.
+*  \author     Sascha Kaden
+*  \param[in]  position
+*  \param[in]  number of neighbors k
+*  \param[out] list of the k nearest nodes to the position, sorted by ascending distance
+*  \date       2017-11-22
+*/
+template <unsigned int dim, class T, class Metric>
+std::vector<T> BruteForceNF<dim, T, Metric>::searchKNearest(const Vector<dim> &config, size_t k) {
+    std::vector<std::pair<double, T>> heap;
+    if (k == 0)
+        return std::vector<T>();
+
+    heap.reserve(k);
+    for (auto &node : m_nodes)
+        if (config != node.first)
+            this->pushKNearest(heap, k, m_typedMetric->calcSimpleDist(config, node.first), node.second);
+
+    return this->sortKNearest(heap);
+}
+
 } /* namespace ippp */
 
 #endif /* BRUTEFORCENF_HPP */
@@ -0,0 +1,419 @@
+//-------------------------------------------------------------------------//
+//
+// Copyright 2017 Sascha Kaden
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-------------------------------------------------------------------------//
+
+
+#ifndef CONCURRENTKDTREE_HPP
+#define CONCURRENTKDTREE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+#include <ippp/dataObj/ConcurrentKDNode.hpp>
+#include <ippp/modules/neighborFinders/NeighborFinder.hpp>
+
+namespace ippp {
+
+/*!
+* \brief   Class ConcurrentKDTree is a KD tree for multiple writer and reader threads without locks.
+* \details A new node is published by a compare and swap of the empty child pointer of its leaf, if another thread was
+* faster the insertion continues at the winning node. Published nodes are never changed or removed until the destruction
+* of the tree, so the searches can run at the same time without blocking. The tree is not rebalanced, rebaseSorted
+* builds a balanced tree only if the tree is empty (bulk loading) and clears the tree with an empty node list.
+* The Metric parameter sets the static type of the DistanceMetric, with a final metric (e.g. L2Metric<dim>) the distance
+* computations are inlined, the default DistanceMetric<dim> uses the virtual calls.
+* \author  Sascha Kaden
+* \date    2017-11-23
+*/
+template <unsigned int dim, class T, class Metric = DistanceMetric<dim>>
+class ConcurrentKDTree : public NeighborFinder<dim, T> {
+  public:
+    ConcurrentKDTree(const std::shared_ptr<Metric> &distanceMetric);
+    ConcurrentKDTree(const std::shared_ptr<Metric> &distanceMetric, std::vector<T> &nodes);
+    ~ConcurrentKDTree();
+
+    void addNode(const Vector<dim> &config, const T &node);
+    void rebaseSorted(std::vector<T> &nodes);
+    bool isConcurrent() const;
+
+    T searchNearestNeighbor(const Vector<dim> &config);
+    std::vector<T> searchRange(const Vector<dim> &config, double range);
+    std::vector<T> searchKNearest(const Vector<dim> &config, size_t k);
+
+    size_t size() const;
+
+  private:
+    ConcurrentKDNode<dim, T> *build(std::vector<T> &nodes, size_t begin, size_t end, unsigned int axis);
+    void removeNodes(ConcurrentKDNode<dim, T> *root);
+    void NNS(const Vector<dim> &config, const ConcurrentKDNode<dim, T> *node, const ConcurrentKDNode<dim, T> *&refNode,
+             double &bestDist, const double factor) const;
+    void KNNS(const Vector<dim> &config, const ConcurrentKDNode<dim, T> *node, std::vector<std::pair<double, T>> &heap,
+              const size_t k, const double factor) const;
+    void RS(const Vector<dim> &config, const ConcurrentKDNode<dim, T> *node, std::vector<T> &refNodes,
+            const double simplifiedRange) const;
+    double planeDist(const Vector<dim> &config, const ConcurrentKDNode<dim, T> *node) const;
+
+    std::atomic<ConcurrentKDNode<dim, T> *> m_root;
+    std::atomic<size_t> m_size;
+    // metric with its static type, the calls of a final metric are resolved at compile time
+    std::shared_ptr<Metric> m_typedMetric;
+};
+
+/*!
+*  \brief      Default constructor of the class ConcurrentKDTree
+*  \author     Sascha Kaden
+*  \param[in]  DistanceMetric
+*  \date       2017-11-23
+*/
+template <unsigned int dim, class T, class Metric>
+ConcurrentKDTree<dim, T, Metric>::ConcurrentKDTree(const std::shared_ptr<Metric> &distanceMetric)
+    : NeighborFinder<dim, T>("Concurrent KD Tree", distanceMetric), m_root(nullptr), m_size(0),
+      m_typedMetric(distanceMetric) {
+}
+
+/*!
+*  \brief      Constructor of the class ConcurrentKDTree, builds a balanced tree with the passed nodes
+*  \author     Sascha Kaden
+*  \param[in]  DistanceMetric
+*  \param[in]  vector of nodes
+*  \date       2017-11-23
+*/
+template <unsigned int dim, class T, class Metric>
+ConcurrentKDTree<dim, T, Metric>::ConcurrentKDTree(const std::shared_ptr<Metric> &distanceMetric, std::vector<T> &nodes)
+    : NeighborFinder<dim, T>("Concurrent KD Tree", distanceMetric), m_root(nullptr), m_size(0),
+      m_typedMetric(distanceMetric) {
+    rebaseSorted(nodes);
+}
+
+/*!
+*  \brief      Destructor of the class ConcurrentKDTree, deletes all nodes of the tree
+*  \details    No other thread is allowed to use the tree at the destruction.
+*  \author     Sascha Kaden
+*  \date       2017-11-23
+*/
+template <unsigned int dim, class T, class Metric>
+ConcurrentKDTree<dim, T, Metric>::~ConcurrentKDTree() {
+    removeNodes(m_root.load());
+}
+
+/*!
+*  \brief      Add Node to the ConcurrentKDTree, can be called by multiple threads at the same time
+*  \author     Sascha Kaden
+*  \param[in]  position
+*  \param[in]  pointer to the Node
+*  \date       2017-11-23
+*/
+template <unsigned int dim, class T, class Metric>
+void ConcurrentKDTree<dim, T, Metric>::addNode(const Vector<dim> &config, const T &node) {
+    // the axis of the new node depends on the depth, it is set before each publication attempt
+    auto newNode = new ConcurrentKDNode<dim, T>(config, node, 0);
+    ++m_size;
+
+    ConcurrentKDNode<dim, T> *expected = nullptr;
+    if (m_root.compare_exchange_strong(expected, newNode, std::memory_order_acq_rel, std::memory_order_acquire))
+        return;
+
+    ConcurrentKDNode<dim, T> *leaf = expected;
+    while (true) {
+        std::atomic<ConcurrentKDNode<dim, T> *> &child = config[leaf->axis] < leaf->value ? leaf->left : leaf->right;
+        ConcurrentKDNode<dim, T> *next = child.load(std::memory_order_acquire);
+        if (next == nullptr) {
+            newNode->axis = (leaf->axis + 1) % dim;
+            newNode->value = config[newNode->axis];
+            if (child.compare_exchange_strong(next, newNode, std::memory_order_acq_rel, std::memory_order_acquire))
+                return;
+        }
+        // child is set (by another thread), continue at it
+        leaf = next;
+    }
+}
+
+/*!
+*  \brief      Build a balanced tree from the passed nodes, if the tree is empty. An empty node list clears the tree.
+*  \details    Published nodes can't be moved while other threads search inside of the tree, if the tree and the node
+*  list contain nodes the function does nothing. The clearing deletes the published nodes, no other thread is allowed to
+*  use the tree at the same time (e.g. the Graph is replaced by a new one).
+*  \author     Sascha Kaden
+*  \param[in]  vector of nodes
+*  \date       2017-11-23
+*/
+template <unsigned int dim, class T, class Metric>
+void ConcurrentKDTree<dim, T, Metric>::rebaseSorted(std::vector<T> &nodes) {
+    if (nodes.empty()) {
+        m_size = 0;
+        removeNodes(m_root.exchange(nullptr, std::memory_order_acq_rel));
+        return;
+    }
+    if (m_root.load(std::memory_order_acquire) != nullptr)
+        return;
+
+    std::vector<T> buildNodes(nodes);
+    ConcurrentKDNode<dim, T> *root = build(buildNodes, 0, buildNodes.size(), 0);
+    ConcurrentKDNode<dim, T> *expected = nullptr;
+    if (m_root.compare_exchange_strong(expected, root, std::memory_order_acq_rel)) {
+        m_size += buildNodes.size();
+        return;
+    }
+
+    // another thread inserted in the meantime, add the nodes one by one
+    std::vector<ConcurrentKDNode<dim, T> *> stack(1, root);
+    while (!stack.empty()) {
+        auto node = stack.back();
+        stack.pop_back();
+        if (node->left.load())
+            stack.push_back(node->left.load());
+        if (node->right.load())
+            stack.push_back(node->right.load());
+        addNode(node->config, node->node);
+        delete node;
+    }
+}
+
+/*!
+*  \brief      Return true, the tree can be used by multiple threads without locking
+*  \author     Sascha Kaden
+*  \param[out] true
+*  \date       2017-11-23
+*/
+template <unsigned int dim, class T, class Metric>
+bool ConcurrentKDTree<dim, T, Metric>::isConcurrent() const {
+    return true;
+}
+
+/*!
+*  \brief      Build the balanced subtree of the nodes between begin and end (recursive function)
+*  \author     Sascha Kaden
+*  \param[in]  vector of nodes
+*  \param[in]  begin of the range
+*  \param[in]  end of the range
+*  \param[in]  split axis
+*  \param[out] root of the subtree
+*  \date       2017-11-23
+*/
+template <unsigned int dim, class T, class Metric>
+ConcurrentKDNode<dim, T> *ConcurrentKDTree<dim, T, Metric>::build(std::vector<T> &nodes, const size_t begin, const size_t end,
+                                                          const unsigned int axis) {
+    if (begin >= end)
+        return nullptr;
+
+    size_t median = begin + (end - begin) / 2;
+    std::nth_element(nodes.begin() + begin, nodes.begin() + median, nodes.begin() + end,
+                     [axis](const T &a, const T &b) { return a->getValues()[axis] < b->getValues()[axis]; });
+    // nodes with the same value as the median have to be at the right side, like at the insertion
+    double value = nodes[median]->getValues()[axis];
+    auto mid = std::partition(nodes.begin() + begin, nodes.begin() + median,
+                              [axis, value](const T &node) { return node->getValues()[axis] < value; });
+    size_t split = static_cast<size_t>(mid - nodes.begin());
+    std::swap(nodes[split], nodes[median]);
+
+    auto node = new ConcurrentKDNode<dim, T>(nodes[split]->getValues(), nodes[split], axis);
+    node->left.store(build(nodes, begin, split, (axis + 1) % dim), std::memory_order_relaxed);
+    node->right.store(build(nodes, split + 1, end, (axis + 1) % dim), std::memory_order_relaxed);
+    return node;
+}
+
+/*!
+*  \brief      Delete the passed node and all nodes of its subtree
+*  \author     Sascha Kaden
+*  \param[in]  root of the subtree
+*  \date       2017-12-18
+*/
+template <unsigned int dim, class T, class Metric>
+void ConcurrentKDTree<dim, T, Metric>::removeNodes(ConcurrentKDNode<dim, T> *root) {
+    std::vector<ConcurrentKDNode<dim, T> *> stack;
+    if (root)
+        stack.push_back(root);
+    while (!stack.empty()) {
+        auto node = stack.back();
+        stack.pop_back();
+        if (node->left.load())
+            stack.push_back(node->left.load());
+        if (node->right.load())
+            stack.push_back(node->right.load());
+        delete node;
+    }
+}
+
+/*!
+*  \brief      Search for the nearest neighbor, can be called while other threads insert nodes
+*  \author     Sascha Kaden
+*  \param[in]  position
+*  \param[out] pointer to the nearest Node
+*  \date       2017-11-23
+*/
+template <unsigned int dim, class T, class Metric>
+T ConcurrentKDTree<dim, T, Metric>::searchNearestNeighbor(const Vector<dim> &config) {
+    const ConcurrentKDNode<dim, T> *root = m_root.load(std::memory_order_acquire);
+    if (root == nullptr)
+        return nullptr;
+
+    const ConcurrentKDNode<dim, T> *nearest = nullptr;
+    double bestDist = std::numeric_limits<double>::max();
+    NNS(config, root, nearest, bestDist, this->getSimpleApproximationFactor());
+    if (nearest == nullptr)
+        return nullptr;
+    return nearest->node;
+}
+
+/*!
+*  \brief      Search for range around a position, can be called while other threads insert nodes
+*  \author     Sascha Kaden
+*  \param[in]  position
+*  \param[in]  distance of the range
+*  \param[out] list of near nodes to the position
+*  \date       2017-11-23
+*/
+template <unsigned int dim, class T, class Metric>
+std::vector<T> ConcurrentKDTree<dim, T, Metric>::searchRange(const Vector<dim> &config, double range) {
+    std::vector<T> nodes;
+    const ConcurrentKDNode<dim, T> *root = m_root.load(std::memory_order_acquire);
+    if (root == nullptr)
+        return nodes;
+
+    m_typedMetric->simplifyDist(range);
+    RS(config, root, nodes, range);
+    return nodes;
+}
+
+/*!
+*  \brief      Search for the k nearest neighbors, can be called while other threads insert nodes
+*  \author     Sascha Kaden
+*  \param[in]  position
+*  \param[in]  number of neighbors k
+*  \param[out] list of the k nearest nodes to the position, sorted by ascending distance
+*  \date       2017-11-23
+*/
+template <unsigned int dim, class T, class Metric>
+std::vector<T> ConcurrentKDTree<dim, T, Metric>::searchKNearest(const Vector<dim> &config, size_t k) {
+    std::vector<std::pair<double, T>> heap;
+    const ConcurrentKDNode<dim, T> *root = m_root.load(std::memory_order_acquire);
+    if (root == nullptr || k == 0)
+        return std::vector<T>();
+
+    heap.reserve(k);
+    KNNS(config, root, heap, k, this->getSimpleApproximationFactor());
+    return this->sortKNearest(heap);
+}
+
+/*!
+*  \brief      Return the number of nodes inside of the tree
+*  \author     Sascha Kaden
+*  \param[out] size
+*  \date       2017-11-23
+*/
+template <unsigned int dim, class T, class Metric>
+size_t ConcurrentKDTree<dim, T, Metric>::size() const {
+    return m_size.load();
+}
+
+/*!
+*  \brief      Search for the nearest neighbor (recursive function)
+*  \author     Sascha Kaden
+*  \param[in]  position
+*  \param[in]  current node
+*  \param[in]  reference node
+*  \param[in]  shortest distance
+*  \param[in]  simplified approximation factor
+*  \date       2017-11-23
+*/
+template <unsigned int dim, class T, class Metric>
+void ConcurrentKDTree<dim, T, Metric>::NNS(const Vector<dim> &config, const ConcurrentKDNode<dim, T> *node,
+                                   const ConcurrentKDNode<dim, T> *&refNode, double &bestDist, const double factor) const {
+    double dist = m_typedMetric->calcSimpleDist(config, node->config);
+    if (dist < bestDist && config != node->config) {
+        bestDist = dist;
+        refNode = node;
+    }
+
+    bool leftIsNear = config[node->axis] < node->value;
+    const ConcurrentKDNode<dim, T> *near = (leftIsNear ? node->left : node->right).load(std::memory_order_acquire);
+    const ConcurrentKDNode<dim, T> *far = (leftIsNear ? node->right : node->left).load(std::memory_order_acquire);
+    if (near != nullptr)
+        NNS(config, near, refNode, bestDist, factor);
+    if (far != nullptr && planeDist(config, node) * factor < bestDist)
+        NNS(config, far, refNode, bestDist, factor);
+}
+
+/*!
+*  \brief      Search for the k nearest neighbors (recursive function)
+*  \author     Sascha Kaden
+*  \param[in]  position
+*  \param[in]  current node
+*  \param[in]  bounded max heap of the k nearest nodes
+*  \param[in]  number of neighbors k
+*  \param[in]  simplified approximation factor
+*  \date       2017-11-23
+*/
+template <unsigned int dim, class T, class Metric>
+void ConcurrentKDTree<dim, T, Metric>::KNNS(const Vector<dim> &config, const ConcurrentKDNode<dim, T> *node,
+                                    std::vector<std::pair<double, T>> &heap, const size_t k, const double factor) const {
+    if (config != node->config)
+        this->pushKNearest(heap, k, m_typedMetric->calcSimpleDist(config, node->config), node->node);
+
+    bool leftIsNear = config[node->axis] < node->value;
+    const ConcurrentKDNode<dim, T> *near = (leftIsNear ? node->left : node->right).load(std::memory_order_acquire);
+    const ConcurrentKDNode<dim, T> *far = (leftIsNear ? node->right : node->left).load(std::memory_order_acquire);
+    if (near != nullptr)
+        KNNS(config, near, heap, k, factor);
+    if (far != nullptr && (heap.size() < k || planeDist(config, node) * factor < heap.front().first))
+        KNNS(config, far, heap, k, factor);
+}
+
+/*!
+*  \brief      Search range for near nodes (recursive function)
+*  \author     Sascha Kaden
+*  \param[in]  position
+*  \param[in]  current node
+*  \param[in]  list of reference nodes
+*  \param[in]  simplified range distance
+*  \date       2017-11-23
+*/
+template <unsigned int dim, class T, class Metric>
+void ConcurrentKDTree<dim, T, Metric>::RS(const Vector<dim> &config, const ConcurrentKDNode<dim, T> *node, std::vector<T> &refNodes,
+                                  const double simplifiedRange) const {
+    if (m_typedMetric->calcSimpleDist(config, node->config) < simplifiedRange && config != node->config)
+        refNodes.push_back(node->node);
+
+    bool leftIsNear = config[node->axis] < node->value;
+    const ConcurrentKDNode<dim, T> *near = (leftIsNear ? node->left : node->right).load(std::memory_order_acquire);
+    const ConcurrentKDNode<dim, T> *far = (leftIsNear ? node->right : node->left).load(std::memory_order_acquire);
+    if (near != nullptr)
+        RS(config, near, refNodes, simplifiedRange);
+    if (far != nullptr && planeDist(config, node) < simplifiedRange)
+        RS(config, far, refNodes, simplifiedRange);
+}
+
+/*!
+*  \brief      Return the simplified distance from the position to the split plane of the node
+*  \author     Sascha Kaden
+*  \param[in]  position
+*  \param[in]  node
+*  \param[out] simplified distance
+*  \date       2017-11-23
+*/
+template <unsigned int dim, class T, class Metric>
+double ConcurrentKDTree<dim, T, Metric>::planeDist(const Vector<dim> &config, const ConcurrentKDNode<dim, T> *node) const {
+    Vector<dim> projection = config;
+    projection[node->axis] = node->value;
+    return m_typedMetric->calcSimpleDist(config, projection);
+}
+
+} /* namespace ippp */
+
+#endif /* CONCURRENTKDTREE_HPP */
@@ -19,7 +19,16 @@
 #ifndef KDTREE_HPP
 #define KDTREE_HPP
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <Eigen/StdVector>
 
 #include <ippp/dataObj/KDNode.hpp>
 #include <ippp/modules/neighborFinders/NeighborFinder.hpp>
@@ -30,69 +39,112 @@ enum Direction { left, right };
 
 /*!
 * \brief   Class KDTree for a fast binary search
-* \details Class uses KDNode<dim> to save the points
+* \details Class uses KDNode<dim> to save the points. The tree keeps itself balanced like a scapegoat tree, after an
+* insertion which is too deep only the unbalanced subtree is rebuild. The nodes have to be added by one thread at the
+* time, searches can run at the same time: a search loads the root once and holds it, new leafs are published by the
+* atomic link of their parent. A rebuild subtree is build out of fresh KDNodes together with copies of its ancestors
+* and published with one swap of the root, so the version of a running search stays unchanged.
+* With the background rebuild, rebaseSorted and the rebuild of large scapegoat subtrees run by an extra thread, nodes
+* added in the meantime are inserted into the new (sub)tree and it is published when it is finished. The inserting thread
+* then only rebuilds small subtrees by itself.
+* The Metric parameter sets the static type of the DistanceMetric, with a final metric (e.g. L2Metric<dim>) the distance
+* computations of the searches are inlined, the default DistanceMetric<dim> uses the virtual calls.
 * \author  Sascha Kaden
 * \date    2016-05-27
 */
-template <unsigned int dim, class T>
+template <unsigned int dim, class T, class Metric = DistanceMetric<dim>>
 class KDTree : public NeighborFinder<dim, T> {
   public:
-    KDTree(const std::shared_ptr<DistanceMetric<dim>> &distanceMetric);
-    KDTree(const std::shared_ptr<DistanceMetric<dim>> &distanceMetric, std::vector<T> &nodes);
+    KDTree(const std::shared_ptr<Metric> &distanceMetric);
+    KDTree(const std::shared_ptr<Metric> &distanceMetric, std::vector<T> &nodes);
     ~KDTree();
 
     void addNode(const Vector<dim> &config, const T &node);
     void rebaseSorted(std::vector<T> &nodes);
 
     T searchNearestNeighbor(const Vector<dim> &config);
+    std::vector<T> searchNearestNeighbors(const std::vector<Vector<dim>> &configs);
     std::vector<T> searchRange(const Vector<dim> &config, double range);
+    std::vector<T> searchKNearest(const Vector<dim> &config, size_t k);
+
+    void setBackgroundRebuild(const bool backgroundRebuild);
+    bool isRebuilding() const;
+    void waitForRebuild();
+    size_t size() const;
 
   private:
-    std::shared_ptr<KDNode<dim, T>> insert(std::shared_ptr<KDNode<dim, T>> insertNode,
-                                           std::shared_ptr<KDNode<dim, T>> currentNode, unsigned int depth);
+    void insert(std::shared_ptr<KDNode<dim, T>> &root, size_t &size, const std::shared_ptr<KDNode<dim, T>> &kdNode,
+                std::vector<KDNode<dim, T> *> &path);
+    void rebuildSubtree(std::shared_ptr<KDNode<dim, T>> &root, const std::vector<KDNode<dim, T> *> &path,
+                        const size_t scapegoatIndex);
+    void publishSubtree(std::shared_ptr<KDNode<dim, T>> &root, const std::vector<KDNode<dim, T> *> &path, const size_t index,
+                        std::shared_ptr<KDNode<dim, T>> subtree);
+    bool insideRebuild(const std::vector<KDNode<dim, T> *> &path) const;
+    void startRebuild(std::vector<T> nodes, const KDNode<dim, T> *subtree);
+    void backgroundRebuild(std::vector<T> nodes, std::shared_ptr<KDNode<dim, T>> snapshot, const size_t snapshotStamp);
+    std::shared_ptr<KDNode<dim, T>> buildTree(const std::vector<T> &nodes);
+    std::shared_ptr<KDNode<dim, T>> build(std::vector<std::shared_ptr<KDNode<dim, T>>> &kdNodes, size_t begin, size_t end,
+                                          unsigned int axis);
     void removeNodes(std::shared_ptr<KDNode<dim, T>> node);
 
-    void NNS(const Vector<dim> &config, std::shared_ptr<KDNode<dim, T>> node, std::shared_ptr<KDNode<dim, T>> &refNode,
-             double &bestDist);
-    void RS(const Vector<dim> &config, std::shared_ptr<KDNode<dim, T>> node,
-            std::vector<std::shared_ptr<KDNode<dim, T>>> &refNodes, double simplifiedRange, const Vector<dim> &maxBoundary,
-            const Vector<dim> &minBoundary);
-
-    std::shared_ptr<KDNode<dim, T>> sortNodes(std::vector<T> &config, unsigned int cd);
-    void quickSort(std::vector<T> &A, size_t left, size_t right, int dimension);
-    size_t partition(std::vector<T> &A, size_t left, size_t right, int dimension);
-
+    void NNS(const Vector<dim> &config, const KDNode<dim, T> *node, const KDNode<dim, T> *&refNode, double &bestDist,
+             const double factor);
+    void KNNS(const Vector<dim> &config, const KDNode<dim, T> *node, std::vector<std::pair<double, T>> &heap, const size_t k,
+              const double factor);
+    double planeDist(const Vector<dim> &config, const KDNode<dim, T> *node) const;
+    void sortSpatial(const std::vector<Vector<dim>> &configs, std::vector<size_t> &order, size_t begin, size_t end,
+                     unsigned int axis) const;
+    void RS(const Vector<dim> &config, const KDNode<dim, T> *node, std::vector<T> &nodes, const double simplifiedRange);
+
+    // maximal share of a child subtree at the subtree of its parent, before the parent is rebuild (scapegoat tree)
+    static constexpr double m_alpha = 0.7;
+    // with the background rebuild, larger scapegoat subtrees are rebuild by the extra thread (about 1 us per node)
+    static constexpr size_t m_maxSyncRebuildSize = 256;
+    // number of pending nodes, which are inserted by the background rebuild under the lock before the root swap
+    static constexpr size_t m_maxSwapPendingNodes = 64;
+
+    // metric with its static type, the calls of a final metric are resolved at compile time
+    std::shared_ptr<Metric> m_typedMetric;
+
+    // the root is read with atomic load, a search holds the KDNodes of its version until it is finished
     std::shared_ptr<KDNode<dim, T>> m_root;
+    size_t m_size = 0;
+    size_t m_stamp = 0;    // insertion counter, the background rebuild skips the nodes inserted after its snapshot
+    std::vector<KDNode<dim, T> *> m_path;
+
+    bool m_backgroundRebuild = false;
+    std::atomic<bool> m_rebuilding;
+    std::thread m_rebuildThread;
+    mutable std::mutex m_mutex;
+    std::vector<std::pair<Vector<dim>, T>, Eigen::aligned_allocator<std::pair<Vector<dim>, T>>> m_pendingNodes;
+    // subtree of the background rebuild (nullptr for the complete tree) and its position by the directions from the root
+    // (true for left), the subtree keeps its position while it is rebuild
+    const KDNode<dim, T> *m_rebuildSubtree = nullptr;
+    std::vector<bool> m_rebuildDirections;
 };
 
 /*!
 *  \brief      Default constructor of the class KDTree
 *  \author     Sascha Kaden
+*  \param[in]  DistanceMetric
 *  \date       2016-06-02
 */
-template <unsigned int dim, class T>
-KDTree<dim, T>::KDTree(const std::shared_ptr<DistanceMetric<dim>> &distanceMetric)
-    : NeighborFinder<dim, T>("KD Tree", distanceMetric) {
+template <unsigned int dim, class T, class Metric>
+KDTree<dim, T, Metric>::KDTree(const std::shared_ptr<Metric> &distanceMetric)
+    : NeighborFinder<dim, T>("KD Tree", distanceMetric), m_typedMetric(distanceMetric), m_rebuilding(false) {
 }
 
 /*!
 *  \brief      Constructor of the class KDTree, builds a sorted tree with the passed nodes
 *  \author     Sascha Kaden
+*  \param[in]  DistanceMetric
 *  \param[in]  vector of nodes
 *  \date       2016-07-18
 */
-template <unsigned int dim, class T>
-KDTree<dim, T>::KDTree(const std::shared_ptr<DistanceMetric<dim>> &distanceMetric, std::vector<T> &nodes)
-    : NeighborFinder<dim, T>("KD Tree", distanceMetric) {
-    quickSort(nodes, 0, nodes.size() - 1, 0);
-    m_root = std::make_shared<KDNode<dim, T>>(nodes[nodes.size() / 2]->getValues(), nodes[nodes.size() / 2]);
-    m_root->axis = 0;
-    m_root->value = m_root->config[0];
-
-    std::vector<T> vecLeft(nodes.begin(), nodes.begin() + (nodes.size() / 2) - 1);
-    std::vector<T> vecRight(nodes.begin() + (nodes.size() / 2) + 1, nodes.end());
-    m_root->left = sortNodes(vecLeft, 1);
-    m_root->right = sortNodes(vecRight, 1);
+template <unsigned int dim, class T, class Metric>
+KDTree<dim, T, Metric>::KDTree(const std::shared_ptr<Metric> &distanceMetric, std::vector<T> &nodes)
+    : NeighborFinder<dim, T>("KD Tree", distanceMetric), m_typedMetric(distanceMetric), m_rebuilding(false) {
+    rebaseSorted(nodes);
 }
 
 /*!
@@ -100,8 +152,9 @@ KDTree<dim, T>::KDTree(const std::shared_ptr<DistanceMetric<dim>> &distanceMetri
 *  \author     Sascha Kaden
 *  \date       2017-01-07
 */
-template <unsigned int dim, class T>
-KDTree<dim, T>::~KDTree() {
+template <unsigned int dim, class T, class Metric>
+KDTree<dim, T, Metric>::~KDTree() {
+    waitForRebuild();
     if (m_root != nullptr) {
         removeNodes(m_root);
         m_root = nullptr;
@@ -110,27 +163,33 @@ KDTree<dim, T>::~KDTree() {
 
 /*!
 *  \brief      Rebase the tree sorted.
+*  \details    The tree keeps itself balanced at the insertion, if it contains already all passed nodes nothing has to
+*  be done. Otherwise a balanced tree is build from the nodes, with background rebuild it is build by an extra thread
+*  and swapped afterwards. A running background rebuild is finished before, the passed nodes replace its result. An
+*  empty list clears the tree directly. The function must not be called at the same time as addNode.
 *  \author     Sascha Kaden
+*  \param[in]  vector of nodes
 *  \date       2017-05-09
 */
-template <unsigned int dim, class T>
-void KDTree<dim, T>::rebaseSorted(std::vector<T> &nodes) {
-    std::shared_ptr<KDNode<dim, T>> root;
-    quickSort(nodes, 0, nodes.size() - 1, 0);
-    root = std::make_shared<KDNode<dim, T>>(nodes[nodes.size() / 2]->getValues(), nodes[nodes.size() / 2]);
-    root->axis = 0;
-    root->value = m_root->config[0];
-
-    std::vector<T> vecLeft(nodes.begin(), nodes.begin() + (nodes.size() / 2) - 1);
-    std::vector<T> vecRight(nodes.begin() + (nodes.size() / 2) + 1, nodes.end());
-    root->left = sortNodes(vecLeft, 1);
-    root->right = sortNodes(vecRight, 1);
-
-    // change roots
-    auto oldRoot = m_root;
-    m_root = root;
-    removeNodes(oldRoot);
-    oldRoot = nullptr;
+template <unsigned int dim, class T, class Metric>
+void KDTree<dim, T, Metric>::rebaseSorted(std::vector<T> &nodes) {
+    waitForRebuild();
+    if (size() == nodes.size())
+        return;
+
+    if (m_backgroundRebuild && !nodes.empty()) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        startRebuild(nodes, nullptr);
+        return;
+    }
+
+    auto root = buildTree(nodes);
+    m_mutex.lock();
+    root = std::atomic_exchange(&m_root, root);
+    m_size = nodes.size();
+    m_mutex.unlock();
+    // the old tree is released outside of the lock
+    root = nullptr;
 }
 
 /*!
@@ -140,72 +199,352 @@ void KDTree<dim, T>::rebaseSorted(std::vector<T> &nodes) {
 *  \param[in]  pointer to the Node
 *  \date       2016-05-27
 */
-template <unsigned int dim, class T>
-void KDTree<dim, T>::addNode(const Vector<dim> &config, const T &node) {
-    auto shrKDNode = std::make_shared<KDNode<dim, T>>(config, node);
-    if (m_root == nullptr) {
-        m_root = shrKDNode;
+template <unsigned int dim, class T, class Metric>
+void KDTree<dim, T, Metric>::addNode(const Vector<dim> &config, const T &node) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto kdNode = std::make_shared<KDNode<dim, T>>(config, node);
+    kdNode->stamp = ++m_stamp;
+    insert(m_root, m_size, kdNode, m_path);
+}
+
+/*!
+*  \brief      Sets the background rebuild, rebaseSorted builds the new tree by an extra thread.
+*  \author     Sascha Kaden
+*  \param[in]  background rebuild
+*  \date       2017-11-24
+*/
+template <unsigned int dim, class T, class Metric>
+void KDTree<dim, T, Metric>::setBackgroundRebuild(const bool backgroundRebuild) {
+    m_backgroundRebuild = backgroundRebuild;
+}
+
+/*!
+*  \brief      Returns true, if a background rebuild is running.
+*  \author     Sascha Kaden
+*  \param[out] running rebuild
+*  \date       2017-11-24
+*/
+template <unsigned int dim, class T, class Metric>
+bool KDTree<dim, T, Metric>::isRebuilding() const {
+    return m_rebuilding;
+}
+
+/*!
+*  \brief      Waits until the background rebuild is finished.
+*  \author     Sascha Kaden
+*  \date       2017-11-24
+*/
+template <unsigned int dim, class T, class Metric>
+void KDTree<dim, T, Metric>::waitForRebuild() {
+    if (m_rebuildThread.joinable())
+        m_rebuildThread.join();
+}
+
+/*!
+*  \brief      Return the number of nodes inside of the tree
+*  \author     Sascha Kaden
+*  \param[out] size
+*  \date       2017-11-24
+*/
+template <unsigned int dim, class T, class Metric>
+size_t KDTree<dim, T, Metric>::size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_size;
+}
+
+/*!
+*  \brief      Insert KDNode<dim> to the tree of the passed root
+*  \details    The sizes of the subtrees on the path are updated. If the new node is deeper than log(n) / log(1 / alpha),
+*  the deepest unbalanced subtree of the path (scapegoat) is rebuild. With the background rebuild, a large scapegoat of
+*  the tree of the KDTree is rebuild by the extra thread, while it runs other large scapegoats and scapegoats inside of
+*  its subtree are skipped. Nodes inserted into the rebuild subtree are added to the pending nodes. The inserting
+*  thread has to be the only one, which changes the passed tree.
+*  \author     Sascha Kaden
+*  \param[in]  root of the tree
+*  \param[in]  size of the tree
+*  \param[in]  KDNode<dim> to insert
+*  \param[in]  buffer of the insertion path
+*  \date       2016-05-27
+*/
+template <unsigned int dim, class T, class Metric>
+void KDTree<dim, T, Metric>::insert(std::shared_ptr<KDNode<dim, T>> &root, size_t &size,
+                                    const std::shared_ptr<KDNode<dim, T>> &kdNode, std::vector<KDNode<dim, T> *> &path) {
+    const bool liveTree = &root == &m_root;
+    ++size;
+    if (root == nullptr) {
+        kdNode->axis = 0;
+        kdNode->value = kdNode->config[0];
+        std::atomic_store(&root, kdNode);
+        if (liveTree && m_rebuilding)
+            m_pendingNodes.push_back(std::make_pair(kdNode->config, kdNode->node));
         return;
     }
-    // insert(shrKDNode, m_root, 0);
-
-    std::shared_ptr<KDNode<dim, T>> leaf = nullptr;
-    auto last = m_root;
-    Direction dir;
-    if (shrKDNode->config[0] < m_root->config[0]) {
-        leaf = m_root->left;
-        dir = left;
-    } else {
-        leaf = m_root->right;
-        dir = right;
-    }
 
-    unsigned int cd = 1;
-    while (leaf != nullptr) {
-        last = leaf;
-        if (shrKDNode->config[cd] < leaf->config[cd]) {
-            leaf = leaf->left;
-            dir = left;
-        } else {
-            leaf = leaf->right;
-            dir = right;
+    path.clear();
+    KDNode<dim, T> *leaf = root.get();
+    while (true) {
+        path.push_back(leaf);
+        ++leaf->size;
+        bool isLeft = kdNode->config[leaf->axis] < leaf->value;
+        KDNode<dim, T> *child = isLeft ? leaf->left.get() : leaf->right.get();
+        if (child == nullptr) {
+            kdNode->axis = (leaf->axis + 1) % dim;
+            kdNode->value = kdNode->config[kdNode->axis];
+            if (isLeft)
+                leaf->setLeft(kdNode);
+            else
+                leaf->setRight(kdNode);
+            break;
         }
-        cd = (cd + 1) % dim;
+        leaf = child;
     }
+    const bool pending = liveTree && m_rebuilding && insideRebuild(path);
+    if (pending)
+        m_pendingNodes.push_back(std::make_pair(kdNode->config, kdNode->node));
 
-    // TODO: add control for mutex, if leaf is no nullptr
-    shrKDNode->axis = cd;
-    shrKDNode->value = shrKDNode->config[cd];
-    if (dir == left)
-        last->left = shrKDNode;
-    else
-        last->right = shrKDNode;
+    // depth of the new node is the path size
+    if (path.size() <= std::log(static_cast<double>(size)) / std::log(1 / m_alpha))
+        return;
+
+    for (size_t i = path.size(); i-- > 0;) {
+        size_t childSize = (i + 1 < path.size()) ? path[i + 1]->size : 1;
+        if (childSize <= m_alpha * path[i]->size)
+            continue;
+
+        // subtrees of a running background rebuild keep their KDNodes, other large ones wait for the next rebuild
+        bool large = path[i]->size > m_maxSyncRebuildSize;
+        if (!liveTree || !m_backgroundRebuild || (!large && !(pending && m_rebuildSubtree != nullptr)))
+            rebuildSubtree(root, path, i);
+        else if (large && !m_rebuilding)
+            startRebuild(std::vector<T>(), path[i]);
+        return;
+    }
 }
 
 /*!
-*  \brief      Insert KDNode<dim> to the KDTree (recursive function)
+*  \brief      Rebuild the subtree of the scapegoat balanced out of fresh KDNodes and publish it with a new root.
 *  \author     Sascha Kaden
-*  \param[in]  KDNode<dim> to insert
-*  \param[in]  current KDNode<dim> in the KDTree
-*  \param[in]  split dimension
-*  \param[out] current KDNode
-*  \date       2016-05-27
+*  \param[in]  root of the tree
+*  \param[in]  insertion path
+*  \param[in]  index of the scapegoat inside of the insertion path
+*  \date       2017-11-24
 */
-template <unsigned int dim, class T>
-std::shared_ptr<KDNode<dim, T>> KDTree<dim, T>::insert(std::shared_ptr<KDNode<dim, T>> insertNode,
-                                                       std::shared_ptr<KDNode<dim, T>> currentNode, unsigned int cd) {
-    if (currentNode == nullptr) {    // Node<dim> at leaf doesn't exist and will be added
-        currentNode = insertNode;
-        currentNode->axis = cd;
-        currentNode->value = currentNode->config[cd];
-    } else if (insertNode == currentNode) {    // error! duplicate
-        return currentNode;
-    } else if (insertNode->config[cd] < currentNode->config[cd]) {
-        currentNode->left = insert(insertNode, currentNode->left, (cd + 1) % dim);
+template <unsigned int dim, class T, class Metric>
+void KDTree<dim, T, Metric>::rebuildSubtree(std::shared_ptr<KDNode<dim, T>> &root, const std::vector<KDNode<dim, T> *> &path,
+                                            const size_t scapegoatIndex) {
+    const KDNode<dim, T> *scapegoat = path[scapegoatIndex];
+
+    // only the inserting thread changes the owning pointer, it can read them without synchronization
+    std::vector<const KDNode<dim, T> *> stack(1, scapegoat);
+    std::vector<std::shared_ptr<KDNode<dim, T>>> kdNodes;
+    kdNodes.reserve(scapegoat->size);
+    while (!stack.empty()) {
+        const KDNode<dim, T> *kdNode = stack.back();
+        stack.pop_back();
+        kdNodes.push_back(std::make_shared<KDNode<dim, T>>(kdNode->config, kdNode->node));
+        kdNodes.back()->stamp = kdNode->stamp;
+        if (kdNode->left != nullptr)
+            stack.push_back(kdNode->left.get());
+        if (kdNode->right != nullptr)
+            stack.push_back(kdNode->right.get());
+    }
+    publishSubtree(root, path, scapegoatIndex, build(kdNodes, 0, kdNodes.size(), scapegoat->axis));
+}
+
+/*!
+*  \brief      Replace the subtree at the passed index of the path and publish it with a new root.
+*  \details    The ancestors of the subtree are copied, the KDNodes of the old version stay unchanged for the searches
+*  which still run through them and are released with their last reference.
+*  \author     Sascha Kaden
+*  \param[in]  root of the tree
+*  \param[in]  path from the root to the replaced subtree
+*  \param[in]  index of the replaced subtree inside of the path
+*  \param[in]  new subtree
+*  \date       2017-12-18
+*/
+template <unsigned int dim, class T, class Metric>
+void KDTree<dim, T, Metric>::publishSubtree(std::shared_ptr<KDNode<dim, T>> &root, const std::vector<KDNode<dim, T> *> &path,
+                                            const size_t index, std::shared_ptr<KDNode<dim, T>> subtree) {
+    for (size_t i = index; i-- > 0;) {
+        const KDNode<dim, T> *ancestor = path[i];
+        auto copy = std::make_shared<KDNode<dim, T>>(ancestor->config, ancestor->node);
+        copy->axis = ancestor->axis;
+        copy->value = ancestor->value;
+        copy->size = ancestor->size;
+        copy->stamp = ancestor->stamp;
+        bool isLeft = ancestor->left.get() == path[i + 1];
+        copy->setLeft(isLeft ? subtree : ancestor->left);
+        copy->setRight(isLeft ? ancestor->right : subtree);
+        subtree = copy;
+    }
+    // the old version is released by the swap, if no search holds it anymore
+    std::atomic_store(&root, subtree);
+}
+
+/*!
+*  \brief      Return true, if the insertion path runs through the subtree of the running background rebuild
+*  \author     Sascha Kaden
+*  \param[in]  insertion path
+*  \param[out] true, if the new node is inside of the rebuild subtree
+*  \date       2017-12-18
+*/
+template <unsigned int dim, class T, class Metric>
+bool KDTree<dim, T, Metric>::insideRebuild(const std::vector<KDNode<dim, T> *> &path) const {
+    if (m_rebuildSubtree == nullptr)
+        return true;
+    size_t depth = m_rebuildDirections.size();
+    return path.size() > depth && path[depth] == m_rebuildSubtree;
+}
+
+/*!
+*  \brief      Start the background rebuild, the mutex has to be locked.
+*  \details    The complete tree is build from the passed nodes, a subtree is build from its current nodes. The subtree
+*  has to be inside of the last insertion path.
+*  \author     Sascha Kaden
+*  \param[in]  vector of nodes
+*  \param[in]  root of the rebuild subtree, nullptr for the complete tree
+*  \date       2017-12-18
+*/
+template <unsigned int dim, class T, class Metric>
+void KDTree<dim, T, Metric>::startRebuild(std::vector<T> nodes, const KDNode<dim, T> *subtree) {
+    // the last rebuild has published its tree already, only the release of the old KDNodes can be left
+    if (m_rebuildThread.joinable())
+        m_rebuildThread.join();
+
+    m_rebuildSubtree = subtree;
+    m_rebuildDirections.clear();
+    for (size_t i = 0; subtree != nullptr && m_path[i] != subtree; ++i)
+        m_rebuildDirections.push_back(m_path[i]->left.get() == m_path[i + 1]);
+    m_rebuilding = true;
+    m_pendingNodes.clear();
+    m_rebuildThread = std::thread(&KDTree<dim, T, Metric>::backgroundRebuild, this, std::move(nodes), m_root, m_stamp);
+}
+
+/*!
+*  \brief      Build the tree or subtree, add the nodes which were inserted meanwhile and publish it.
+*  \details    The nodes of the subtree are read through the atomic links, the nodes inserted after the snapshot are
+*  skipped by their stamp, they are inside of the pending nodes. The pending nodes are inserted without the lock, until
+*  only a few are left for the publication. A subtree is found again by its directions, it is published with copies
+*  of its ancestors.
+*  \author     Sascha Kaden
+*  \param[in]  copy of the nodes
+*  \param[in]  root of the tree at the start, holds the KDNodes of the subtree
+*  \param[in]  stamp of the last node of the snapshot
+*  \date       2017-11-24
+*/
+template <unsigned int dim, class T, class Metric>
+void KDTree<dim, T, Metric>::backgroundRebuild(std::vector<T> nodes, std::shared_ptr<KDNode<dim, T>> snapshot,
+                                               const size_t snapshotStamp) {
+    // the subtree and its directions are only changed, when no rebuild is running
+    const KDNode<dim, T> *subtree = m_rebuildSubtree;
+    std::shared_ptr<KDNode<dim, T>> root;
+    size_t size = 0;
+    if (subtree == nullptr) {
+        root = buildTree(nodes);
+        size = nodes.size();
     } else {
-        currentNode->right = insert(insertNode, currentNode->right, (cd + 1) % dim);
+        std::vector<std::shared_ptr<KDNode<dim, T>>> kdNodes;
+        std::vector<const KDNode<dim, T> *> stack(1, subtree);
+        while (!stack.empty()) {
+            const KDNode<dim, T> *kdNode = stack.back();
+            stack.pop_back();
+            if (kdNode->stamp <= snapshotStamp) {
+                kdNodes.push_back(std::make_shared<KDNode<dim, T>>(kdNode->config, kdNode->node));
+                kdNodes.back()->stamp = kdNode->stamp;
+            }
+            if (const KDNode<dim, T> *left = kdNode->leftLink.load(std::memory_order_acquire))
+                stack.push_back(left);
+            if (const KDNode<dim, T> *right = kdNode->rightLink.load(std::memory_order_acquire))
+                stack.push_back(right);
+        }
+        size = kdNodes.size();
+        root = build(kdNodes, 0, kdNodes.size(), subtree->axis);
+    }
+
+    std::vector<KDNode<dim, T> *> path;
+    std::vector<std::pair<Vector<dim>, T>, Eigen::aligned_allocator<std::pair<Vector<dim>, T>>> pendingNodes;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (m_pendingNodes.size() > m_maxSwapPendingNodes) {
+        pendingNodes.swap(m_pendingNodes);
+        lock.unlock();
+        for (auto &pendingNode : pendingNodes)
+            insert(root, size, std::make_shared<KDNode<dim, T>>(pendingNode.first, pendingNode.second), path);
+        pendingNodes.clear();
+        lock.lock();
+    }
+    for (auto &pendingNode : m_pendingNodes)
+        insert(root, size, std::make_shared<KDNode<dim, T>>(pendingNode.first, pendingNode.second), path);
+    m_pendingNodes.clear();
+
+    if (subtree == nullptr) {
+        root = std::atomic_exchange(&m_root, root);
+        m_size = size;
+    } else {
+        path.clear();
+        KDNode<dim, T> *kdNode = m_root.get();
+        for (bool left : m_rebuildDirections) {
+            path.push_back(kdNode);
+            kdNode = left ? kdNode->left.get() : kdNode->right.get();
+        }
+        path.push_back(kdNode);
+        if (kdNode == subtree)
+            publishSubtree(m_root, path, path.size() - 1, root);
+        root = nullptr;
     }
-    return currentNode;
+    m_rebuildSubtree = nullptr;
+    m_rebuilding = false;
+    lock.unlock();
+    // the old KDNodes are released outside of the lock, searches which still use them hold their own reference
+    root = nullptr;
+    snapshot = nullptr;
+}
+
+/*!
+*  \brief      Build a balanced tree from the passed nodes
+*  \author     Sascha Kaden
+*  \param[in]  vector of nodes
+*  \param[out] root of the tree
+*  \date       2017-11-24
+*/
+template <unsigned int dim, class T, class Metric>
+std::shared_ptr<KDNode<dim, T>> KDTree<dim, T, Metric>::buildTree(const std::vector<T> &nodes) {
+    std::vector<std::shared_ptr<KDNode<dim, T>>> kdNodes;
+    kdNodes.reserve(nodes.size());
+    for (auto &node : nodes)
+        kdNodes.push_back(std::make_shared<KDNode<dim, T>>(node->getValues(), node));
+    return build(kdNodes, 0, kdNodes.size(), 0);
+}
+
+/*!
+*  \brief      Build the balanced subtree from the KDNodes between begin and end (recursive function)
+*  \details    The median is found by nth_element, the vector is partitioned in place.
+*  \author     Sascha Kaden
+*  \param[in]  vector of KDNodes
+*  \param[in]  begin of the range
+*  \param[in]  end of the range
+*  \param[in]  split axis
+*  \param[out] root of the subtree
+*  \date       2017-11-24
+*/
+template <unsigned int dim, class T, class Metric>
+std::shared_ptr<KDNode<dim, T>> KDTree<dim, T, Metric>::build(std::vector<std::shared_ptr<KDNode<dim, T>>> &kdNodes, const size_t begin,
+                                                      const size_t end, const unsigned int axis) {
+    if (begin >= end)
+        return nullptr;
+
+    size_t median = begin + (end - begin) / 2;
+    std::nth_element(kdNodes.begin() + begin, kdNodes.begin() + median, kdNodes.begin() + end,
+                     [axis](const std::shared_ptr<KDNode<dim, T>> &a, const std::shared_ptr<KDNode<dim, T>> &b) {
+                         return a->config[axis] < b->config[axis];
+                     });
+
+    auto kdNode = kdNodes[median];
+    kdNode->axis = axis;
+    kdNode->value = kdNode->config[axis];
+    kdNode->size = end - begin;
+    kdNode->setLeft(build(kdNodes, begin, median, (axis + 1) % dim));
+    kdNode->setRight(build(kdNodes, median + 1, end, (axis + 1) % dim));
+    return kdNode;
 }
 
 /*!
@@ -214,15 +553,15 @@ std::shared_ptr<KDNode<dim, T>> KDTree<dim, T>::insert(std::shared_ptr<KDNode<di
 *  \author     Sascha Kaden
 *  \date       2017-01-07
 */
-template <unsigned int dim, class T>
-void KDTree<dim, T>::removeNodes(std::shared_ptr<KDNode<dim, T>> node) {
+template <unsigned int dim, class T, class Metric>
+void KDTree<dim, T, Metric>::removeNodes(std::shared_ptr<KDNode<dim, T>> node) {
     if (node->left != nullptr) {
         removeNodes(node->left);
-        node->left = nullptr;
+        node->setLeft(nullptr);
     }
     if (node->right != nullptr) {
         removeNodes(node->right);
-        node->right = nullptr;
+        node->setRight(nullptr);
     }
 };
 
@@ -233,17 +572,61 @@ void KDTree<dim, T>::removeNodes(std::shared_ptr<KDNode<dim, T>> node) {
 *  \param[out] pointer to the nearest Node
 *  \date       2016-05-27
 */
-template <unsigned int dim, class T>
-T KDTree<dim, T>::searchNearestNeighbor(const Vector<dim> &config) {
-    if (m_root == nullptr)
+template <unsigned int dim, class T, class Metric>
+T KDTree<dim, T, Metric>::searchNearestNeighbor(const Vector<dim> &config) {
+    auto root = std::atomic_load(&m_root);
+    if (root == nullptr)
         return nullptr;
 
-    std::shared_ptr<KDNode<dim, T>> kdNode;
+    const KDNode<dim, T> *kdNode = nullptr;
     double dist = std::numeric_limits<double>::max();
-    NNS(config, m_root, kdNode, dist);
+    NNS(config, root.get(), kdNode, dist, this->getSimpleApproximationFactor());
+    if (kdNode == nullptr)
+        return nullptr;
     return kdNode->node;
 }
 
+/*!
+*  \brief      Search for the nearest neighbor of each passed position
+*  \details    The queries are searched in spatial order, the nearest node of the previous query bounds the search
+*  distance of the next one. Close queries prune most of the tree and run through the same (cached) nodes.
+*  \author     Sascha Kaden
+*  \param[in]  list of positions
+*  \param[out] list of nearest nodes, the index equals the index of the position
+*  \date       2017-11-25
+*/
+template <unsigned int dim, class T, class Metric>
+std::vector<T> KDTree<dim, T, Metric>::searchNearestNeighbors(const std::vector<Vector<dim>> &configs) {
+    std::vector<T> nodes(configs.size(), nullptr);
+    auto root = std::atomic_load(&m_root);
+    if (root == nullptr || configs.empty())
+        return nodes;
+
+    std::vector<size_t> order(configs.size());
+    for (size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+    sortSpatial(configs, order, 0, order.size(), 0);
+
+    const double factor = this->getSimpleApproximationFactor();
+    const KDNode<dim, T> *previous = nullptr;
+    for (auto index : order) {
+        const Vector<dim> &config = configs[index];
+        const KDNode<dim, T> *kdNode = nullptr;
+        double dist = std::numeric_limits<double>::max();
+        // the previous result is a valid upper bound, if it is not the query itself
+        if (previous != nullptr && previous->config != config) {
+            kdNode = previous;
+            dist = m_typedMetric->calcSimpleDist(config, previous->config);
+        }
+        NNS(config, root.get(), kdNode, dist, factor);
+        if (kdNode != nullptr) {
+            nodes[index] = kdNode->node;
+            previous = kdNode;
+        }
+    }
+    return nodes;
+}
+
 /*!
 *  \brief      Search for range around a position
 *  \author     Sascha Kaden
@@ -252,181 +635,159 @@ T KDTree<dim, T>::searchNearestNeighbor(const Vector<dim> &config) {
 *  \param[out] list of near nodes to the position
 *  \date       2016-05-27
 */
-template <unsigned int dim, class T>
-std::vector<T> KDTree<dim, T>::searchRange(const Vector<dim> &config, double range) {
+template <unsigned int dim, class T, class Metric>
+std::vector<T> KDTree<dim, T, Metric>::searchRange(const Vector<dim> &config, double range) {
     std::vector<T> nodes;
-    if (m_root == nullptr)
+    auto root = std::atomic_load(&m_root);
+    if (root == nullptr)
         return nodes;
 
-    std::vector<std::shared_ptr<KDNode<dim, T>>> kdNodes;
-    Vector<dim> maxBoundary = config;
-    Vector<dim> minBoundary = config;
-    this->m_metric->simplifyDist(range);
-    maxBoundary = maxBoundary.array() + range;
-    minBoundary = minBoundary.array() - range;
-    RS(config, m_root, kdNodes, range, maxBoundary, minBoundary);
-
-    for (auto kdNode : kdNodes) {
-        if (kdNode->config != config) {
-            nodes.push_back(kdNode->node);
-        }
-    }
-
+    m_typedMetric->simplifyDist(range);
+    RS(config, root.get(), nodes, range);
     return nodes;
 }
 
+/*!
+*  \brief      Search for the k nearest neighbors
+*  \details    The nodes are sorted by ascending distance, with an approximation factor larger than zero the found nodes
+*  can be farther away than the exact k nearest nodes.
+*  \author     Sascha Kaden
+*  \param[in]  position
+*  \param[in]  number of neighbors k
+*  \param[out] list of the k nearest nodes to the position
+*  \date       2017-11-22
+*/
+template <unsigned int dim, class T, class Metric>
+std::vector<T> KDTree<dim, T, Metric>::searchKNearest(const Vector<dim> &config, size_t k) {
+    std::vector<std::pair<double, T>> heap;
+    auto root = std::atomic_load(&m_root);
+    if (root == nullptr || k == 0)
+        return std::vector<T>();
+
+    heap.reserve(k);
+    KNNS(config, root.get(), heap, k, this->getSimpleApproximationFactor());
+    return this->sortKNearest(heap);
+}
+
 /*!
 *  \brief      Search for the nearest neighbor (recursive function)
+*  \details    The far side is only searched, if the distance to the split plane multiplied with the approximation
+*  factor is smaller than the best distance.
 *  \author     Sascha Kaden
 *  \param[in]  position
+*  \param[in]  current KDNode
 *  \param[in]  reference KDNode
 *  \param[in]  shortest distance
+*  \param[in]  simplified approximation factor
 *  \date       2016-05-27
 */
-template <unsigned int dim, class T>
-void KDTree<dim, T>::NNS(const Vector<dim> &config, std::shared_ptr<KDNode<dim, T>> node,
-                         std::shared_ptr<KDNode<dim, T>> &refNode, double &bestDist) {
-    double dist = this->m_metric->calcSimpleDist(config, node->config);
+template <unsigned int dim, class T, class Metric>
+void KDTree<dim, T, Metric>::NNS(const Vector<dim> &config, const KDNode<dim, T> *node, const KDNode<dim, T> *&refNode,
+                                 double &bestDist, const double factor) {
+    double dist = m_typedMetric->calcSimpleDist(config, node->config);
     if (dist < bestDist && config != node->config) {
         bestDist = dist;
         refNode = node;
     }
 
-    if (node->left == nullptr && node->right == nullptr) {
-        return;
-    } else {
-        if (config[node->axis] <= node->value) {
-            if (config[node->axis] - bestDist <= node->value && node->left != nullptr)
-                NNS(config, node->left, refNode, bestDist);
-            if (config[node->axis] + bestDist > node->value && node->right != nullptr)
-                NNS(config, node->right, refNode, bestDist);
-        } else {
-            if (config[node->axis] + bestDist > node->value && node->right != nullptr)
-                NNS(config, node->right, refNode, bestDist);
-            if (config[node->axis] - bestDist <= node->value && node->left != nullptr)
-                NNS(config, node->left, refNode, bestDist);
-        }
-    }
+    const KDNode<dim, T> *left = node->leftLink.load(std::memory_order_acquire);
+    const KDNode<dim, T> *right = node->rightLink.load(std::memory_order_acquire);
+    const KDNode<dim, T> *near = config[node->axis] < node->value ? left : right;
+    const KDNode<dim, T> *far = config[node->axis] < node->value ? right : left;
+    if (near != nullptr)
+        NNS(config, near, refNode, bestDist, factor);
+    if (far != nullptr && planeDist(config, node) * factor < bestDist)
+        NNS(config, far, refNode, bestDist, factor);
 }
 
 /*!
-*  \brief      Search range for near nodes (recursive function)
+*  \brief      Search for the k nearest neighbors (recursive function)
 *  \author     Sascha Kaden
 *  \param[in]  position
-*  \param[in]  list of reference kdNodes
-*  \param[in]  squared range distance
-*  \param[in]  maximum boundary
-*  \param[in]  minimum boundary
-*  \date       2016-05-27
+*  \param[in]  current KDNode
+*  \param[in]  bounded max heap of the k nearest nodes
+*  \param[in]  number of neighbors k
+*  \param[in]  simplified approximation factor
+*  \date       2017-11-22
 */
-template <unsigned int dim, class T>
-void KDTree<dim, T>::RS(const Vector<dim> &config, std::shared_ptr<KDNode<dim, T>> node,
-                        std::vector<std::shared_ptr<KDNode<dim, T>>> &refNodes, double simplifiedRange,
-                        const Vector<dim> &maxBoundary, const Vector<dim> &minBoundary) {
-    if (node == nullptr)
-        return;
-
-    if (this->m_metric->calcSimpleDist(config, node->config) < simplifiedRange && config != node->config)
-        refNodes.push_back(node);
-
-    if (config[node->axis] < maxBoundary[node->axis] && config[node->axis] < minBoundary[node->axis]) {
-        RS(config, node->left, refNodes, simplifiedRange, maxBoundary, minBoundary);
-    } else if (config[node->axis] > maxBoundary[node->axis] && config[node->axis] > minBoundary[node->axis]) {
-        RS(config, node->right, refNodes, simplifiedRange, maxBoundary, minBoundary);
-    } else {
-        RS(config, node->left, refNodes, simplifiedRange, maxBoundary, minBoundary);
-        RS(config, node->right, refNodes, simplifiedRange, maxBoundary, minBoundary);
-    }
+template <unsigned int dim, class T, class Metric>
+void KDTree<dim, T, Metric>::KNNS(const Vector<dim> &config, const KDNode<dim, T> *node,
+                                  std::vector<std::pair<double, T>> &heap, const size_t k, const double factor) {
+    if (config != node->config)
+        this->pushKNearest(heap, k, m_typedMetric->calcSimpleDist(config, node->config), node->node);
+
+    const KDNode<dim, T> *left = node->leftLink.load(std::memory_order_acquire);
+    const KDNode<dim, T> *right = node->rightLink.load(std::memory_order_acquire);
+    const KDNode<dim, T> *near = config[node->axis] < node->value ? left : right;
+    const KDNode<dim, T> *far = config[node->axis] < node->value ? right : left;
+    if (near != nullptr)
+        KNNS(config, near, heap, k, factor);
+    if (far != nullptr && (heap.size() < k || planeDist(config, node) * factor < heap.front().first))
+        KNNS(config, far, heap, k, factor);
 }
 
 /*!
-*  \brief      Sorts the passed vector of Nodes and add the KDNode<dim> to the KDTree (recursive function)
+*  \brief      Return the simplified distance from the position to the split plane of the KDNode
 *  \author     Sascha Kaden
-*  \param[in]  vector of Node<dim> pointer
-*  \param[in]  split dimension
-*  \param[out] pointer of KDNode
-*  \date       2016-08-09
+*  \param[in]  position
+*  \param[in]  KDNode
+*  \param[out] simplified distance
+*  \date       2017-11-22
 */
-template <unsigned int dim, class T>
-std::shared_ptr<KDNode<dim, T>> KDTree<dim, T>::sortNodes(std::vector<T> &config, unsigned int cd) {
-    if (config.size() < 1) {
-        return nullptr;
-    } else if (config.size() == 1) {
-        std::shared_ptr<KDNode<dim, T>> kdNode =
-            std::shared_ptr<KDNode<dim, T>>(new KDNode<dim, T>(config[0]->getValues(), config[0]));
-        kdNode->axis = cd;
-        kdNode->value = kdNode->config[cd];
-        return kdNode;
-    } else if (config.size() == 2) {
-        quickSort(config, 0, config.size() - 1, cd);
-        std::shared_ptr<KDNode<dim, T>> kdNode =
-            std::shared_ptr<KDNode<dim, T>>(new KDNode<dim, T>(config[1]->getValues(), config[1]));
-        kdNode->axis = cd;
-        kdNode->value = kdNode->config[cd];
-
-        std::vector<std::shared_ptr<Node<dim>>> vecLeft(config.begin(), config.begin() + 1);
-        kdNode->left = sortNodes(vecLeft, (cd + 1) % dim);
-
-        return kdNode;
-    } else {
-        quickSort(config, 0, config.size() - 1, cd);
-        std::shared_ptr<KDNode<dim, T>> kdNode =
-            std::make_shared<KDNode<dim, T>>(config[config.size() / 2]->getValues(), config[config.size() / 2]);
-        kdNode->axis = cd;
-        kdNode->value = kdNode->config[cd];
-
-        std::vector<T> vecLeft(config.begin(), config.begin() + (config.size() / 2) - 1);
-        std::vector<T> vecRight(config.begin() + (config.size() / 2) + 1, config.end());
-        kdNode->left = sortNodes(vecLeft, (cd + 1) % dim);
-        kdNode->right = sortNodes(vecRight, (cd + 1) % dim);
-        return kdNode;
-    }
+template <unsigned int dim, class T, class Metric>
+double KDTree<dim, T, Metric>::planeDist(const Vector<dim> &config, const KDNode<dim, T> *node) const {
+    Vector<dim> projection = config;
+    projection[node->axis] = node->value;
+    return m_typedMetric->calcSimpleDist(config, projection);
 }
 
 /*!
-*  \brief      quick sort algorithm (recursive function)
+*  \brief      Sort the query order spatial by median splits with alternating axes (recursive function)
 *  \author     Sascha Kaden
-*  \param[in]  vector of Node<dim> pointer
-*  \param[in]  left start index for the vector
-*  \param[in]  right end index for the vector
-*  \param[in]  split dimension
-*  \date       2016-08-09
+*  \param[in]  positions
+*  \param[in,out] order of the positions
+*  \param[in]  begin of the range
+*  \param[in]  end of the range
+*  \param[in]  split axis
+*  \date       2017-11-25
 */
-template <unsigned int dim, class T>
-void KDTree<dim, T>::quickSort(std::vector<T> &A, size_t left, size_t right, int cd) {
-    size_t r;
-    if (left < right) {
-        r = partition(A, left, right, cd);
-        quickSort(A, left, r, cd);
-        quickSort(A, r + 1, right, cd);
-    }
+template <unsigned int dim, class T, class Metric>
+void KDTree<dim, T, Metric>::sortSpatial(const std::vector<Vector<dim>> &configs, std::vector<size_t> &order, const size_t begin,
+                                 const size_t end, const unsigned int axis) const {
+    if (end - begin < 2)
+        return;
+
+    size_t median = begin + (end - begin) / 2;
+    std::nth_element(order.begin() + begin, order.begin() + median, order.begin() + end,
+                     [&configs, axis](size_t a, size_t b) { return configs[a][axis] < configs[b][axis]; });
+    sortSpatial(configs, order, begin, median, (axis + 1) % dim);
+    sortSpatial(configs, order, median, end, (axis + 1) % dim);
 }
 
 /*!
-*  \brief      Partition of the vector and return pivot element
+*  \brief      Search range for near nodes (recursive function)
+*  \details    The far side is only searched, if the distance to the split plane is smaller than the range.
 *  \author     Sascha Kaden
-*  \param[in]  vector of Node<dim> pointer
-*  \param[in]  left start index for the vector
-*  \param[in]  right end index for the vector
-*  \param[in]  split dimension
-*  \param[out] index for splitting (pivot element)
-*  \date       2016-08-09
+*  \param[in]  position
+*  \param[in]  current KDNode
+*  \param[in]  list of near nodes
+*  \param[in]  simplified range distance
+*  \date       2016-05-27
 */
-template <unsigned int dim, class T>
-size_t KDTree<dim, T>::partition(std::vector<T> &A, size_t left, size_t right, int cd) {
-    double x = A[left]->getValues()[cd];
-    size_t i = left;
-    size_t j;
-
-    for (j = left + 1; j < right; j++) {
-        if (A[j]->getValues()[cd] <= x) {
-            i = i + 1;
-            swap(A[i], A[j]);
-        }
-    }
-
-    swap(A[i], A[left]);
-    return i;
+template <unsigned int dim, class T, class Metric>
+void KDTree<dim, T, Metric>::RS(const Vector<dim> &config, const KDNode<dim, T> *node, std::vector<T> &nodes,
+                                const double simplifiedRange) {
+    if (m_typedMetric->calcSimpleDist(config, node->config) < simplifiedRange && config != node->config)
+        nodes.push_back(node->node);
+
+    const KDNode<dim, T> *left = node->leftLink.load(std::memory_order_acquire);
+    const KDNode<dim, T> *right = node->rightLink.load(std::memory_order_acquire);
+    const KDNode<dim, T> *near = config[node->axis] < node->value ? left : right;
+    const KDNode<dim, T> *far = config[node->axis] < node->value ? right : left;
+    if (near != nullptr)
+        RS(config, near, nodes, simplifiedRange);
+    if (far != nullptr && planeDist(config, node) < simplifiedRange)
+        RS(config, far, nodes, simplifiedRange);
 }
 
 } /* namespace ippp */
@@ -19,6 +19,10 @@
 #ifndef NEIGHBORFINDER_HPP
 #define NEIGHBORFINDER_HPP
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 #include <ippp/Identifier.h>
 #include <ippp/modules/distanceMetrics/DistanceMetric.hpp>
 #include <ippp/util/Logging.h>
@@ -27,6 +31,7 @@ namespace ippp {
 
 /*!
 * \brief   Interface for NeighborFinder
+* \details Nodes at exactly the same position as the query are never returned by the searches.
 * \author  Sascha Kaden
 * \date    2017-05-09
 */
@@ -38,12 +43,23 @@ class NeighborFinder : public Identifier {
 
     virtual void addNode(const Vector<dim> &config, const T &node) = 0;
     virtual void rebaseSorted(std::vector<T> &nodes) = 0;
+    virtual bool isConcurrent() const;
 
     virtual T searchNearestNeighbor(const Vector<dim> &config) = 0;
+    virtual std::vector<T> searchNearestNeighbors(const std::vector<Vector<dim>> &configs);
     virtual std::vector<T> searchRange(const Vector<dim> &config, double range) = 0;
+    virtual std::vector<T> searchKNearest(const Vector<dim> &config, size_t k) = 0;
+
+    void setApproximation(const double approximation);
+    double getApproximation() const;
 
   protected:
+    double getSimpleApproximationFactor() const;
+    static void pushKNearest(std::vector<std::pair<double, T>> &heap, const size_t k, const double dist, const T &node);
+    static std::vector<T> sortKNearest(std::vector<std::pair<double, T>> &heap);
+
     std::shared_ptr<DistanceMetric<dim>> m_metric;
+    double m_approximation = 0;
 };
 
 /*!
@@ -62,6 +78,119 @@ NeighborFinder<dim, T>::~NeighborFinder() {
     Logging::debug("Initialize", this);
 }
 
+/*!
+*  \brief      Returns true, if nodes can be added and searched by multiple threads at the same time without locking.
+*  \author     Sascha Kaden
+*  \param[out] concurrent usage
+*  \date       2017-11-23
+*/
+template <unsigned int dim, class T>
+bool NeighborFinder<dim, T>::isConcurrent() const {
+    return false;
+}
+
+/*!
+*  \brief      Search for the nearest neighbor of each passed position
+*  \details    Default implementation calls searchNearestNeighbor for every position, finders can share work between
+*  the queries.
+*  \author     Sascha Kaden
+*  \param[in]  list of positions
+*  \param[out] list of nearest nodes, the index equals the index of the position
+*  \date       2017-11-25
+*/
+template <unsigned int dim, class T>
+std::vector<T> NeighborFinder<dim, T>::searchNearestNeighbors(const std::vector<Vector<dim>> &configs) {
+    std::vector<T> nodes;
+    nodes.reserve(configs.size());
+    for (auto &config : configs)
+        nodes.push_back(searchNearestNeighbor(config));
+    return nodes;
+}
+
+/*!
+*  \brief      Sets the approximation factor epsilon of the nearest neighbor search.
+*  \details    The found neighbors have at most a distance of (1 + epsilon) times the distance of the exact neighbors,
+*  with 0 the search is exact.
+*  \author     Sascha Kaden
+*  \param[in]  approximation factor epsilon
+*  \date       2017-11-22
+*/
+template <unsigned int dim, class T>
+void NeighborFinder<dim, T>::setApproximation(const double approximation) {
+    if (approximation < 0) {
+        Logging::warning("Approximation has to be equal or larger than 0, it was set to 0", this);
+        m_approximation = 0;
+    } else {
+        m_approximation = approximation;
+    }
+}
+
+/*!
+*  \brief      Returns the approximation factor epsilon of the nearest neighbor search.
+*  \author     Sascha Kaden
+*  \param[out] approximation factor epsilon
+*  \date       2017-11-22
+*/
+template <unsigned int dim, class T>
+double NeighborFinder<dim, T>::getApproximation() const {
+    return m_approximation;
+}
+
+/*!
+*  \brief      Returns the simplified factor (1 + epsilon), it can be multiplied with simplified distances.
+*  \author     Sascha Kaden
+*  \param[out] simplified approximation factor
+*  \date       2017-11-22
+*/
+template <unsigned int dim, class T>
+double NeighborFinder<dim, T>::getSimpleApproximationFactor() const {
+    double factor = 1 + m_approximation;
+    m_metric->simplifyDist(factor);
+    return factor;
+}
+
+/*!
+*  \brief      Push the node into the bounded max heap of the k nearest neighbors, the farthest node is removed if the
+*  heap is full. The front of the heap is always the farthest of the k nearest nodes.
+*  \author     Sascha Kaden
+*  \param[in]  heap of simplified distances and nodes
+*  \param[in]  k
+*  \param[in]  simplified distance
+*  \param[in]  node
+*  \date       2017-11-22
+*/
+template <unsigned int dim, class T>
+void NeighborFinder<dim, T>::pushKNearest(std::vector<std::pair<double, T>> &heap, const size_t k, const double dist,
+                                          const T &node) {
+    auto compare = [](const std::pair<double, T> &a, const std::pair<double, T> &b) { return a.first < b.first; };
+    if (heap.size() < k) {
+        heap.push_back(std::make_pair(dist, node));
+        std::push_heap(heap.begin(), heap.end(), compare);
+    } else if (dist < heap.front().first) {
+        std::pop_heap(heap.begin(), heap.end(), compare);
+        heap.back() = std::make_pair(dist, node);
+        std::push_heap(heap.begin(), heap.end(), compare);
+    }
+}
+
+/*!
+*  \brief      Sort the heap of the k nearest neighbors and return the nodes with ascending distance.
+*  \author     Sascha Kaden
+*  \param[in]  heap of simplified distances and nodes
+*  \param[out] sorted list of nodes
+*  \date       2017-11-22
+*/
+template <unsigned int dim, class T>
+std::vector<T> NeighborFinder<dim, T>::sortKNearest(std::vector<std::pair<double, T>> &heap) {
+    auto compare = [](const std::pair<double, T> &a, const std::pair<double, T> &b) { return a.first < b.first; };
+    std::sort_heap(heap.begin(), heap.end(), compare);
+    std::vector<T> nodes;
+    nodes.reserve(heap.size());
+    for (auto &entry : heap)
+        nodes.push_back(entry.second);
+    return nodes;
+}
+
 } /* namespace ippp */
 
 #endif /* NEIGHBORFINDER_HPP */
@@ -0,0 +1,316 @@
+//-------------------------------------------------------------------------//
+//
+// Copyright 2017 Sascha Kaden
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-------------------------------------------------------------------------//
+
+
+#ifndef SIMDBRUTEFORCENF_HPP
+#define SIMDBRUTEFORCENF_HPP
+
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <ippp/modules/distanceMetrics/InfMetric.hpp>
+#include <ippp/modules/distanceMetrics/L1Metric.hpp>
+#include <ippp/modules/distanceMetrics/L2Metric.hpp>
+#include <ippp/modules/distanceMetrics/WeightedInfMetric.hpp>
+#include <ippp/modules/distanceMetrics/WeightedL1Metric.hpp>
+#include <ippp/modules/distanceMetrics/WeightedL2Metric.hpp>
+#include <ippp/modules/neighborFinders/NeighborFinder.hpp>
+#include <ippp/util/UtilSimd.hpp>
+
+namespace ippp {
+
+/*!
+* \brief   Class SimdBruteForceNF for a vectorized brute force search
+* \details The coordinates are stored in structure of arrays blocks of util::simdBlockSize points. For the L1, L2 and
+* infinity metrics (weighted and not weighted) the distances of a block are computed by an AVX-512, AVX2 or scalar
+* kernel, which is chosen by the running CPU. Other metrics are evaluated by the DistanceMetric. Every distance is
+* computed once per search, for small graphs and high dimensions it is faster than the KDTree. The kernel and the
+* weights of the metric are read at construction.
+* \author  Sascha Kaden
+* \date    2017-11-26
+*/
+template <unsigned int dim, class T>
+class SimdBruteForceNF : public NeighborFinder<dim, T> {
+  public:
+    SimdBruteForceNF(const std::shared_ptr<DistanceMetric<dim>> &distanceMetric);
+    SimdBruteForceNF(const std::shared_ptr<DistanceMetric<dim>> &distanceMetric, std::vector<T> &nodes);
+
+    void addNode(const Vector<dim> &config, const T &node);
+    void rebaseSorted(std::vector<T> &nodes);
+
+    T searchNearestNeighbor(const Vector<dim> &config);
+    std::vector<T> searchRange(const Vector<dim> &config, double range);
+    std::vector<T> searchKNearest(const Vector<dim> &config, size_t k);
+
+    size_t size() const;
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  private:
+    void initKernel();
+    template <class Function>
+    void forEachDistance(const Vector<dim> &config, const double &bound, Function function) const;
+    bool isEqual(const Vector<dim> &config, const size_t index) const;
+
+    util::BlockDistanceFunction m_kernel = nullptr;
+    Vector<dim> m_weights = Vector<dim>::Ones();
+    std::vector<double> m_coords;
+    std::vector<T> m_nodes;
+};
+
+/*!
+*  \brief      Default constructor of the class SimdBruteForceNF
+*  \author     Sascha Kaden
+*  \param[in]  DistanceMetric
+*  \date       2017-11-26
+*/
+template <unsigned int dim, class T>
+SimdBruteForceNF<dim, T>::SimdBruteForceNF(const std::shared_ptr<DistanceMetric<dim>> &distanceMetric)
+    : NeighborFinder<dim, T>("SimdBruteForceNF", distanceMetric) {
+    initKernel();
+}
+
+/*!
+*  \brief      Constructor of the class SimdBruteForceNF, stores all passed nodes.
+*  \author     Sascha Kaden
+*  \param[in]  DistanceMetric
+*  \param[in]  vector of nodes
+*  \date       2017-11-26
+*/
+template <unsigned int dim, class T>
+SimdBruteForceNF<dim, T>::SimdBruteForceNF(const std::shared_ptr<DistanceMetric<dim>> &distanceMetric, std::vector<T> &nodes)
+    : NeighborFinder<dim, T>("SimdBruteForceNF", distanceMetric) {
+    initKernel();
+    rebaseSorted(nodes);
+}
+
+/*!
+*  \brief      Add a Node to the last block, a new block is appended if the last one is full.
+*  \author     Sascha Kaden
+*  \param[in]  position
+*  \param[in]  pointer to the Node
+*  \date       2017-11-26
+*/
+template <unsigned int dim, class T>
+void SimdBruteForceNF<dim, T>::addNode(const Vector<dim> &config, const T &node) {
+    const size_t lane = m_nodes.size() % util::simdBlockSize;
+    if (lane == 0)
+        m_coords.resize(m_coords.size() + dim * util::simdBlockSize, 0);
+
+    double *block = m_coords.data() + m_coords.size() - dim * util::simdBlockSize;
+    for (unsigned int axis = 0; axis < dim; ++axis)
+        block[axis * util::simdBlockSize + lane] = config[axis];
+    m_nodes.push_back(node);
+}
+
+/*!
+*  \brief      Rebuild the blocks from the passed nodes, if the size differs.
+*  \author     Sascha Kaden
+*  \param[in]  vector of nodes
+*  \date       2017-11-26
+*/
+template <unsigned int dim, class T>
+void SimdBruteForceNF<dim, T>::rebaseSorted(std::vector<T> &nodes) {
+    if (m_nodes.size() == nodes.size())
+        return;
+
+    m_coords.clear();
+    m_nodes.clear();
+    m_coords.reserve(((nodes.size() + util::simdBlockSize - 1) / util::simdBlockSize) * dim * util::simdBlockSize);
+    m_nodes.reserve(nodes.size());
+    for (auto &node : nodes)
+        addNode(node->getValues(), node);
+}
+
+/*!
+*  \brief      Search for the nearest neighbor
+*  \author     Sascha Kaden
+*  \param[in]  position
+*  \param[out] pointer to the nearest Node
+*  \date       2017-11-26
+*/
+template <unsigned int dim, class T>
+T SimdBruteForceNF<dim, T>::searchNearestNeighbor(const Vector<dim> &config) {
+    double bestDist = std::numeric_limits<double>::max();
+    size_t bestIndex = m_nodes.size();
+    forEachDistance(config, bestDist, [&](const size_t index, const double dist) {
+        if (dist < bestDist) {
+            bestDist = dist;
+            bestIndex = index;
+        }
+    });
+    if (bestIndex == m_nodes.size())
+        return nullptr;
+    return m_nodes[bestIndex];
+}
+
+/*!
+*  \brief      Search for range around a position
+*  \author     Sascha Kaden
+*  \param[in]  position
+*  \param[in]  distance of the range
+*  \param[out] list of near nodes to the position
+*  \date       2017-11-26
+*/
+template <unsigned int dim, class T>
+std::vector<T> SimdBruteForceNF<dim, T>::searchRange(const Vector<dim> &config, double range) {
+    std::vector<T> nodes;
+    this->m_metric->simplifyDist(range);
+    forEachDistance(config, range, [&](const size_t index, const double dist) {
+        if (dist < range)
+            nodes.push_back(m_nodes[index]);
+    });
+    return nodes;
+}
+
+/*!
+*  \brief      Search for the k nearest neighbors, the search is always exact.
+*  \author     Sascha Kaden
+*  \param[in]  position
+*  \param[in]  number of neighbors k
+*  \param[out] list of the k nearest nodes to the position, sorted by ascending distance
+*  \date       2017-11-26
+*/
+template <unsigned int dim, class T>
+std::vector<T> SimdBruteForceNF<dim, T>::searchKNearest(const Vector<dim> &config, size_t k) {
+    std::vector<std::pair<double, T>> heap;
+    if (k == 0)
+        return std::vector<T>();
+
+    heap.reserve(k);
+    double bound = std::numeric_limits<double>::max();
+    forEachDistance(config, bound, [&](const size_t index, const double dist) {
+        this->pushKNearest(heap, k, dist, m_nodes[index]);
+        if (heap.size() == k)
+            bound = heap.front().first;
+    });
+    return this->sortKNearest(heap);
+}
+
+/*!
+*  \brief      Return the number of nodes
+*  \author     Sascha Kaden
+*  \param[out] size
+*  \date       2017-11-26
+*/
+template <unsigned int dim, class T>
+size_t SimdBruteForceNF<dim, T>::size() const {
+    return m_nodes.size();
+}
+
+/*!
+*  \brief      Choose the block distance kernel and store the weights of the DistanceMetric, if the metric is unknown
+*  no kernel is set. Metrics without weights keep the weights of ones.
+*  \author     Sascha Kaden
+*  \date       2017-11-26
+*/
+template <unsigned int dim, class T>
+void SimdBruteForceNF<dim, T>::initKernel() {
+    auto &metric = this->m_metric;
+    if (std::dynamic_pointer_cast<L2Metric<dim>>(metric)) {
+        m_kernel = util::getBlockDistanceFunction<util::SimdMetric::L2>();
+    } else if (auto weighted = std::dynamic_pointer_cast<WeightedL2Metric<dim>>(metric)) {
+        m_kernel = util::getBlockDistanceFunction<util::SimdMetric::L2>();
+        m_weights = weighted->getWeightVec();
+    } else if (std::dynamic_pointer_cast<L1Metric<dim>>(metric)) {
+        m_kernel = util::getBlockDistanceFunction<util::SimdMetric::L1>();
+    } else if (auto weighted = std::dynamic_pointer_cast<WeightedL1Metric<dim>>(metric)) {
+        m_kernel = util::getBlockDistanceFunction<util::SimdMetric::L1>();
+        m_weights = weighted->getWeightVec();
+    } else if (std::dynamic_pointer_cast<InfMetric<dim>>(metric)) {
+        m_kernel = util::getBlockDistanceFunction<util::SimdMetric::Inf>();
+    } else if (auto weighted = std::dynamic_pointer_cast<WeightedInfMetric<dim>>(metric)) {
+        m_kernel = util::getBlockDistanceFunction<util::SimdMetric::Inf>();
+        m_weights = weighted->getWeightVec();
+    } else {
+        Logging::info("Unknown metric, distances will be computed by the metric", this);
+    }
+}
+
+/*!
+*  \brief      Computes the simplified distance to every node once and calls the function with the index and distance.
+*  \details    Only distances smaller than the bound are passed, the bound can be shrunk by the function. Blocks
+*  without any lane below the bound are skipped at once. Nodes at the same position as the query are skipped.
+*  \author     Sascha Kaden
+*  \param[in]  position
+*  \param[in]  upper bound of the simplified distance
+*  \param[in]  function(index, simplified distance)
+*  \date       2017-11-26
+*/
+template <unsigned int dim, class T>
+template <class Function>
+void SimdBruteForceNF<dim, T>::forEachDistance(const Vector<dim> &config, const double &bound, Function function) const {
+    const size_t numNodes = m_nodes.size();
+    if (m_kernel == nullptr) {
+        for (size_t index = 0; index < numNodes; ++index) {
+            Vector<dim> point;
+            const double *block = m_coords.data() + (index / util::simdBlockSize) * dim * util::simdBlockSize;
+            for (unsigned int axis = 0; axis < dim; ++axis)
+                point[axis] = block[axis * util::simdBlockSize + index % util::simdBlockSize];
+            if (point == config)
+                continue;
+            double dist = this->m_metric->calcSimpleDist(config, point);
+            if (dist < bound)
+                function(index, dist);
+        }
+        return;
+    }
+
+    double dists[util::simdBlocksPerCall * util::simdBlockSize];
+    const size_t chunkSize = util::simdBlocksPerCall * util::simdBlockSize;
+    for (size_t chunk = 0; chunk < numNodes; chunk += chunkSize) {
+        const size_t chunkNodes = std::min(chunkSize, numNodes - chunk);
+        const size_t numBlocks = (chunkNodes + util::simdBlockSize - 1) / util::simdBlockSize;
+        m_kernel(m_coords.data() + chunk * dim, numBlocks, config.data(), m_weights.data(), dim, dists);
+
+        for (size_t begin = 0; begin < chunkNodes; begin += util::simdBlockSize) {
+            const double *blockDists = dists + begin;
+            const size_t lanes = std::min<size_t>(util::simdBlockSize, chunkNodes - begin);
+            if (*std::min_element(blockDists, blockDists + lanes) >= bound)
+                continue;
+            for (size_t lane = 0; lane < lanes; ++lane) {
+                // a zero distance can be a point at the same position or a zero weight
+                if (blockDists[lane] >= bound || (blockDists[lane] == 0 && isEqual(config, chunk + begin + lane)))
+                    continue;
+                function(chunk + begin + lane, blockDists[lane]);
+            }
+        }
+    }
+}
+
+/*!
+*  \brief      Return true, if the stored point of the index equals the position
+*  \author     Sascha Kaden
+*  \param[in]  position
+*  \param[in]  index of the point
+*  \param[out] result
+*  \date       2017-11-26
+*/
+template <unsigned int dim, class T>
+bool SimdBruteForceNF<dim, T>::isEqual(const Vector<dim> &config, const size_t index) const {
+    const double *block = m_coords.data() + (index / util::simdBlockSize) * dim * util::simdBlockSize;
+    for (unsigned int axis = 0; axis < dim; ++axis)
+        if (block[axis * util::simdBlockSize + index % util::simdBlockSize] != config[axis])
+            return false;
+    return true;
+}
+
+} /* namespace ippp */
+
+#endif /* SIMDBRUTEFORCENF_HPP */
@@ -0,0 +1,379 @@
+//-------------------------------------------------------------------------//
+//
+// Copyright 2017 Sascha Kaden
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-------------------------------------------------------------------------//
+
+#ifndef STATICKDTREE_HPP
+#define STATICKDTREE_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include <Eigen/StdVector>
+
+#include <ippp/modules/neighborFinders/NeighborFinder.hpp>
+
+namespace ippp {
+
+/*!
+* \brief   Class StaticKDTree is a balanced KD tree, which is stored in a flat array in Eytzinger (breadth first) order.
+* \details The children of the node i are at 2i+1 and 2i+2, no child pointer are needed. Points, split values and split
+* axes are stored in separate arrays. The tree is build by rebaseSorted, Nodes added afterwards are hold in a small
+* unsorted list, which is searched linear until the next rebase. The searches use a fixed stack and need no heap
+* allocation.
+* The Metric parameter sets the static type of the DistanceMetric, with a final metric (e.g. L2Metric<dim>) the distance
+* computations are inlined, the default DistanceMetric<dim> uses the virtual calls.
+* \author  Sascha Kaden
+* \date    2017-11-21
+*/
+template <unsigned int dim, class T, class Metric = DistanceMetric<dim>>
+class StaticKDTree : public NeighborFinder<dim, T> {
+  public:
+    StaticKDTree(const std::shared_ptr<Metric> &distanceMetric);
+    StaticKDTree(const std::shared_ptr<Metric> &distanceMetric, std::vector<T> &nodes);
+
+    void addNode(const Vector<dim> &config, const T &node);
+    void rebaseSorted(std::vector<T> &nodes);
+
+    T searchNearestNeighbor(const Vector<dim> &config);
+    std::vector<T> searchRange(const Vector<dim> &config, double range);
+    std::vector<T> searchKNearest(const Vector<dim> &config, size_t k);
+
+    size_t size() const;
+
+  private:
+    void build(std::vector<size_t> &order, size_t begin, size_t end, size_t index,
+               const std::vector<Vector<dim>, Eigen::aligned_allocator<Vector<dim>>> &points, const std::vector<T> &nodes);
+    double planeDist(const Vector<dim> &config, const size_t index) const;
+    static size_t leftSubtreeSize(const size_t size);
+
+    // maximum depth of the stack, the tree is balanced, so 64 levels are never reached
+    static constexpr size_t m_maxStackSize = 128;
+
+    std::vector<Vector<dim>, Eigen::aligned_allocator<Vector<dim>>> m_points;
+    std::vector<double> m_splits;
+    std::vector<uint8_t> m_axes;
+    std::vector<T> m_nodes;
+
+    std::vector<Vector<dim>, Eigen::aligned_allocator<Vector<dim>>> m_unsortedPoints;
+    std::vector<T> m_unsortedNodes;
+    // metric with its static type, the calls of a final metric are resolved at compile time
+    std::shared_ptr<Metric> m_typedMetric;
+};
+
+/*!
+*  \brief      Default constructor of the class StaticKDTree
+*  \author     Sascha Kaden
+*  \param[in]  DistanceMetric
+*  \date       2017-11-21
+*/
+template <unsigned int dim, class T, class Metric>
+StaticKDTree<dim, T, Metric>::StaticKDTree(const std::shared_ptr<Metric> &distanceMetric)
+    : NeighborFinder<dim, T>("Static KD Tree", distanceMetric), m_typedMetric(distanceMetric) {
+}
+
+/*!
+*  \brief      Constructor of the class StaticKDTree, builds the tree with the passed nodes
+*  \author     Sascha Kaden
+*  \param[in]  DistanceMetric
+*  \param[in]  vector of nodes
+*  \date       2017-11-21
+*/
+template <unsigned int dim, class T, class Metric>
+StaticKDTree<dim, T, Metric>::StaticKDTree(const std::shared_ptr<Metric> &distanceMetric, std::vector<T> &nodes)
+    : NeighborFinder<dim, T>("Static KD Tree", distanceMetric), m_typedMetric(distanceMetric) {
+    rebaseSorted(nodes);
+}
+
+/*!
+*  \brief      Add Node to the unsorted list, it will be part of the tree after the next rebase.
+*  \author     Sascha Kaden
+*  \param[in]  position
+*  \param[in]  pointer to the Node
+*  \date       2017-11-21
+*/
+template <unsigned int dim, class T, class Metric>
+void StaticKDTree<dim, T, Metric>::addNode(const Vector<dim> &config, const T &node) {
+    m_unsortedPoints.push_back(config);
+    m_unsortedNodes.push_back(node);
+}
+
+/*!
+*  \brief      Rebuild the flat tree from the passed nodes, the unsorted list will be cleared.
+*  \author     Sascha Kaden
+*  \param[in]  vector of nodes
+*  \date       2017-11-21
+*/
+template <unsigned int dim, class T, class Metric>
+void StaticKDTree<dim, T, Metric>::rebaseSorted(std::vector<T> &nodes) {
+    std::vector<Vector<dim>, Eigen::aligned_allocator<Vector<dim>>> points;
+    points.reserve(nodes.size());
+    for (auto &node : nodes)
+        points.push_back(node->getValues());
+
+    m_points.resize(nodes.size());
+    m_splits.resize(nodes.size());
+    m_axes.resize(nodes.size());
+    m_nodes.resize(nodes.size());
+
+    if (!nodes.empty()) {
+        std::vector<size_t> order(nodes.size());
+        std::iota(order.begin(), order.end(), 0);
+        build(order, 0, order.size(), 0, points, nodes);
+    }
+
+    m_unsortedPoints.clear();
+    m_unsortedNodes.clear();
+}
+
+/*!
+*  \brief      Builds the subtree of the passed index from the range of the order list (recursive function)
+*  \details    The split axis is the axis with the largest extent, the split element is chosen that the tree is left
+*  complete, so that all indices are smaller than the size. The order list is partitioned in place.
+*  \author     Sascha Kaden
+*  \param[in]  order of the points
+*  \param[in]  begin of the range
+*  \param[in]  end of the range
+*  \param[in]  index of the subtree root
+*  \param[in]  points
+*  \param[in]  nodes
+*  \date       2017-11-21
+*/
+template <unsigned int dim, class T, class Metric>
+void StaticKDTree<dim, T, Metric>::build(std::vector<size_t> &order, const size_t begin, const size_t end, const size_t index,
+                                 const std::vector<Vector<dim>, Eigen::aligned_allocator<Vector<dim>>> &points,
+                                 const std::vector<T> &nodes) {
+    if (begin >= end)
+        return;
+
+    Vector<dim> minBound = points[order[begin]];
+    Vector<dim> maxBound = minBound;
+    for (size_t i = begin + 1; i < end; ++i) {
+        minBound = minBound.cwiseMin(points[order[i]]);
+        maxBound = maxBound.cwiseMax(points[order[i]]);
+    }
+    unsigned int axis;
+    (maxBound - minBound).maxCoeff(&axis);
+
+    size_t median = begin + leftSubtreeSize(end - begin);
+    std::nth_element(order.begin() + begin, order.begin() + median, order.begin() + end,
+                     [&points, axis](size_t a, size_t b) { return points[a][axis] < points[b][axis]; });
+
+    m_points[index] = points[order[median]];
+    m_nodes[index] = nodes[order[median]];
+    m_splits[index] = m_points[index][axis];
+    m_axes[index] = static_cast<uint8_t>(axis);
+
+    build(order, begin, median, 2 * index + 1, points, nodes);
+    build(order, median + 1, end, 2 * index + 2, points, nodes);
+}
+
+/*!
+*  \brief      Search for the nearest neighbor
+*  \author     Sascha Kaden
+*  \param[in]  position
+*  \param[out] pointer to the nearest Node
+*  \date       2017-11-21
+*/
+template <unsigned int dim, class T, class Metric>
+T StaticKDTree<dim, T, Metric>::searchNearestNeighbor(const Vector<dim> &config) {
+    T nearest = nullptr;
+    double bestDist = std::numeric_limits<double>::max();
+
+    for (size_t i = 0; i < m_unsortedPoints.size(); ++i) {
+        double dist = m_typedMetric->calcSimpleDist(config, m_unsortedPoints[i]);
+        if (dist < bestDist && config != m_unsortedPoints[i]) {
+            bestDist = dist;
+            nearest = m_unsortedNodes[i];
+        }
+    }
+    if (m_points.empty())
+        return nearest;
+
+    const double factor = this->getSimpleApproximationFactor();
+    std::pair<size_t, double> stack[m_maxStackSize];
+    size_t stackSize = 0;
+    stack[stackSize++] = std::make_pair(0, 0.0);
+    while (stackSize > 0) {
+        auto entry = stack[--stackSize];
+        if (entry.second * factor >= bestDist)
+            continue;
+
+        size_t index = entry.first;
+        double dist = m_typedMetric->calcSimpleDist(config, m_points[index]);
+        if (dist < bestDist && config != m_points[index]) {
+            bestDist = dist;
+            nearest = m_nodes[index];
+        }
+
+        size_t near = 2 * index + 1;
+        size_t far = near + 1;
+        if (config[m_axes[index]] >= m_splits[index])
+            std::swap(near, far);
+
+        // push the far side first, that the near side is searched first
+        if (far < m_points.size())
+            stack[stackSize++] = std::make_pair(far, planeDist(config, index));
+        if (near < m_points.size())
+            stack[stackSize++] = std::make_pair(near, entry.second);
+    }
+    return nearest;
+}
+
+/*!
+*  \brief      Search for range around a position
+*  \author     Sascha Kaden
+*  \param[in]  position
+*  \param[in]  distance of the range
+*  \param[out] list of near nodes to the position
+*  \date       2017-11-21
+*/
+template <unsigned int dim, class T, class Metric>
+std::vector<T> StaticKDTree<dim, T, Metric>::searchRange(const Vector<dim> &config, double range) {
+    std::vector<T> nodes;
+    m_typedMetric->simplifyDist(range);
+
+    for (size_t i = 0; i < m_unsortedPoints.size(); ++i)
+        if (m_typedMetric->calcSimpleDist(config, m_unsortedPoints[i]) < range && config != m_unsortedPoints[i])
+            nodes.push_back(m_unsortedNodes[i]);
+
+    if (m_points.empty())
+        return nodes;
+
+    size_t stack[m_maxStackSize];
+    size_t stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize > 0) {
+        size_t index = stack[--stackSize];
+        if (m_typedMetric->calcSimpleDist(config, m_points[index]) < range && config != m_points[index])
+            nodes.push_back(m_nodes[index]);
+
+        size_t near = 2 * index + 1;
+        size_t far = near + 1;
+        if (config[m_axes[index]] >= m_splits[index])
+            std::swap(near, far);
+
+        if (far < m_points.size() && planeDist(config, index) < range)
+            stack[stackSize++] = far;
+        if (near < m_points.size())
+            stack[stackSize++] = near;
+    }
+    return nodes;
+}
+
+/*!
+*  \brief      Search for the k nearest neighbors
+*  \author     Sascha Kaden
+*  \param[in]  position
+*  \param[in]  number of neighbors k
+*  \param[out] list of the k nearest nodes to the position, sorted by ascending distance
+*  \date       2017-11-22
+*/
+template <unsigned int dim, class T, class Metric>
+std::vector<T> StaticKDTree<dim, T, Metric>::searchKNearest(const Vector<dim> &config, size_t k) {
+    std::vector<std::pair<double, T>> heap;
+    if (k == 0)
+        return std::vector<T>();
+
+    heap.reserve(k);
+    for (size_t i = 0; i < m_unsortedPoints.size(); ++i)
+        if (config != m_unsortedPoints[i])
+            this->pushKNearest(heap, k, m_typedMetric->calcSimpleDist(config, m_unsortedPoints[i]), m_unsortedNodes[i]);
+
+    if (m_points.empty())
+        return this->sortKNearest(heap);
+
+    const double factor = this->getSimpleApproximationFactor();
+    std::pair<size_t, double> stack[m_maxStackSize];
+    size_t stackSize = 0;
+    stack[stackSize++] = std::make_pair(0, 0.0);
+    while (stackSize > 0) {
+        auto entry = stack[--stackSize];
+        if (heap.size() == k && entry.second * factor >= heap.front().first)
+            continue;
+
+        size_t index = entry.first;
+        if (config != m_points[index])
+            this->pushKNearest(heap, k, m_typedMetric->calcSimpleDist(config, m_points[index]), m_nodes[index]);
+
+        size_t near = 2 * index + 1;
+        size_t far = near + 1;
+        if (config[m_axes[index]] >= m_splits[index])
+            std::swap(near, far);
+
+        if (far < m_points.size())
+            stack[stackSize++] = std::make_pair(far, planeDist(config, index));
+        if (near < m_points.size())
+            stack[stackSize++] = std::make_pair(near, entry.second);
+    }
+    return this->sortKNearest(heap);
+}
+
+/*!
+*  \brief      Return the number of nodes inside of the tree and the unsorted list
+*  \author     Sascha Kaden
+*  \param[out] size
+*  \date       2017-11-21
+*/
+template <unsigned int dim, class T, class Metric>
+size_t StaticKDTree<dim, T, Metric>::size() const {
+    return m_points.size() + m_unsortedPoints.size();
+}
+
+/*!
+*  \brief      Return the simplified distance from the position to the split plane of the tree node
+*  \details    The distance of the single axis offset is a lower bound of all metrics, also of the weighted ones.
+*  \author     Sascha Kaden
+*  \param[in]  position
+*  \param[in]  index of the tree node
+*  \param[out] simplified distance
+*  \date       2017-11-21
+*/
+template <unsigned int dim, class T, class Metric>
+double StaticKDTree<dim, T, Metric>::planeDist(const Vector<dim> &config, const size_t index) const {
+    Vector<dim> projection = config;
+    projection[m_axes[index]] = m_splits[index];
+    return m_typedMetric->calcSimpleDist(config, projection);
+}
+
+/*!
+*  \brief      Return the size of the left subtree of a left complete binary tree with the passed size
+*  \author     Sascha Kaden
+*  \param[in]  size of the tree
+*  \param[out] size of the left subtree
+*  \date       2017-11-21
+*/
+template <unsigned int dim, class T, class Metric>
+size_t StaticKDTree<dim, T, Metric>::leftSubtreeSize(const size_t size) {
+    if (size <= 1)
+        return 0;
+
+    size_t height = 0;
+    while ((size_t(2) << height) <= size)
+        ++height;
+    // nodes of the full levels and of the last level
+    size_t fullNodes = (size_t(1) << height) - 1;
+    size_t lastLevel = size - fullNodes;
+    size_t halfLastLevel = size_t(1) << (height - 1);
+    return (halfLastLevel - 1) + std::min(lastLevel, halfLastLevel);
+}
+
+} /* namespace ippp */
+
+#endif /* STATICKDTREE_HPP */
@@ -80,9 +80,11 @@ Vector<dim> GaussianSampling<dim>::getSample() {
         ray *= m_distance * m_sampler->getRandomNumber();
         sample2 = sample1 + ray;
 
-        if (!m_collision->checkConfig(sample1) && m_collision->checkConfig(sample2))
+        // both samples are checked in one batch, each of them once
+        std::vector<bool> validity = m_collision->checkConfigs(std::vector<Vector<dim>>({sample1, sample2}));
+        if (validity[0] && !validity[1])
             return sample1;
-        else if (m_collision->checkConfig(sample1) && !m_collision->checkConfig(sample2))
+        else if (!validity[0] && validity[1])
             return sample2;
     }
     return util::NaNVector<dim>();
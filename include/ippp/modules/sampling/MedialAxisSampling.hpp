@@ -86,13 +86,15 @@ Vector<dim> MedialAxisSampling<dim>::getSample() {
 
     // calculate the nearest obstacle position with the computed directions
     while (collision == sampleCollision) {
-        auto temp = tempConfigs.begin();
-        for (auto dir = m_directions.begin(); dir < m_directions.end(); ++dir, ++temp) {
-            *temp += *dir;
-            if (m_collision->checkConfig(*temp) != sampleCollision) {
+        for (size_t i = 0; i < tempConfigs.size(); ++i)
+            tempConfigs[i] += m_directions[i];
+        // all directions of one step are checked as batch
+        std::vector<bool> validity = m_collision->checkConfigs(tempConfigs);
+        for (size_t i = 0; i < tempConfigs.size(); ++i) {
+            if (validity[i] == sampleCollision) {
                 // set the first collision vector and the direction and break the while loop
-                first = *temp;
-                direction = *dir;
+                first = tempConfigs[i];
+                direction = m_directions[i];
                 collision = !sampleCollision;
                 break;
             }
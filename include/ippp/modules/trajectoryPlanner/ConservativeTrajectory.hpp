@@ -0,0 +1,182 @@
+//-------------------------------------------------------------------------//
+//
+// Copyright 2017 Sascha Kaden
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-------------------------------------------------------------------------//
+
+#ifndef CONSERVATIVETRAJECTORY_HPP
+#define CONSERVATIVETRAJECTORY_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <ippp/modules/trajectoryPlanner/TrajectoryPlanner.hpp>
+
+namespace ippp {
+
+/*!
+* \brief   Class ConservativeTrajectory plans a linear path and validates it continuously by conservative advancement.
+* \details Along the edge the clearance of the robot is computed by the CollisionDetection and the edge is advanced by
+* the clearance divided by the motion bound of the robot. No point of the robot can reach an obstacle inside of the
+* step, an edge is only valid if the advancement reaches its end. Edges with a clearance smaller than the minimal
+* clearance are invalid. If the CollisionDetection doesn't compute distances, the discrete check of the
+* TrajectoryPlanner is used.
+* \author  Sascha Kaden
+* \date    2017-12-08
+*/
+template <unsigned int dim>
+class ConservativeTrajectory : public TrajectoryPlanner<dim> {
+  public:
+    ConservativeTrajectory(const std::shared_ptr<CollisionDetection<dim>> &collision,
+                           const std::shared_ptr<Environment> &environment, const double posRes = 1,
+                           const double oriRes = 0.1, const double minClearance = 0.01, const double tolerance = 0);
+
+    using TrajectoryPlanner<dim>::checkTrajectory;
+    bool checkTrajectory(const Vector<dim> &source, const Vector<dim> &target) override;
+
+    std::vector<Vector<dim>> calcTrajectoryCont(const Vector<dim> &source, const Vector<dim> &target) override;
+    std::vector<Vector<dim>> calcTrajectoryBin(const Vector<dim> &source, const Vector<dim> &target) override;
+
+    void setMinClearance(const double minClearance);
+    double getMinClearance() const;
+
+  private:
+    double m_minClearance = 0.01;
+    CollisionRequest m_distanceRequest;
+
+    using TrajectoryPlanner<dim>::m_collision;
+    using TrajectoryPlanner<dim>::m_environment;
+    using TrajectoryPlanner<dim>::m_posRes;
+    using TrajectoryPlanner<dim>::m_oriRes;
+    using TrajectoryPlanner<dim>::m_posMask;
+    using TrajectoryPlanner<dim>::m_oriMask;
+};
+
+/*!
+*  \brief      Constructor of the class ConservativeTrajectory
+*  \author     Sascha Kaden
+*  \param[in]  CollisionDetection
+*  \param[in]  Environment
+*  \param[in]  position resolution
+*  \param[in]  orientation resolution
+*  \param[in]  minimal clearance of valid edges
+*  \param[in]  absolute tolerance of the distance queries
+*  \date       2017-12-08
+*/
+template <unsigned int dim>
+ConservativeTrajectory<dim>::ConservativeTrajectory(const std::shared_ptr<CollisionDetection<dim>> &collision,
+                                                    const std::shared_ptr<Environment> &environment, const double posRes,
+                                                    const double oriRes, const double minClearance, const double tolerance)
+    : TrajectoryPlanner<dim>("ConservativeTrajectory", collision, environment, posRes, oriRes) {
+    setMinClearance(minClearance);
+    m_distanceRequest.computeDistance = true;
+    m_distanceRequest.distanceTolerance = std::max(0.0, tolerance);
+}
+
+/*!
+*  \brief      Validate the edge by conservative advancement, return true if it is collision free.
+*  \details    In contrast to the discrete check, source and target are part of the validation.
+*  \author     Sascha Kaden
+*  \param[in]  source Vector
+*  \param[in]  target Vector
+*  \param[out] possibility of trajectory, true if possible
+*  \date       2017-12-08
+*/
+template <unsigned int dim>
+bool ConservativeTrajectory<dim>::checkTrajectory(const Vector<dim> &source, const Vector<dim> &target) {
+    double bound = m_environment->getRobot()->getMotionBound(source, target);
+    if (!std::isfinite(bound))
+        return TrajectoryPlanner<dim>::checkTrajectory(source, target);
+
+    Vector<dim> delta = target - source;
+    double t = 0;
+    while (true) {
+        CollisionRequest request = m_distanceRequest;
+        CollisionResult result;
+        if (m_collision->checkConfig(source + t * delta, &request, &result))
+            return false;
+        if (result.minDist == std::numeric_limits<double>::max())
+            return TrajectoryPlanner<dim>::checkTrajectory(source, target);
+        if (t >= 1 || bound == 0)
+            return true;
+
+        // the distance query can overestimate the clearance by its tolerance
+        double clearance = result.minDist - m_distanceRequest.distanceTolerance;
+        if (clearance < m_minClearance)
+            return false;
+        t = std::min(1.0, t + clearance / bound);
+    }
+}
+
+/*!
+*  \brief      Compute the linear continuous trajectory between source and target. Return vector of points.
+*  \author     Sascha Kaden
+*  \param[in]  source Vector
+*  \param[in]  target Vector
+*  \param[out] trajectory
+*  \date       2017-12-08
+*/
+template <unsigned int dim>
+std::vector<Vector<dim>> ConservativeTrajectory<dim>::calcTrajectoryCont(const Vector<dim> &source,
+                                                                         const Vector<dim> &target) {
+    return util::linearTrajectoryCont<dim>(source, target, m_posRes, m_oriRes, m_posMask, m_oriMask);
+}
+
+/*!
+*  \brief      Compute the linear binary (section wise) trajectory between source and target. Return vector of points.
+*  \author     Sascha Kaden
+*  \param[in]  source Vector
+*  \param[in]  target Vector
+*  \param[out] trajectory
+*  \date       2017-12-08
+*/
+template <unsigned int dim>
+std::vector<Vector<dim>> ConservativeTrajectory<dim>::calcTrajectoryBin(const Vector<dim> &source,
+                                                                        const Vector<dim> &target) {
+    return util::linearTrajectoryBin<dim>(source, target, m_posRes, m_oriRes, m_posMask, m_oriMask);
+}
+
+/*!
+*  \brief      Set the minimal clearance, edges closer to the obstacles are invalid.
+*  \details    The minimal clearance has to be larger than 0, otherwise the advancement wouldn't terminate at contacts.
+*  \author     Sascha Kaden
+*  \param[in]  minimal clearance
+*  \date       2017-12-08
+*/
+template <unsigned int dim>
+void ConservativeTrajectory<dim>::setMinClearance(const double minClearance) {
+    if (minClearance <= 0) {
+        m_minClearance = 0.01;
+        Logging::warning("Minimal clearance has to be larger than 0, it was set to 0.01!", this);
+    } else {
+        m_minClearance = minClearance;
+    }
+}
+
+/*!
+*  \brief      Return the minimal clearance
+*  \author     Sascha Kaden
+*  \param[out] minimal clearance
+*  \date       2017-12-08
+*/
+template <unsigned int dim>
+double ConservativeTrajectory<dim>::getMinClearance() const {
+    return m_minClearance;
+}
+
+} /* namespace ippp */
+
+#endif /* CONSERVATIVETRAJECTORY_HPP */
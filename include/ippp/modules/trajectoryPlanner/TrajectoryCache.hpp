@@ -0,0 +1,240 @@
+//-------------------------------------------------------------------------//
+//
+// Copyright 2017 Sascha Kaden
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-------------------------------------------------------------------------//
+
+#ifndef TRAJECTORYCACHE_HPP
+#define TRAJECTORYCACHE_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#include <ippp/dataObj/ShardedCache.hpp>
+#include <ippp/modules/trajectoryPlanner/TrajectoryPlanner.hpp>
+
+namespace ippp {
+
+/*!
+* \brief   Decorator of a TrajectoryPlanner, which caches the validity of the checked edges.
+* \details The edges are keyed by the exact values of their end points, the results are stored inside of a
+* ShardedCache. With a symmetric planner both directions of an edge share one entry. One instance can be passed to
+* all planners, samplings and path modifiers. The cache has to be cleared, if the Environment was modified.
+* \author  Sascha Kaden
+* \date    2017-12-06
+*/
+template <unsigned int dim>
+class TrajectoryCache : public TrajectoryPlanner<dim> {
+  public:
+    TrajectoryCache(const std::shared_ptr<TrajectoryPlanner<dim>> &trajectory,
+                    const std::shared_ptr<CollisionDetection<dim>> &collision,
+                    const std::shared_ptr<Environment> &environment, const size_t capacity = 1000000,
+                    const bool symmetric = true);
+
+    using TrajectoryPlanner<dim>::checkTrajectory;
+    bool checkTrajectory(const Vector<dim> &source, const Vector<dim> &target) override;
+
+    std::vector<Vector<dim>> calcTrajectoryCont(const Vector<dim> &source, const Vector<dim> &target) override;
+    std::vector<Vector<dim>> calcTrajectoryBin(const Vector<dim> &source, const Vector<dim> &target) override;
+
+    size_t getHits() const;
+    size_t getMisses() const;
+    void resetCounters();
+    void clear();
+
+  private:
+    using Key = std::array<double, 2 * dim>;
+
+    struct KeyHash {
+        size_t operator()(const Key &key) const;
+    };
+
+    Key createKey(const Vector<dim> &source, const Vector<dim> &target) const;
+
+    std::shared_ptr<TrajectoryPlanner<dim>> m_trajectory;
+    bool m_symmetric;
+    ShardedCache<Key, bool, KeyHash> m_cache;
+    std::atomic<size_t> m_hits;
+    std::atomic<size_t> m_misses;
+};
+
+/*!
+*  \brief      Constructor of the class TrajectoryCache
+*  \details    The resolutions are taken from the decorated TrajectoryPlanner. Planners with direction dependent
+*  trajectories like RotateAtS have to be passed with symmetric set to false.
+*  \author     Sascha Kaden
+*  \param[in]  decorated TrajectoryPlanner
+*  \param[in]  CollisionDetection
+*  \param[in]  Environment
+*  \param[in]  maximal number of cached edges
+*  \param[in]  true if the trajectory of an edge is independent of the direction
+*  \date       2017-12-06
+*/
+template <unsigned int dim>
+TrajectoryCache<dim>::TrajectoryCache(const std::shared_ptr<TrajectoryPlanner<dim>> &trajectory,
+                                      const std::shared_ptr<CollisionDetection<dim>> &collision,
+                                      const std::shared_ptr<Environment> &environment, const size_t capacity,
+                                      const bool symmetric)
+    : TrajectoryPlanner<dim>("TrajectoryCache", collision, environment, trajectory->getPosRes(), trajectory->getOriRes()),
+      m_trajectory(trajectory),
+      m_symmetric(symmetric),
+      m_cache(capacity),
+      m_hits(0),
+      m_misses(0) {
+}
+
+/*!
+*  \brief      Control the trajectory and return if possible or not, the result is taken from the cache if possible.
+*  \author     Sascha Kaden
+*  \param[in]  source Vector
+*  \param[in]  target Vector
+*  \param[out] possibility of trajectory, true if possible
+*  \date       2017-12-06
+*/
+template <unsigned int dim>
+bool TrajectoryCache<dim>::checkTrajectory(const Vector<dim> &source, const Vector<dim> &target) {
+    Key key = createKey(source, target);
+    bool valid;
+    if (m_cache.find(key, valid)) {
+        ++m_hits;
+        return valid;
+    }
+
+    ++m_misses;
+    valid = m_trajectory->checkTrajectory(source, target);
+    m_cache.insert(key, valid);
+    return valid;
+}
+
+/*!
+*  \brief      Compute the continuous trajectory with the decorated TrajectoryPlanner.
+*  \author     Sascha Kaden
+*  \param[in]  source Vector
+*  \param[in]  target Vector
+*  \param[out] trajectory
+*  \date       2017-12-06
+*/
+template <unsigned int dim>
+std::vector<Vector<dim>> TrajectoryCache<dim>::calcTrajectoryCont(const Vector<dim> &source, const Vector<dim> &target) {
+    return m_trajectory->calcTrajectoryCont(source, target);
+}
+
+/*!
+*  \brief      Compute the binary trajectory with the decorated TrajectoryPlanner.
+*  \author     Sascha Kaden
+*  \param[in]  source Vector
+*  \param[in]  target Vector
+*  \param[out] trajectory
+*  \date       2017-12-06
+*/
+template <unsigned int dim>
+std::vector<Vector<dim>> TrajectoryCache<dim>::calcTrajectoryBin(const Vector<dim> &source, const Vector<dim> &target) {
+    return m_trajectory->calcTrajectoryBin(source, target);
+}
+
+/*!
+*  \brief      Return the number of cache hits
+*  \author     Sascha Kaden
+*  \param[out] hits
+*  \date       2017-12-06
+*/
+template <unsigned int dim>
+size_t TrajectoryCache<dim>::getHits() const {
+    return m_hits;
+}
+
+/*!
+*  \brief      Return the number of cache misses
+*  \author     Sascha Kaden
+*  \param[out] misses
+*  \date       2017-12-06
+*/
+template <unsigned int dim>
+size_t TrajectoryCache<dim>::getMisses() const {
+    return m_misses;
+}
+
+/*!
+*  \brief      Reset the hit and miss counters
+*  \author     Sascha Kaden
+*  \date       2017-12-06
+*/
+template <unsigned int dim>
+void TrajectoryCache<dim>::resetCounters() {
+    m_hits = 0;
+    m_misses = 0;
+}
+
+/*!
+*  \brief      Remove all cached edges, has to be called after the Environment was modified.
+*  \author     Sascha Kaden
+*  \date       2017-12-06
+*/
+template <unsigned int dim>
+void TrajectoryCache<dim>::clear() {
+    m_cache.clear();
+}
+
+/*!
+*  \brief      Create the key of the edge, with a symmetric planner the lexicographical smaller end point is first.
+*  \author     Sascha Kaden
+*  \param[in]  source Vector
+*  \param[in]  target Vector
+*  \param[out] key
+*  \date       2017-12-06
+*/
+template <unsigned int dim>
+typename TrajectoryCache<dim>::Key TrajectoryCache<dim>::createKey(const Vector<dim> &source, const Vector<dim> &target) const {
+    bool swap = m_symmetric && std::lexicographical_compare(target.data(), target.data() + dim, source.data(),
+                                                            source.data() + dim);
+    const Vector<dim> &first = swap ? target : source;
+    const Vector<dim> &second = swap ? source : target;
+
+    Key key;
+    for (unsigned int i = 0; i < dim; ++i) {
+        key[i] = first[i];
+        key[dim + i] = second[i];
+    }
+    return key;
+}
+
+/*!
+*  \brief      Hash of the end points of an edge
+*  \author     Sascha Kaden
+*  \param[in]  key
+*  \param[out] hash
+*  \date       2017-12-06
+*/
+template <unsigned int dim>
+size_t TrajectoryCache<dim>::KeyHash::operator()(const Key &key) const {
+    uint64_t hash = 14695981039346656037ULL;
+    for (auto value : key) {
+        // -0.0 and 0.0 are equal keys
+        if (value == 0)
+            value = 0;
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        hash ^= bits;
+        hash *= 1099511628211ULL;
+    }
+    return static_cast<size_t>(hash ^ (hash >> 29));
+}
+
+} /* namespace ippp */
+
+#endif /* TRAJECTORYCACHE_HPP */
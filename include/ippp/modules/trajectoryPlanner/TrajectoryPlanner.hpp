@@ -19,6 +19,13 @@
 #ifndef TRAJECTORYPLANNER_HPP
 #define TRAJECTORYPLANNER_HPP
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <thread>
+
 #include <ippp/Identifier.h>
 #include <ippp/modules/collisionDetection/CollisionDetection.hpp>
 #include <ippp/types.h>
@@ -37,10 +44,11 @@ class TrajectoryPlanner : public Identifier {
   public:
     TrajectoryPlanner(const std::string &name, const std::shared_ptr<CollisionDetection<dim>> &collision,
                       const std::shared_ptr<Environment> &environment, const double posRes = 1, const double oriRes = 0.1);
+    ~TrajectoryPlanner();
 
     bool checkTrajectory(const Node<dim> &source, const Node<dim> &target);
     bool checkTrajectory(const std::shared_ptr<Node<dim>> &source, const std::shared_ptr<Node<dim>> &target);
-    bool checkTrajectory(const Vector<dim> &source, const Vector<dim> &target);
+    virtual bool checkTrajectory(const Vector<dim> &source, const Vector<dim> &target);
 
     Vector<dim> checkTrajCont(const Node<dim> &source, const Node<dim> &target);
     Vector<dim> checkTrajCont(const std::shared_ptr<Node<dim>> &source, const std::shared_ptr<Node<dim>> &target);
@@ -53,8 +61,16 @@ class TrajectoryPlanner : public Identifier {
     double getPosRes() const;
     double getOriRes() const;
     std::pair<double, double> getResolutions() const;
+    void setParallelValidation(const size_t numThreads, const double minLength);
+    size_t getParallelThreads() const;
+    double getParallelLength() const;
 
   protected:
+    bool checkTrajectoryParallel(const std::vector<Vector<dim>> &path);
+    void checkChunks();
+    void runWorker();
+    void stopWorkers();
+
     std::shared_ptr<CollisionDetection<dim>> m_collision = nullptr;
     std::shared_ptr<Environment> m_environment = nullptr;
 
@@ -65,6 +81,24 @@ class TrajectoryPlanner : public Identifier {
 
     Vector<dim> m_posMask;
     Vector<dim> m_oriMask;
+
+    size_t m_parallelThreads = 1;
+    double m_parallelLength = std::numeric_limits<double>::max();
+
+    // persistent workers of the parallel validation, one trajectory is checked by the pool at a time
+    std::vector<std::thread> m_workers;
+    std::mutex m_parallelMutex;
+    std::mutex m_poolMutex;
+    std::condition_variable m_jobCondition;
+    std::condition_variable m_doneCondition;
+    const std::vector<Vector<dim>> *m_jobPath = nullptr;
+    size_t m_jobChunks = 0;
+    size_t m_jobCount = 0;
+    size_t m_activeWorkers = 0;
+    bool m_stopWorkers = false;
+    std::atomic<size_t> m_nextChunk{0};
+    std::atomic<bool> m_jobCollision{false};
+    static const size_t m_chunkSize = 16;
 };
 
 /*!
@@ -90,6 +124,16 @@ TrajectoryPlanner<dim>::TrajectoryPlanner(const std::string &name, const std::sh
     m_oriMask = masks.second;
 }
 
+/*!
+*  \brief      Destructor of the class TrajectoryPlanner, stops the workers of the parallel validation.
+*  \author     Sascha Kaden
+*  \date       2017-12-18
+*/
+template <unsigned int dim>
+TrajectoryPlanner<dim>::~TrajectoryPlanner() {
+    stopWorkers();
+}
+
 /*!
 *  \brief      Control the trajectory and return if possible or not
 *  \author     Sascha Kaden
@@ -127,12 +171,109 @@ bool TrajectoryPlanner<dim>::checkTrajectory(const std::shared_ptr<Node<dim>> &s
 template <unsigned int dim>
 bool TrajectoryPlanner<dim>::checkTrajectory(const Vector<dim> &source, const Vector<dim> &target) {
     auto path = calcTrajectoryBin(source, target);
+    if (m_parallelThreads > 1 && (target - source).norm() >= m_parallelLength)
+        return checkTrajectoryParallel(path);
+
     if (m_collision->checkTrajectory(path))
         return false;
 
     return true;
 }
 
+/*!
+*  \brief      Control the configurations of the trajectory with several threads and return if possible or not.
+*  \details    The workers of the pool take chunks of the bisection ordered path in their order, the coarse
+*  configurations are checked first. The chunks are passed as index ranges of the path. The first found collision stops
+*  all workers. If the pool is busy with the trajectory of another thread, the trajectory is checked serial. The
+*  CollisionDetection has to be thread safe.
+*  \author     Sascha Kaden
+*  \param[in]  configurations of the trajectory
+*  \param[out] possibility of trajectory, true if possible
+*  \date       2017-12-03
+*/
+template <unsigned int dim>
+bool TrajectoryPlanner<dim>::checkTrajectoryParallel(const std::vector<Vector<dim>> &path) {
+    std::unique_lock<std::mutex> parallelLock(m_parallelMutex, std::try_to_lock);
+    if (!parallelLock.owns_lock() || m_workers.empty())
+        return !m_collision->checkTrajectoryRange(path, 0, path.size());
+
+    {
+        std::lock_guard<std::mutex> lock(m_poolMutex);
+        m_jobPath = &path;
+        m_jobChunks = (path.size() + m_chunkSize - 1) / m_chunkSize;
+        m_nextChunk = 0;
+        m_jobCollision = false;
+        m_activeWorkers = m_workers.size();
+        ++m_jobCount;
+    }
+    m_jobCondition.notify_all();
+
+    // the calling thread works as one of the threads
+    checkChunks();
+
+    std::unique_lock<std::mutex> lock(m_poolMutex);
+    m_doneCondition.wait(lock, [this]() { return m_activeWorkers == 0; });
+    m_jobPath = nullptr;
+    return !m_jobCollision;
+}
+
+/*!
+*  \brief      Check the chunks of the current trajectory until all are taken or a collision was found.
+*  \details    Small chunks keep the order of the bisection and the delay until a collision is noticed short.
+*  \author     Sascha Kaden
+*  \date       2017-12-18
+*/
+template <unsigned int dim>
+void TrajectoryPlanner<dim>::checkChunks() {
+    for (size_t index = m_nextChunk++; index < m_jobChunks && !m_jobCollision; index = m_nextChunk++) {
+        size_t begin = index * m_chunkSize;
+        size_t end = std::min(m_jobPath->size(), begin + m_chunkSize);
+        if (m_collision->checkTrajectoryRange(*m_jobPath, begin, end))
+            m_jobCollision = true;
+    }
+}
+
+/*!
+*  \brief      Loop of a worker of the parallel validation, waits for the next trajectory until the pool is stopped.
+*  \author     Sascha Kaden
+*  \date       2017-12-18
+*/
+template <unsigned int dim>
+void TrajectoryPlanner<dim>::runWorker() {
+    size_t jobCount = 0;
+    std::unique_lock<std::mutex> lock(m_poolMutex);
+    while (true) {
+        m_jobCondition.wait(lock, [&]() { return m_stopWorkers || m_jobCount != jobCount; });
+        if (m_stopWorkers)
+            return;
+
+        jobCount = m_jobCount;
+        lock.unlock();
+        checkChunks();
+        lock.lock();
+        if (--m_activeWorkers == 0)
+            m_doneCondition.notify_one();
+    }
+}
+
+/*!
+*  \brief      Stop and join the workers of the parallel validation.
+*  \author     Sascha Kaden
+*  \date       2017-12-18
+*/
+template <unsigned int dim>
+void TrajectoryPlanner<dim>::stopWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(m_poolMutex);
+        m_stopWorkers = true;
+    }
+    m_jobCondition.notify_all();
+    for (auto &worker : m_workers)
+        worker.join();
+    m_workers.clear();
+    m_stopWorkers = false;
+}
+
 /*!
 *  \brief      Control the linear trajectory and return the last collision valid point.
 *  \author     Sascha Kaden
@@ -245,6 +386,54 @@ std::pair<double, double> TrajectoryPlanner<dim>::getResolutions() const {
     return std::make_pair(m_posRes, m_oriRes);
 }
 
+/*!
+*  \brief      Set the parallel validation of long trajectories.
+*  \details    Trajectories with a length of at least minLength are checked by numThreads threads, the others
+*  serial. The numThreads - 1 workers are started once and kept by the planner, the calling thread is the last one.
+*  Waking the workers costs time, short trajectories are faster checked by one thread.
+*  \author     Sascha Kaden
+*  \param[in]  number of threads
+*  \param[in]  minimal length of the trajectory
+*  \date       2017-12-03
+*/
+template <unsigned int dim>
+void TrajectoryPlanner<dim>::setParallelValidation(const size_t numThreads, const double minLength) {
+    if (numThreads == 0) {
+        m_parallelThreads = 1;
+        Logging::warning("Number of threads has to be larger than 0, it was set to 1!", this);
+    } else {
+        m_parallelThreads = numThreads;
+    }
+    m_parallelLength = minLength;
+
+    std::lock_guard<std::mutex> parallelLock(m_parallelMutex);
+    stopWorkers();
+    for (size_t i = 1; i < m_parallelThreads; ++i)
+        m_workers.push_back(std::thread(&TrajectoryPlanner<dim>::runWorker, this));
+}
+
+/*!
+*  \brief      Return the number of threads of the parallel trajectory validation
+*  \author     Sascha Kaden
+*  \param[out] number of threads
+*  \date       2017-12-03
+*/
+template <unsigned int dim>
+size_t TrajectoryPlanner<dim>::getParallelThreads() const {
+    return m_parallelThreads;
+}
+
+/*!
+*  \brief      Return the minimal trajectory length of the parallel trajectory validation
+*  \author     Sascha Kaden
+*  \param[out] minimal length
+*  \date       2017-12-03
+*/
+template <unsigned int dim>
+double TrajectoryPlanner<dim>::getParallelLength() const {
+    return m_parallelLength;
+}
+
 } /* namespace ippp */
 
 #endif /* TRAJECTORYPLANNER_HPP */
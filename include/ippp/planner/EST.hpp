@@ -123,7 +123,7 @@ void EST<dim>::computeTreeThread(const size_t nbOfNodes) {
         if (!m_trajectory->checkTrajectory(randNode->getValues(), sample))
             continue;
 
-        std::shared_ptr<Node<dim>> newNode(new Node<dim>(sample));
+        std::shared_ptr<Node<dim>> newNode = m_graph->makeNode(sample);
         newNode->setParent(randNode, m_metric->calcDist(sample, randNode->getValues()));
         m_mutex.lock();
         randNode->addChild(newNode, m_metric->calcDist(randNode->getValues(), sample));
@@ -147,9 +147,8 @@ bool EST<dim>::connectGoalNode(Vector<dim> goal) {
         return false;
     }
 
-    std::shared_ptr<Node<dim>> goalNode(new Node<dim>(goal));
     // Todo: add option for the connection distance of the goal node
-    std::vector<std::shared_ptr<Node<dim>>> nearNodes = m_graph->getNearNodes(goalNode, 100);
+    std::vector<std::shared_ptr<Node<dim>>> nearNodes = m_graph->getNearNodes(goal, 100);
 
     std::shared_ptr<Node<dim>> nearestNode = nullptr;
     for (auto node : nearNodes) {
@@ -160,6 +159,7 @@ bool EST<dim>::connectGoalNode(Vector<dim> goal) {
     }
 
     if (nearestNode != nullptr) {
+        std::shared_ptr<Node<dim>> goalNode = m_graph->makeNode(goal);
         goalNode->setParent(nearestNode, this->m_metric->calcDist(nearestNode, goalNode));
         m_goalNode = goalNode;
         m_graph->addNode(goalNode);
@@ -19,6 +19,8 @@
 #ifndef PRM_HPP
 #define PRM_HPP
 
+#include <algorithm>
+
 #include <ippp/planner/Planner.hpp>
 #include <ippp/planner/options/PRMOptions.hpp>
 
@@ -26,6 +28,8 @@ namespace ippp {
 
 /*!
 * \brief   Class PRM
+* \details A frozen roadmap isn't modified anymore, it can serve queryRoadmap() from several threads at the same time.
+* With the lazy validation the edges of the roadmap are added unchecked, only the edges of the A* paths are validated.
 * \author  Sascha Kaden
 * \date    2016-08-09
 */
@@ -42,6 +46,10 @@ class PRM : public Planner<dim> {
     void startPlannerPhase(const size_t nbOfThreads = 1);
 
     bool queryPath(const Vector<dim> start, const Vector<dim> goal);
+    std::vector<std::shared_ptr<Node<dim>>> queryRoadmap(const Vector<dim> &start, const Vector<dim> &goal) const;
+
+    void setFrozen(const bool frozen);
+    bool isFrozen() const;
 
     std::vector<std::shared_ptr<Node<dim>>> getPathNodes();
     std::vector<Vector<dim>> getPath(const double posRes = 1, const double oriRes = 0.1);
@@ -50,9 +58,17 @@ class PRM : public Planner<dim> {
     void samplingPhase(const size_t nbOfNodes);
     void plannerPhase(const size_t startNodeIndex, const size_t endNodeIndex);
     std::shared_ptr<Node<dim>> connectNode(const Vector<dim> &config);
+    std::vector<std::shared_ptr<Node<dim>>> getNearNodes(const std::shared_ptr<Node<dim>> &node) const;
+    bool validateEdge(const std::shared_ptr<Node<dim>> &source, const std::shared_ptr<Node<dim>> &target);
+    bool validatePath(const std::vector<std::shared_ptr<Node<dim>>> &path);
+    void validateEdges();
 
     double m_rangeSize;
+    NeighborSearch m_neighborSearch;
     std::vector<std::shared_ptr<Node<dim>>> m_nodePath;
+    bool m_frozen = false;
+    bool m_lazyValidation = false;
+    util::AStarFunction<dim> m_aStar;
 
     using Planner<dim>::m_collision;
     using Planner<dim>::m_environment;
@@ -78,6 +94,9 @@ PRM<dim>::PRM(const std::shared_ptr<Environment> &environment, const PRMOptions<
               const std::shared_ptr<Graph<dim>> &graph)
     : Planner<dim>("PRM", environment, options, graph) {
     m_rangeSize = options.getRangeSize();
+    m_neighborSearch = options.getNeighborSearch();
+    m_lazyValidation = options.getLazyValidation();
+    m_aStar = util::makeAStar<dim>(m_metric);
 }
 
 /*!
@@ -92,6 +111,9 @@ PRM<dim>::PRM(const std::shared_ptr<Environment> &environment, const PRMOptions<
 */
 template <unsigned int dim>
 bool PRM<dim>::computePath(const Vector<dim> start, const Vector<dim> goal, const size_t numNodes, const size_t numThreads) {
+    if (m_frozen)
+        return queryPath(start, goal);
+
     std::vector<Vector<dim>> query = {start, goal};
     m_evaluator->setQuery(query);
 
@@ -117,6 +139,11 @@ bool PRM<dim>::computePath(const Vector<dim> start, const Vector<dim> goal, cons
 */
 template <unsigned int dim>
 bool PRM<dim>::expand(const size_t numNodes, const size_t numThreads) {
+    if (m_frozen) {
+        Logging::warning("Roadmap is frozen and can't be expanded", this);
+        return false;
+    }
+
     startSamplingPhase(numNodes, numThreads);
     m_graph->sortTree();
     startPlannerPhase(numThreads);
@@ -149,21 +176,21 @@ void PRM<dim>::startSamplingPhase(const size_t nbOfNodes, const size_t nbOfThrea
 
 /*!
 *  \brief      Sampling thread function
+*  \details    The samples are checked as one batch by the collision detection.
 *  \author     Sascha Kaden
 *  \param[in]  number of Nodes to be sampled
 *  \date       2016-08-09
 */
 template <unsigned int dim>
 void PRM<dim>::samplingPhase(const size_t nbOfNodes) {
-    Vector<dim> sample;
-    for (size_t i = 0; i < nbOfNodes; ++i) {
-        sample = m_sampling->getSample();
-        if (util::empty<dim>(sample))
-            continue;
-
-        if (!m_collision->checkConfig(sample))
-            m_graph->addNode(std::shared_ptr<Node<dim>>(new Node<dim>(sample)));
-    }
+    std::vector<Vector<dim>> samples = m_sampling->getSamples(nbOfNodes);
+    auto isEmpty = [](const Vector<dim> &sample) { return util::empty<dim>(sample); };
+    samples.erase(std::remove_if(samples.begin(), samples.end(), isEmpty), samples.end());
+
+    std::vector<bool> validity = m_collision->checkConfigs(samples);
+    for (size_t i = 0; i < samples.size(); ++i)
+        if (validity[i])
+            m_graph->addNode(m_graph->makeNode(samples[i]));
 }
 
 /*!
@@ -192,7 +219,8 @@ void PRM<dim>::startPlannerPhase(const size_t nbOfThreads) {
 
 /*!
 *  \brief      Local planning thread function
-*  \details    Searches the nearest neighbors between the given indexes and adds them as childes
+*  \details    Searches the nearest neighbors between the given indexes and adds them as childes, with the lazy validation
+*  the edges aren't checked.
 *  \author     Sascha Kaden
 *  \param[in]  start index
 *  \param[in]  end index
@@ -212,12 +240,14 @@ void PRM<dim>::plannerPhase(const size_t startNodeIndex, const size_t endNodeInd
     }
 
     for (auto node = nodes.begin() + startNodeIndex; node != nodes.begin() + endNodeIndex; ++node) {
-        std::vector<std::shared_ptr<Node<dim>>> nearNodes = m_graph->getNearNodes(*node, m_rangeSize);
+        std::vector<std::shared_ptr<Node<dim>>> nearNodes = getNearNodes(*node);
         for (auto &nearNode : nearNodes) {
             if ((*node)->isChild(nearNode) || (*node)->isInvalidChild(nearNode))
                 continue;
 
-            if (m_trajectory->checkTrajectory((*node)->getValues(), nearNode->getValues()))
+            if (m_lazyValidation)
+                (*node)->addChild(nearNode, m_metric->calcDist(nearNode, (*node)), EdgeState::Unknown);
+            else if (m_trajectory->checkTrajectory((*node)->getValues(), nearNode->getValues()))
                 (*node)->addChild(nearNode, m_metric->calcDist(nearNode, (*node)));
             else
                 (*node)->addInvalidChild(nearNode);
@@ -225,9 +255,25 @@ void PRM<dim>::plannerPhase(const size_t startNodeIndex, const size_t endNodeInd
     }
 }
 
+/*!
+*  \brief      Return the neighbors of the passed Node, inside of the range size or the k nearest neighbors
+*  \author     Sascha Kaden
+*  \param[in]  Node
+*  \param[out] list of near nodes
+*  \date       2017-11-22
+*/
+template <unsigned int dim>
+std::vector<std::shared_ptr<Node<dim>>> PRM<dim>::getNearNodes(const std::shared_ptr<Node<dim>> &node) const {
+    if (m_neighborSearch == NeighborSearch::KNearest)
+        return m_graph->getKNearestNodes(node, util::getKNearestCount<dim>(m_graph->nodeSize()));
+    return m_graph->getNearNodes(node, m_rangeSize);
+}
+
 /*!
 *  \brief      Searches a between start and goal Node
-*  \details    Uses internal the A* algorithm to find the best path. It saves the path Nodes internal.
+*  \details    Uses internal the A* algorithm to find the best path. It saves the path Nodes internal. Start and goal are
+*  added to the roadmap, if it isn't frozen. With the lazy validation, invalid edges of the path are removed and the
+*  search is repeated.
 *  \author     Sascha Kaden
 *  \param[in]  start Node
 *  \param[in]  goal Node
@@ -236,26 +282,27 @@ void PRM<dim>::plannerPhase(const size_t startNodeIndex, const size_t endNodeInd
 */
 template <unsigned int dim>
 bool PRM<dim>::queryPath(const Vector<dim> start, const Vector<dim> goal) {
-    std::shared_ptr<Node<dim>> sourceNode = connectNode(start);
-    std::shared_ptr<Node<dim>> goalNode = connectNode(goal);
-    if (sourceNode == nullptr || goalNode == nullptr) {
-        Logging::info("Start or goal Node could not be connected", this);
-        return false;
+    m_nodePath.clear();
+    std::vector<std::shared_ptr<Node<dim>>> path;
+    if (m_frozen) {
+        path = queryRoadmap(start, goal);
+    } else {
+        std::shared_ptr<Node<dim>> sourceNode = connectNode(start);
+        std::shared_ptr<Node<dim>> goalNode = connectNode(goal);
+        if (sourceNode == nullptr || goalNode == nullptr) {
+            Logging::info("Start or goal Node could not be connected", this);
+            return false;
+        }
+        // lazy edges are validated along the path, the search is repeated until a path is completely valid
+        do {
+            path = util::aStar<dim>(sourceNode, goalNode, m_aStar);
+        } while (m_lazyValidation && !path.empty() && !validatePath(path));
     }
 
-    m_graph->clearQueryParents();
-    bool pathPlanned = util::aStar<dim>(sourceNode, goalNode, m_metric);
-
-    if (pathPlanned) {
+    if (!path.empty()) {
         Logging::info("Path could be planned", this);
         m_nodePath.push_back(std::shared_ptr<Node<dim>>(new Node<dim>(goal)));
-        std::shared_ptr<Node<dim>> temp = goalNode;
-        int count = 0;
-        while (temp != nullptr) {
-            ++count;
-            m_nodePath.push_back(temp);
-            temp = temp->getQueryParentNode();
-        }
+        m_nodePath.insert(m_nodePath.end(), path.rbegin(), path.rend());
         m_nodePath.push_back(std::shared_ptr<Node<dim>>(new Node<dim>(start)));
         return true;
     } else {
@@ -264,6 +311,138 @@ bool PRM<dim>::queryPath(const Vector<dim> start, const Vector<dim> goal) {
     }
 }
 
+/*!
+*  \brief      Searches a path between start and goal inside of the frozen roadmap, the function is thread safe.
+*  \details    Start and goal are connected by temporary Nodes, which aren't added to the roadmap. The edges to the goal
+*  are passed to the A* search, the Nodes of the roadmap aren't modified.
+*  \author     Sascha Kaden
+*  \param[in]  start configuration
+*  \param[in]  goal configuration
+*  \param[out] Nodes of the path beginning with the start, empty if no path was found
+*  \date       2017-11-29
+*/
+template <unsigned int dim>
+std::vector<std::shared_ptr<Node<dim>>> PRM<dim>::queryRoadmap(const Vector<dim> &start, const Vector<dim> &goal) const {
+    if (!m_frozen) {
+        Logging::warning("Roadmap has to be frozen for concurrent queries", this);
+        return std::vector<std::shared_ptr<Node<dim>>>();
+    }
+
+    // the temporary Nodes get the ids after the roadmap Nodes
+    std::shared_ptr<Node<dim>> sourceNode = m_graph->getNode(start);
+    if (!sourceNode) {
+        sourceNode = std::make_shared<Node<dim>>(start);
+        sourceNode->setId(static_cast<NodeId>(m_graph->nodeSize()));
+        for (auto &nearNode : getNearNodes(sourceNode))
+            if (m_trajectory->checkTrajectory(start, nearNode->getValues()))
+                sourceNode->addChild(nearNode, m_metric->calcDist(start, nearNode->getValues()));
+    }
+
+    std::vector<std::pair<std::shared_ptr<Node<dim>>, double>> goalEdges;
+    std::shared_ptr<Node<dim>> goalNode = m_graph->getNode(goal);
+    if (!goalNode) {
+        goalNode = std::make_shared<Node<dim>>(goal);
+        goalNode->setId(static_cast<NodeId>(m_graph->nodeSize() + 1));
+        for (auto &nearNode : getNearNodes(goalNode))
+            if (m_trajectory->checkTrajectory(nearNode->getValues(), goal))
+                goalEdges.push_back(std::make_pair(nearNode, m_metric->calcDist(nearNode->getValues(), goal)));
+
+        // both temporary Nodes aren't part of the neighbor search
+        if (sourceNode->getId() == m_graph->nodeSize() && m_trajectory->checkTrajectory(start, goal))
+            sourceNode->addChild(goalNode, m_metric->calcDist(start, goal));
+    }
+
+    static thread_local AStarScratch<dim> scratch;
+    return m_aStar(sourceNode, goalNode, scratch, goalEdges);
+}
+
+/*!
+*  \brief      Freeze the roadmap, it can't be expanded and queries don't add Nodes to it.
+*  \details    The roadmap must not be modified by other modules while it is frozen.
+*  \author     Sascha Kaden
+*  \param[in]  frozen
+*  \date       2017-11-29
+*/
+template <unsigned int dim>
+void PRM<dim>::setFrozen(const bool frozen) {
+    // the concurrent queries can't validate edges, all remaining lazy edges are checked before
+    if (frozen && !m_frozen && m_lazyValidation)
+        validateEdges();
+    m_frozen = frozen;
+}
+
+/*!
+*  \brief      Validates the edge between source and target and sets the state of both directions.
+*  \author     Sascha Kaden
+*  \param[in]  source Node
+*  \param[in]  target Node
+*  \param[out] true, if the edge is valid
+*  \date       2017-12-04
+*/
+template <unsigned int dim>
+bool PRM<dim>::validateEdge(const std::shared_ptr<Node<dim>> &source, const std::shared_ptr<Node<dim>> &target) {
+    // edges of the A* search, which aren't children, are parent edges and always valid
+    if (!source->isChild(target))
+        return true;
+
+    EdgeState state = source->getChildState(target);
+    if (state != EdgeState::Unknown)
+        return state == EdgeState::Valid;
+
+    state = m_trajectory->checkTrajectory(source, target) ? EdgeState::Valid : EdgeState::Invalid;
+    source->setChildState(target, state);
+    if (target->getChildState(source) == EdgeState::Unknown)
+        target->setChildState(source, state);
+    return state == EdgeState::Valid;
+}
+
+/*!
+*  \brief      Validates the unknown edges of the path, stops at the first invalid edge.
+*  \author     Sascha Kaden
+*  \param[in]  Nodes of the path from start to goal
+*  \param[out] true, if all edges of the path are valid
+*  \date       2017-12-04
+*/
+template <unsigned int dim>
+bool PRM<dim>::validatePath(const std::vector<std::shared_ptr<Node<dim>>> &path) {
+    for (auto node = path.begin(); node + 1 < path.end(); ++node)
+        if (!validateEdge(*node, *(node + 1)))
+            return false;
+
+    return true;
+}
+
+/*!
+*  \brief      Validates all unknown edges of the roadmap.
+*  \author     Sascha Kaden
+*  \date       2017-12-04
+*/
+template <unsigned int dim>
+void PRM<dim>::validateEdges() {
+    std::vector<std::shared_ptr<Node<dim>>> unknownChildren;
+    for (auto &node : m_graph->getNodes()) {
+        // invalid edges are removed from the children, the unknown children are collected before
+        unknownChildren.clear();
+        for (auto &child : node->getChildNodes())
+            if (node->getChildState(child) == EdgeState::Unknown)
+                unknownChildren.push_back(child);
+
+        for (auto &child : unknownChildren)
+            validateEdge(node, child);
+    }
+}
+
+/*!
+*  \brief      Return true, if the roadmap is frozen
+*  \author     Sascha Kaden
+*  \param[out] frozen
+*  \date       2017-11-29
+*/
+template <unsigned int dim>
+bool PRM<dim>::isFrozen() const {
+    return m_frozen;
+}
+
 /*!
 *  \brief      Try to find nearest Node of the graph to the passed Node
 *  \author     Sascha Kaden
@@ -279,8 +458,8 @@ std::shared_ptr<Node<dim>> PRM<dim>::connectNode(const Vector<dim> &config) {
         return nearestNode;
 
     // if not, create a new node and connect near nodes
-    auto newNode = std::make_shared<Node<dim>>(config);
-    std::vector<std::shared_ptr<Node<dim>>> nearNodes = m_graph->getNearNodes(newNode, m_rangeSize);
+    auto newNode = m_graph->makeNode(config);
+    std::vector<std::shared_ptr<Node<dim>>> nearNodes = getNearNodes(newNode);
     for (auto &nearNode : nearNodes) {
         if (m_trajectory->checkTrajectory(newNode, nearNode)) {
             newNode->addChild(nearNode, m_metric->calcDist(newNode, nearNode));
@@ -47,6 +47,7 @@ class RRT : public TreePlanner<dim> {
 
     // variables
     double m_stepSize = 1;
+    NeighborSearch m_neighborSearch = NeighborSearch::Range;
     std::mutex m_mutex;
 
     using Planner<dim>::m_collision;
@@ -74,6 +75,7 @@ RRT<dim>::RRT(const std::shared_ptr<Environment> &environment, const RRTOptions<
               const std::shared_ptr<Graph<dim>> &graph, const std::string &name)
     : TreePlanner<dim>(name, environment, options, graph) {
     m_stepSize = options.getStepSize();
+    m_neighborSearch = options.getNeighborSearch();
 }
 
 /*!
@@ -144,8 +146,7 @@ bool RRT<dim>::connectGoalNode(Vector<dim> goal) {
         return false;
     }
 
-    std::shared_ptr<Node<dim>> goalNode(new Node<dim>(goal));
-    std::vector<std::shared_ptr<Node<dim>>> nearNodes = m_graph->getNearNodes(goalNode, m_stepSize * 3);
+    std::vector<std::shared_ptr<Node<dim>>> nearNodes = m_graph->getNearNodes(goal, m_stepSize * 3);
 
     std::shared_ptr<Node<dim>> nearestNode = nullptr;
     for (auto node : nearNodes) {
@@ -156,6 +157,7 @@ bool RRT<dim>::connectGoalNode(Vector<dim> goal) {
     }
 
     if (nearestNode != nullptr) {
+        std::shared_ptr<Node<dim>> goalNode = m_graph->makeNode(goal);
         goalNode->setParent(nearestNode, this->m_metric->calcDist(nearestNode, goalNode));
         m_goalNode = goalNode;
         m_graph->addNode(goalNode);
@@ -183,13 +185,15 @@ std::shared_ptr<Node<dim>> RRT<dim>::computeRRTNode(const Vector<dim> &randConfi
 
     // compute Node<dim> new with fixed step size
     Vector<dim> newConfig = this->computeNodeNew(randConfig, nearestNode->getValues());
-    std::shared_ptr<Node<dim>> newNode = std::make_shared<Node<dim>>(newConfig);
 
-    if (m_collision->checkConfig(newNode->getValues()))
+    if (m_collision->checkConfig(newConfig))
         return nullptr;
-    else if (!m_trajectory->checkTrajectory(newNode, nearestNode))
+    else if (!m_trajectory->checkTrajectory(newConfig, nearestNode->getValues()))
         return nullptr;
 
+    // create the Node only for valid configurations, arena Nodes are released with the Graph
+    std::shared_ptr<Node<dim>> newNode = m_graph->makeNode(newConfig);
+
     double edgeCost = this->m_metric->calcDist(nearestNode, newNode);
     newNode->setParent(nearestNode, edgeCost);
 
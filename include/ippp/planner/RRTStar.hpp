@@ -56,6 +56,7 @@ class RRTStar : public RRT<dim> {
     using RRT<dim>::m_initNode;
     using RRT<dim>::m_goalNode;
     using RRT<dim>::m_stepSize;
+    using RRT<dim>::m_neighborSearch;
     using RRT<dim>::m_mutex;
 };
 
@@ -89,12 +90,12 @@ std::shared_ptr<Node<dim>> RRTStar<dim>::computeRRTNode(const Vector<dim> &randC
         return nullptr;
     
     std::vector<std::shared_ptr<Node<dim>>> nearNodes;
-    chooseParent(randConfig, nearestNode, nearNodes);
+    chooseParent(newConfig, nearestNode, nearNodes);
 
     if (!m_trajectory->checkTrajectory(newConfig, nearestNode->getValues()))
         return nullptr;
 
-    std::shared_ptr<Node<dim>> newNode = std::make_shared<Node<dim>>(newConfig);
+    std::shared_ptr<Node<dim>> newNode = m_graph->makeNode(newConfig);
     double edgeCost = m_metric->calcDist(newNode, nearestNode);
     newNode->setCost(edgeCost + nearestNode->getCost());
     newNode->setParent(nearestNode, edgeCost);
@@ -118,7 +119,10 @@ template <unsigned int dim>
 void RRTStar<dim>::chooseParent(const Vector<dim> &newConfig, std::shared_ptr<Node<dim>> &nearestNode,
                                 std::vector<std::shared_ptr<Node<dim>>> &nearNodes) {
     // get near nodes to the new node
-    nearNodes = m_graph->getNearNodes(newConfig, m_stepSize);
+    if (m_neighborSearch == NeighborSearch::KNearest)
+        nearNodes = m_graph->getKNearestNodes(newConfig, util::getKNearestCount<dim>(m_graph->nodeSize()));
+    else
+        nearNodes = m_graph->getNearNodes(newConfig, m_stepSize);
 
     double nearestNodeCost = nearestNode->getCost();
     for (auto nearNode : nearNodes) {
@@ -175,7 +179,7 @@ bool RRTStar<dim>::connectGoalNode(Vector<dim> goal) {
     auto nearestNode = util::getNearestValidNode<dim>(goal, m_graph, m_trajectory, m_metric, m_stepSize * 3);
 
     if (nearestNode) {
-        std::shared_ptr<Node<dim>> goalNode(new Node<dim>(goal));
+        std::shared_ptr<Node<dim>> goalNode = m_graph->makeNode(goal);
         goalNode->setParent(nearestNode, m_metric->calcDist(goalNode, nearestNode));
         goalNode->setCost(goalNode->getParentEdge().second + nearestNode->getCost());
         nearestNode->addChild(goalNode, m_metric->calcDist(goalNode, nearestNode));
@@ -87,7 +87,7 @@ std::shared_ptr<Node<dim>> RRTStarContTraj<dim>::computeRRTNode(const Vector<dim
         return nullptr;
     }
 
-    std::shared_ptr<Node<dim>> newNode(new Node<dim>(newConfig));
+    std::shared_ptr<Node<dim>> newNode = m_graph->makeNode(newConfig);
     double edgeCost = this->m_metric->calcEdgeCost(newNode, nearestNode);
     newNode->setCost(edgeCost + nearestNode->getCost());
     newNode->setParent(nearestNode, edgeCost);
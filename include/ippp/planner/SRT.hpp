@@ -61,6 +61,7 @@ class SRT : public Planner<dim> {
     std::vector<std::shared_ptr<Node<dim>>> m_openList, m_closedList;
 
     std::mutex m_mutex;
+    util::AStarFunction<dim> m_aStar;
 
     using Planner<dim>::m_collision;
     using Planner<dim>::m_environment;
@@ -85,6 +86,7 @@ SRT<dim>::SRT(const std::shared_ptr<Environment> &environment, const SRTOptions<
               const std::shared_ptr<Graph<dim>> &graph)
     : Planner<dim>("SRT", environment, options, graph) {
     m_nbOfTrees = options.getNbOfTrees();
+    m_aStar = util::makeAStar<dim>(m_metric);
 }
 
 /*!
@@ -262,18 +264,12 @@ bool SRT<dim>::queryPath(const Vector<dim> start, const Vector<dim> goal) {
 
     auto sourceNode = trees[0]->getNode(0);
     auto targetNode = trees[1]->getNode(0);
-    bool pathPlanned = util::aStar<dim>(sourceNode, targetNode, m_metric);
+    auto path = util::aStar<dim>(sourceNode, targetNode, m_aStar);
 
-    if (pathPlanned) {
+    if (!path.empty()) {
         Logging::info("Path could be planned", this);
         m_nodePath.push_back(std::shared_ptr<Node<dim>>(new Node<dim>(goal)));
-        std::shared_ptr<Node<dim>> temp = targetNode;
-        int count = 0;
-        while (temp != nullptr) {
-            ++count;
-            m_nodePath.push_back(temp);
-            temp = temp->getQueryParentNode();
-        }
+        m_nodePath.insert(m_nodePath.end(), path.rbegin(), path.rend());
         m_nodePath.push_back(std::shared_ptr<Node<dim>>(new Node<dim>(start)));
         return true;
     } else {
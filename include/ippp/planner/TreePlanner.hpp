@@ -135,24 +135,30 @@ bool TreePlanner<dim>::expand(const size_t numNodes, const size_t numThreads) {
 */
 template <unsigned int dim>
 bool TreePlanner<dim>::setInitNode(const Vector<dim> start) {
-    if (m_initNode) {
-        if (start == m_initNode->getValues()) {
-            Logging::info("Equal start node, tree will be expanded", this);
-            return true;
-        } else {
-            Logging::info("New start node, new tree will be created", this);
-            m_graph = std::make_shared<Graph<dim>>(m_graph->getSortCount(), m_graph->getNeighborFinder());
-            m_graph->sortTree();
-        }
+    if (m_initNode && start == m_initNode->getValues()) {
+        Logging::info("Equal start node, tree will be expanded", this);
+        return true;
     }
 
+    // the old tree stays untouched, if the new start is invalid
     if (m_collision->checkConfig(start)) {
         Logging::warning("Init Node could not be connected", this);
         return false;
     }
 
+    if (m_initNode) {
+        Logging::info("New start node, new tree will be created", this);
+        // arena Nodes are released with the old Graph, no pointer to them may survive
+        m_initNode = nullptr;
+        m_goalNode = nullptr;
+        m_pathPlanned = false;
+        m_graph = std::make_shared<Graph<dim>>(m_graph->getSortCount(), m_graph->getNeighborFinder(),
+                                               m_graph->getNodeStorage());
+        m_graph->sortTree();
+    }
+
     this->m_sampling->setOrigin(start);
-    m_initNode = std::make_shared<Node<dim>>(start);
+    m_initNode = m_graph->makeNode(start);
     m_graph->addNode(m_initNode);
     return true;
 }
@@ -38,9 +38,15 @@ class PRMOptions : public PlannerOptions<dim> {
 
     void setRangeSize(const double rangeSize);
     double getRangeSize() const;
+    void setNeighborSearch(const NeighborSearch neighborSearch);
+    NeighborSearch getNeighborSearch() const;
+    void setLazyValidation(const bool lazyValidation);
+    bool getLazyValidation() const;
 
   private:
     double m_rangeSize = 30;
+    NeighborSearch m_neighborSearch = NeighborSearch::Range;
+    bool m_lazyValidation = false;
 };
 
 /*!
@@ -92,6 +98,50 @@ double PRMOptions<dim>::getRangeSize() const {
     return m_rangeSize;
 }
 
+/*!
+*  \brief      Sets the neighbor search of the PRM, range search or k nearest neighbors
+*  \param[in]  NeighborSearch
+*  \author     Sascha Kaden
+*  \date       2017-11-22
+*/
+template <unsigned int dim>
+void PRMOptions<dim>::setNeighborSearch(const NeighborSearch neighborSearch) {
+    m_neighborSearch = neighborSearch;
+}
+
+/*!
+*  \brief      Returns the neighbor search of the PRM
+*  \param[out] NeighborSearch
+*  \author     Sascha Kaden
+*  \date       2017-11-22
+*/
+template <unsigned int dim>
+NeighborSearch PRMOptions<dim>::getNeighborSearch() const {
+    return m_neighborSearch;
+}
+
+/*!
+*  \brief      Sets the lazy edge validation of the PRM, edges are only checked if they are part of a query path
+*  \param[in]  lazy validation
+*  \author     Sascha Kaden
+*  \date       2017-12-04
+*/
+template <unsigned int dim>
+void PRMOptions<dim>::setLazyValidation(const bool lazyValidation) {
+    m_lazyValidation = lazyValidation;
+}
+
+/*!
+*  \brief      Returns true, if the lazy edge validation is used
+*  \param[out] lazy validation
+*  \author     Sascha Kaden
+*  \date       2017-12-04
+*/
+template <unsigned int dim>
+bool PRMOptions<dim>::getLazyValidation() const {
+    return m_lazyValidation;
+}
+
 } /* namespace ippp */
 
 #endif    // PRMOPTIONS_HPP
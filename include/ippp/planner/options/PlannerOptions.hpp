@@ -31,6 +31,12 @@
 
 namespace ippp {
 
+/*!
+* \brief   Search of the neighbors for the connection of new nodes, inside of a fixed range or the k nearest neighbors
+* with k = e * (1 + 1/dim) * log(n).
+*/
+enum class NeighborSearch { Range, KNearest };
+
 /*!
 * \brief   Class PlannerOptions holds all module instances for the path planner.
 * \author  Sascha Kaden
@@ -38,9 +38,12 @@ class RRTOptions : public PlannerOptions<dim> {
 
     void setStepSize(const double stepSize);
     double getStepSize() const;
+    void setNeighborSearch(const NeighborSearch neighborSearch);
+    NeighborSearch getNeighborSearch() const;
 
   private:
     double m_stepSize = 30;
+    NeighborSearch m_neighborSearch = NeighborSearch::Range;
 };
 
 /*!
@@ -92,6 +95,28 @@ double RRTOptions<dim>::getStepSize() const {
     return m_stepSize;
 }
 
+/*!
+*  \brief      Sets the neighbor search of the RRT, range search or k nearest neighbors
+*  \param[in]  NeighborSearch
+*  \author     Sascha Kaden
+*  \date       2017-11-22
+*/
+template <unsigned int dim>
+void RRTOptions<dim>::setNeighborSearch(const NeighborSearch neighborSearch) {
+    m_neighborSearch = neighborSearch;
+}
+
+/*!
+*  \brief      Returns the neighbor search of the RRT
+*  \param[out] NeighborSearch
+*  \author     Sascha Kaden
+*  \date       2017-11-22
+*/
+template <unsigned int dim>
+NeighborSearch RRTOptions<dim>::getNeighborSearch() const {
+    return m_neighborSearch;
+}
+
 } /* namespace ippp */
 
 #endif    // RRTOPTIONS_HPP
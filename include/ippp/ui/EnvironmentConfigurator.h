@@ -48,6 +48,7 @@ class EnvironmentConfigurator : public Configurator {
     void addObstaclePath(const std::string &obstaclePath);
     void setFactoryType(const FactoryType factoryType);
     void setRobotType(const RobotType robotType, const std::string &robotFile = "");
+    void setSelfCollisionMatrix(const SelfCollisionMatrix &matrix);
 
     std::shared_ptr<Environment> getEnvironment();
 
@@ -61,6 +62,7 @@ class EnvironmentConfigurator : public Configurator {
     FactoryType m_factoryType = FactoryType::ModelTriangle2D;
     RobotType m_robotType = RobotType::Point;
     std::string m_robotFile;
+    SelfCollisionMatrix m_selfCollisionMatrix;
 };
 
 } /* namespace ippp */
@@ -20,6 +20,7 @@
 #define MODULECONFIGURATOR_HPP
 
 #include <fstream>
+#include <limits>
 #include <type_traits>
 #include <vector>
 
@@ -35,7 +36,7 @@ enum class MetricType { L1, L2, Inf, L1Weighted, L2Weighted, InfWeighted };
 
 enum class EvaluatorType { SingleIteration, Query, Time, QueryOrTime };
 
-enum class NeighborType { KDTree, BruteForce };
+enum class NeighborType { KDTree, BruteForce, StaticKDTree, ConcurrentKDTree, SimdBruteForce };
 
 enum class PathModifierType { Dummy, NodeCut };
 
@@ -43,7 +44,7 @@ enum class SamplerType { SamplerRandom, SamplerNormalDist, SamplerUniform, GridS
 
 enum class SamplingType { Bridge, Gaussian, GaussianDist, Straight, MedialAxis, NearObstacle };
 
-enum class TrajectoryType { Linear, RotateAtS };
+enum class TrajectoryType { Linear, RotateAtS, Conservative };
 
 /*!
 * \brief   Class ModuleConfigurator generates all defined modules for the path planner and creates the graph for the planner too.
@@ -77,12 +78,15 @@ class ModuleConfigurator : public Configurator {
 
     void setEnvironment(const std::shared_ptr<Environment> &environment);
     void setCollisionType(const CollisionType type);
+    void setCollisionCache(const double resolution, const size_t capacity);
     void setMetricType(const MetricType type);
     void setMetricWeightVec(const Vector<dim> vector);
     void setEvaluatorType(const EvaluatorType type);
     void setEvaluatorProperties(const double queryEvaluatorDist, const size_t duration);
     void setGraphSortCount(const size_t count);
+    void setGraphNodeStorage(const NodeStorage storage);
     void setNeighborFinderType(const NeighborType type);
+    void setNeighborFinderProperties(const double approximation, const NeighborSearch search = NeighborSearch::Range);
     void setPathModifierType(const PathModifierType type);
     void setSamplerType(const SamplerType type);
     void setSamplerProperties(const std::string &seed, const double gridResolution);
@@ -91,9 +95,13 @@ class ModuleConfigurator : public Configurator {
     void setSamplingType(const SamplingType type);
     void setTrajectoryType(const TrajectoryType type);
     void setTrajectoryProperties(const double posRes, const double oriRes);
+    void setTrajectoryParallelValidation(const size_t numThreads, const double minLength);
+    void setTrajectoryCache(const size_t capacity);
 
   protected:
     void initializeModules();
+    template <class Metric>
+    void initializeMetricModules(const std::shared_ptr<Metric> &metric);
 
     std::shared_ptr<CollisionDetection<dim>> m_collision = nullptr;
     std::shared_ptr<DistanceMetric<dim>> m_metric = nullptr;
@@ -107,13 +115,18 @@ class ModuleConfigurator : public Configurator {
     std::shared_ptr<TrajectoryPlanner<dim>> m_trajectory = nullptr;
 
     CollisionType m_collisionType = CollisionType::PQP;
+    double m_collisionCacheResolution = 0.001;
+    size_t m_collisionCacheCapacity = 0;
     MetricType m_metricType = MetricType::L2;
-    Vector<dim> m_metricWeight;
+    Vector<dim> m_metricWeight = Vector<dim>::Ones();
     EvaluatorType m_evaluatorType = EvaluatorType::SingleIteration;
     double m_queryEvaluatorDist = 10;
     size_t m_evaluatorDuration = 10;
     size_t m_graphSortCount = 2000;
+    NodeStorage m_graphNodeStorage = NodeStorage::Shared;
     NeighborType m_neighborType = NeighborType::KDTree;
+    double m_neighborApproximation = 0;
+    NeighborSearch m_neighborSearch = NeighborSearch::Range;
     PathModifierType m_pathModifierType = PathModifierType::NodeCut;
     SamplerType m_samplerType = SamplerType::SamplerRandom;
     std::string m_samplerSeed = "";
@@ -125,6 +138,9 @@ class ModuleConfigurator : public Configurator {
     TrajectoryType m_trajectoryType = TrajectoryType::Linear;
     double m_posRes = 1;
     double m_oriRes = 0.1;
+    size_t m_trajectoryThreads = 1;
+    double m_trajectoryParallelLength = std::numeric_limits<double>::max();
+    size_t m_trajectoryCacheCapacity = 0;
 
     bool m_parameterModified = false;
 };
@@ -177,6 +193,9 @@ void ModuleConfigurator<dim>::initializeModules() {
             m_collision = std::make_shared<CollisionDetectionPqp<dim>>(m_environment);
             break;
     }
+    if (m_collisionCacheCapacity > 0)
+        m_collision = std::make_shared<CollisionDetectionCache<dim>>(m_collision, m_environment, m_collisionCacheResolution,
+                                                                     m_collisionCacheCapacity);
 
     switch (m_trajectoryType) {
         case ippp::TrajectoryType::Linear:
@@ -185,64 +204,40 @@ void ModuleConfigurator<dim>::initializeModules() {
         case ippp::TrajectoryType::RotateAtS:
             m_trajectory = std::make_shared<RotateAtS<dim>>(m_collision, m_environment, m_posRes, m_oriRes);
             break;
+        case ippp::TrajectoryType::Conservative:
+            m_trajectory = std::make_shared<ConservativeTrajectory<dim>>(m_collision, m_environment, m_posRes, m_oriRes);
+            break;
         default:
             m_trajectory = std::make_shared<LinearTrajectory<dim>>(m_collision, m_environment, m_posRes, m_oriRes);
             break;
     }
+    m_trajectory->setParallelValidation(m_trajectoryThreads, m_trajectoryParallelLength);
+    if (m_trajectoryCacheCapacity > 0)
+        m_trajectory = std::make_shared<TrajectoryCache<dim>>(m_trajectory, m_collision, m_environment, m_trajectoryCacheCapacity,
+                                                              m_trajectoryType != TrajectoryType::RotateAtS);
 
+    // the modules with distance computations in their hot loops get the static metric type
     switch (m_metricType) {
         case ippp::MetricType::L1:
-            m_metric = std::make_shared<L1Metric<dim>>();
+            initializeMetricModules(std::make_shared<L1Metric<dim>>());
             break;
         case ippp::MetricType::L2:
-            m_metric = std::make_shared<L2Metric<dim>>();
+            initializeMetricModules(std::make_shared<L2Metric<dim>>());
             break;
         case ippp::MetricType::Inf:
-            m_metric = std::make_shared<InfMetric<dim>>();
+            initializeMetricModules(std::make_shared<InfMetric<dim>>());
             break;
         case ippp::MetricType::L1Weighted:
-            m_metric = std::make_shared<WeightedL1Metric<dim>>(m_metricWeight);
+            initializeMetricModules(std::make_shared<WeightedL1Metric<dim>>(m_metricWeight));
             break;
         case ippp::MetricType::L2Weighted:
-            m_metric = std::make_shared<WeightedL2Metric<dim>>(m_metricWeight);
+            initializeMetricModules(std::make_shared<WeightedL2Metric<dim>>(m_metricWeight));
             break;
         case ippp::MetricType::InfWeighted:
-            m_metric = std::make_shared<WeightedInfMetric<dim>>(m_metricWeight);
+            initializeMetricModules(std::make_shared<WeightedInfMetric<dim>>(m_metricWeight));
             break;
         default:
-            m_metric = std::make_shared<L2Metric<dim>>();
-            break;
-    }
-
-    switch (m_neighborType) {
-        case ippp::NeighborType::KDTree:
-            m_neighborFinder = std::make_shared<KDTree<dim, std::shared_ptr<Node<dim>>>>(m_metric);
-            break;
-        case ippp::NeighborType::BruteForce:
-            m_neighborFinder = std::make_shared<BruteForceNF<dim, std::shared_ptr<Node<dim>>>>(m_metric);
-            break;
-        default:
-            m_neighborFinder = std::make_shared<KDTree<dim, std::shared_ptr<Node<dim>>>>(m_metric);
-            break;
-    }
-
-    m_graph = std::make_shared<Graph<dim>>(m_graphSortCount, m_neighborFinder);
-
-    switch (m_evaluatorType) {
-        case ippp::EvaluatorType::SingleIteration:
-            m_evaluator = std::make_shared<SingleIterationEvaluator<dim>>();
-            break;
-        case ippp::EvaluatorType::Query:
-            m_evaluator = std::make_shared<QueryEvaluator<dim>>(m_metric, m_graph, m_queryEvaluatorDist);
-            break;
-        case ippp::EvaluatorType::Time:
-            m_evaluator = std::make_shared<TimeEvaluator<dim>>(m_evaluatorDuration);
-            break;
-        case ippp::EvaluatorType::QueryOrTime:
-            std::vector<std::shared_ptr<Evaluator<dim>>> evaluators;
-            evaluators.push_back(std::make_shared<QueryEvaluator<dim>>(m_metric, m_graph, m_queryEvaluatorDist));
-            evaluators.push_back(std::make_shared<TimeEvaluator<dim>>(m_evaluatorDuration));
-            m_evaluator = std::make_shared<ComposeEvaluator<dim>>(evaluators, ComposeType::OR);
+            initializeMetricModules(std::make_shared<L2Metric<dim>>());
             break;
     }
 
@@ -305,6 +300,61 @@ void ModuleConfigurator<dim>::initializeModules() {
     }
 }
 
+/*!
+*  \brief      Initialize the DistanceMetric and the modules, which get the static type of the metric. Their distance
+*  computations are inlined.
+*  \author     Sascha Kaden
+*  \param[in]  DistanceMetric
+*  \date       2017-11-27
+*/
+template <unsigned int dim>
+template <class Metric>
+void ModuleConfigurator<dim>::initializeMetricModules(const std::shared_ptr<Metric> &metric) {
+    m_metric = metric;
+
+    switch (m_neighborType) {
+        case ippp::NeighborType::KDTree:
+            m_neighborFinder = std::make_shared<KDTree<dim, std::shared_ptr<Node<dim>>, Metric>>(metric);
+            break;
+        case ippp::NeighborType::BruteForce:
+            m_neighborFinder = std::make_shared<BruteForceNF<dim, std::shared_ptr<Node<dim>>, Metric>>(metric);
+            break;
+        case ippp::NeighborType::StaticKDTree:
+            m_neighborFinder = std::make_shared<StaticKDTree<dim, std::shared_ptr<Node<dim>>, Metric>>(metric);
+            break;
+        case ippp::NeighborType::ConcurrentKDTree:
+            m_neighborFinder = std::make_shared<ConcurrentKDTree<dim, std::shared_ptr<Node<dim>>, Metric>>(metric);
+            break;
+        case ippp::NeighborType::SimdBruteForce:
+            m_neighborFinder = std::make_shared<SimdBruteForceNF<dim, std::shared_ptr<Node<dim>>>>(m_metric);
+            break;
+        default:
+            m_neighborFinder = std::make_shared<KDTree<dim, std::shared_ptr<Node<dim>>, Metric>>(metric);
+            break;
+    }
+    m_neighborFinder->setApproximation(m_neighborApproximation);
+
+    m_graph = std::make_shared<Graph<dim>>(m_graphSortCount, m_neighborFinder, m_graphNodeStorage);
+
+    switch (m_evaluatorType) {
+        case ippp::EvaluatorType::SingleIteration:
+            m_evaluator = std::make_shared<SingleIterationEvaluator<dim>>();
+            break;
+        case ippp::EvaluatorType::Query:
+            m_evaluator = std::make_shared<QueryEvaluator<dim, Metric>>(metric, m_graph, m_queryEvaluatorDist);
+            break;
+        case ippp::EvaluatorType::Time:
+            m_evaluator = std::make_shared<TimeEvaluator<dim>>(m_evaluatorDuration);
+            break;
+        case ippp::EvaluatorType::QueryOrTime:
+            std::vector<std::shared_ptr<Evaluator<dim>>> evaluators;
+            evaluators.push_back(std::make_shared<QueryEvaluator<dim, Metric>>(metric, m_graph, m_queryEvaluatorDist));
+            evaluators.push_back(std::make_shared<TimeEvaluator<dim>>(m_evaluatorDuration));
+            m_evaluator = std::make_shared<ComposeEvaluator<dim>>(evaluators, ComposeType::OR);
+            break;
+    }
+}
+
 /*!
 *  \brief      Save all properties of the ModuleConfigurator to the defined json file.
 *  \author     Sascha Kaden
@@ -317,13 +367,18 @@ bool ModuleConfigurator<dim>::saveConfig(const std::string &filePath) {
     // types
     nlohmann::json json;
     json["CollisionType"] = static_cast<int>(m_collisionType);
+    json["CollisionCacheResolution"] = m_collisionCacheResolution;
+    json["CollisionCacheCapacity"] = m_collisionCacheCapacity;
     json["MetricType"] = static_cast<int>(m_metricType);
     json["MetricWeight"] = vectorToString<dim>(m_metricWeight);
     json["EvaluatorType"] = static_cast<int>(m_evaluatorType);
     json["QueryEvaluatorDist"] = m_queryEvaluatorDist;
     json["EvaluatorDuration"] = m_evaluatorDuration;
     json["GraphSortCount"] = m_graphSortCount;
+    json["GraphNodeStorage"] = static_cast<int>(m_graphNodeStorage);
     json["NeighborType"] = static_cast<int>(m_neighborType);
+    json["NeighborApproximation"] = m_neighborApproximation;
+    json["NeighborSearch"] = static_cast<int>(m_neighborSearch);
     json["PathModifierType"] = static_cast<int>(m_pathModifierType);
     json["SamplerType"] = static_cast<int>(m_samplerType);
     json["SamplerSeed"] = m_samplerSeed;
@@ -335,6 +390,9 @@ bool ModuleConfigurator<dim>::saveConfig(const std::string &filePath) {
     json["TrajectoryType"] = static_cast<int>(m_trajectoryType);
     json["PosRes"] = m_posRes;
     json["OriRes"] = m_oriRes;
+    json["TrajectoryThreads"] = m_trajectoryThreads;
+    json["TrajectoryParallelLength"] = m_trajectoryParallelLength;
+    json["TrajectoryCacheCapacity"] = m_trajectoryCacheCapacity;
 
     return saveJson(filePath, json);
 }
@@ -353,13 +411,23 @@ bool ModuleConfigurator<dim>::loadConfig(const std::string &filePath) {
         return false;
 
     m_collisionType = static_cast<CollisionType>(json["CollisionType"].get<int>());
+    if (json.count("CollisionCacheResolution"))
+        m_collisionCacheResolution = json["CollisionCacheResolution"].get<double>();
+    if (json.count("CollisionCacheCapacity"))
+        m_collisionCacheCapacity = json["CollisionCacheCapacity"].get<size_t>();
     m_metricType = static_cast<MetricType>(json["MetricType"].get<int>());
     m_metricWeight = stringToVector<dim>(json["MetricWeight"].get<std::string>());
     m_evaluatorType = static_cast<EvaluatorType>(json["EvaluatorType"].get<int>());
     m_queryEvaluatorDist = json["QueryEvaluatorDist"].get<double>();
     m_evaluatorDuration = json["EvaluatorDuration"].get<size_t>();
     m_graphSortCount = json["GraphSortCount"].get<size_t>();
+    if (json.count("GraphNodeStorage"))
+        m_graphNodeStorage = static_cast<NodeStorage>(json["GraphNodeStorage"].get<int>());
     m_neighborType = static_cast<NeighborType>(json["NeighborType"].get<int>());
+    if (json.count("NeighborApproximation"))
+        m_neighborApproximation = json["NeighborApproximation"].get<double>();
+    if (json.count("NeighborSearch"))
+        m_neighborSearch = static_cast<NeighborSearch>(json["NeighborSearch"].get<int>());
     m_pathModifierType = static_cast<PathModifierType>(json["PathModifierType"].get<int>());
     m_samplerType = static_cast<SamplerType>(json["SamplerType"].get<int>());
     m_samplerSeed = json["SamplerSeed"].get<std::string>();
@@ -371,6 +439,12 @@ bool ModuleConfigurator<dim>::loadConfig(const std::string &filePath) {
     m_trajectoryType = static_cast<TrajectoryType>(json["TrajectoryType"].get<int>());
     m_posRes = json["PosRes"].get<double>();
     m_posRes = json["OriRes"].get<double>();
+    if (json.count("TrajectoryThreads"))
+        m_trajectoryThreads = json["TrajectoryThreads"].get<size_t>();
+    if (json.count("TrajectoryParallelLength"))
+        m_trajectoryParallelLength = json["TrajectoryParallelLength"].get<double>();
+    if (json.count("TrajectoryCacheCapacity"))
+        m_trajectoryCacheCapacity = json["TrajectoryCacheCapacity"].get<size_t>();
     initializeModules();
 
     return true;
@@ -405,6 +479,26 @@ void ModuleConfigurator<dim>::setCollisionType(const CollisionType type) {
     m_parameterModified = true;
 }
 
+/*!
+*  \brief      Sets the cache of the CollisionDetection
+*  \details    The cache is disabled with a capacity of 0.
+*  \author     Sascha Kaden
+*  \param[in]  resolution of the quantized configurations
+*  \param[in]  maximal number of cached configurations
+*  \date       2017-12-05
+*/
+template <unsigned int dim>
+void ModuleConfigurator<dim>::setCollisionCache(const double resolution, const size_t capacity) {
+    if (resolution <= 0) {
+        m_collisionCacheResolution = 0.001;
+        Logging::warning("Cache resolution has to be larger than 0, it was set to 0.001!", this);
+    } else {
+        m_collisionCacheResolution = resolution;
+    }
+    m_collisionCacheCapacity = capacity;
+    m_parameterModified = true;
+}
+
 /*!
 *  \brief      Sets the MetricType
 *  \author     Sascha Kaden
@@ -467,6 +561,19 @@ void ModuleConfigurator<dim>::setGraphSortCount(const size_t count) {
     m_parameterModified = true;
 }
 
+/*!
+*  \brief      Sets the storage type of the Graph Nodes
+*  \details    NodeStorage::Arena allocates the Nodes contiguous inside of the Graph without reference counting.
+*  \author     Sascha Kaden
+*  \param[in]  NodeStorage
+*  \date       2017-11-20
+*/
+template <unsigned int dim>
+void ModuleConfigurator<dim>::setGraphNodeStorage(const NodeStorage storage) {
+    m_graphNodeStorage = storage;
+    m_parameterModified = true;
+}
+
 /*!
 *  \brief      Sets the NeighborType
 *  \author     Sascha Kaden
@@ -479,6 +586,20 @@ void ModuleConfigurator<dim>::setNeighborFinderType(const NeighborType type) {
     m_parameterModified = true;
 }
 
+/*!
+*  \brief      Sets the properties of the NeighborFinder and the neighbor search of the planners
+*  \author     Sascha Kaden
+*  \param[in]  approximation factor epsilon of the nearest neighbor search, 0 is exact
+*  \param[in]  NeighborSearch of the PRM and RRT options
+*  \date       2017-11-22
+*/
+template <unsigned int dim>
+void ModuleConfigurator<dim>::setNeighborFinderProperties(const double approximation, const NeighborSearch search) {
+    m_neighborApproximation = approximation;
+    m_neighborSearch = search;
+    m_parameterModified = true;
+}
+
 /*!
 *  \brief      Sets the PathModifierType
 *  \author     Sascha Kaden
@@ -575,6 +696,34 @@ void ModuleConfigurator<dim>::setTrajectoryProperties(const double posRes, const
     m_parameterModified = true;
 }
 
+/*!
+*  \brief      Sets the parallel validation of long trajectories
+*  \details    Trajectories with a length of at least minLength are checked by numThreads threads.
+*  \author     Sascha Kaden
+*  \param[in]  number of threads
+*  \param[in]  minimal length of the trajectory
+*  \date       2017-12-03
+*/
+template <unsigned int dim>
+void ModuleConfigurator<dim>::setTrajectoryParallelValidation(const size_t numThreads, const double minLength) {
+    m_trajectoryThreads = numThreads;
+    m_trajectoryParallelLength = minLength;
+    m_parameterModified = true;
+}
+
+/*!
+*  \brief      Sets the cache of the validated edges, which is shared by all modules and the planner.
+*  \details    The cache is disabled with a capacity of 0.
+*  \author     Sascha Kaden
+*  \param[in]  maximal number of cached edges
+*  \date       2017-12-06
+*/
+template <unsigned int dim>
+void ModuleConfigurator<dim>::setTrajectoryCache(const size_t capacity) {
+    m_trajectoryCacheCapacity = capacity;
+    m_parameterModified = true;
+}
+
 /*!
 *  \brief      Return the pointer to the Environment instance.
 *  \author     Sascha Kaden
@@ -716,7 +865,9 @@ PlannerOptions<dim> ModuleConfigurator<dim>::getPlannerOptions() {
 template <unsigned int dim>
 PRMOptions<dim> ModuleConfigurator<dim>::getPRMOptions(const double rangeSize) {
     initializeModules();
-    return PRMOptions<dim>(rangeSize, m_collision, m_metric, m_evaluator, m_pathModifier, m_sampling, m_trajectory);
+    PRMOptions<dim> options(rangeSize, m_collision, m_metric, m_evaluator, m_pathModifier, m_sampling, m_trajectory);
+    options.setNeighborSearch(m_neighborSearch);
+    return options;
 }
 
 /*!
@@ -729,7 +880,9 @@ PRMOptions<dim> ModuleConfigurator<dim>::getPRMOptions(const double rangeSize) {
 template <unsigned int dim>
 RRTOptions<dim> ModuleConfigurator<dim>::getRRTOptions(const double stepSize) {
     initializeModules();
-    return RRTOptions<dim>(stepSize, m_collision, m_metric, m_evaluator, m_pathModifier, m_sampling, m_trajectory);
+    RRTOptions<dim> options(stepSize, m_collision, m_metric, m_evaluator, m_pathModifier, m_sampling, m_trajectory);
+    options.setNeighborSearch(m_neighborSearch);
+    return options;
 }
 
 /*!
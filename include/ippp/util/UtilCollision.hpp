@@ -25,6 +25,98 @@
 namespace ippp {
 namespace util {
 
+/*!
+*  \brief      Transforms the bounding spheres with the passed rigid transformation.
+*  \author     Sascha Kaden
+*  \param[in]  BoundingSpheres
+*  \param[in]  Transform
+*  \param[out] transformed BoundingSpheres
+*  \date       2017-12-13
+*/
+static BoundingSpheres transformSpheres(const BoundingSpheres &spheres, const Transform &T) {
+    BoundingSpheres transformed(spheres);
+    transformed.center = T * spheres.center;
+    for (size_t i = 0; i < spheres.numLeaves; ++i)
+        transformed.centers[i] = T * spheres.centers[i];
+    return transformed;
+}
+
+/*!
+*  \brief      Returns false if the two sphere hierarchies can't overlap, their meshes are free of collision.
+*  \details    The root spheres are tested first, afterwards the leaves. Empty hierarchies overlap everything.
+*  \author     Sascha Kaden
+*  \param[in]  first BoundingSpheres
+*  \param[in]  second BoundingSpheres
+*  \param[out] true if the spheres overlap
+*  \date       2017-12-13
+*/
+static bool spheresOverlap(const BoundingSpheres &first, const BoundingSpheres &second) {
+    if (first.radius < 0 || second.radius < 0)
+        return true;
+
+    auto overlap = [](const Vector3 &center1, const double radius1, const Vector3 &center2, const double radius2) {
+        return (center1 - center2).squaredNorm() <= (radius1 + radius2) * (radius1 + radius2);
+    };
+    if (!overlap(first.center, first.radius, second.center, second.radius))
+        return false;
+
+    for (size_t i = 0; i < first.numLeaves; ++i) {
+        if (!overlap(first.centers[i], first.radii[i], second.center, second.radius))
+            continue;
+        for (size_t j = 0; j < second.numLeaves; ++j)
+            if (overlap(first.centers[i], first.radii[i], second.centers[j], second.radii[j]))
+                return true;
+    }
+    return false;
+}
+
+/*!
+*  \brief      Returns false if the sphere hierarchy can't overlap the AABB.
+*  \author     Sascha Kaden
+*  \param[in]  BoundingSpheres
+*  \param[in]  AABB
+*  \param[out] true if the spheres overlap the AABB
+*  \date       2017-12-13
+*/
+static bool spheresOverlap(const BoundingSpheres &spheres, const AABB &aabb) {
+    if (spheres.radius < 0)
+        return true;
+
+    if (aabb.squaredExteriorDistance(spheres.center) > spheres.radius * spheres.radius)
+        return false;
+    for (size_t i = 0; i < spheres.numLeaves; ++i)
+        if (aabb.squaredExteriorDistance(spheres.centers[i]) <= spheres.radii[i] * spheres.radii[i])
+            return true;
+    return false;
+}
+
+/*!
+*  \brief      Update the minimal distance of a model to the obstacles, the distance function is only called for
+*  obstacles whose AABB is closer than the current minimal distance.
+*  \details    The distance of the AABBs is a lower bound of the distance of the meshes. The search stops at the first
+*  obstacle with a distance of zero or less (collision).
+*  \author     Sascha Kaden
+*  \param[in]  transformed AABB of the model
+*  \param[in]  AABBs of the obstacles
+*  \param[in]  distance function of the obstacle index
+*  \param[in,out] minimal distance
+*  \param[out] true if the model collides with an obstacle
+*  \date       2017-12-15
+*/
+template <typename DistanceFunction>
+bool updateObstacleDistance(const AABB &aabb, const std::vector<AABB> &obstacleAABBs, DistanceFunction distance,
+                            double &minDist) {
+    for (size_t i = 0; i < obstacleAABBs.size(); ++i) {
+        if (std::sqrt(aabb.squaredExteriorDistance(obstacleAABBs[i])) >= minDist)
+            continue;
+
+        double dist = distance(i);
+        minDist = std::min(minDist, dist);
+        if (dist <= 0)
+            return true;
+    }
+    return false;
+}
 
 } /* namespace util */
 } /* namespace ippp */
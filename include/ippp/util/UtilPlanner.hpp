@@ -19,8 +19,20 @@
 #ifndef UTILPLANNER_HPP
 #define UTILPLANNER_HPP
 
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <utility>
+
+#include <ippp/dataObj/AStarScratch.hpp>
 #include <ippp/dataObj/Graph.hpp>
 #include <ippp/modules/distanceMetrics/DistanceMetric.hpp>
+#include <ippp/modules/distanceMetrics/InfMetric.hpp>
+#include <ippp/modules/distanceMetrics/L1Metric.hpp>
+#include <ippp/modules/distanceMetrics/L2Metric.hpp>
+#include <ippp/modules/distanceMetrics/WeightedInfMetric.hpp>
+#include <ippp/modules/distanceMetrics/WeightedL1Metric.hpp>
+#include <ippp/modules/distanceMetrics/WeightedL2Metric.hpp>
 #include <ippp/modules/trajectoryPlanner/TrajectoryPlanner.hpp>
 
 namespace ippp {
@@ -51,79 +63,181 @@ static std::shared_ptr<Node<dim>> getNearestValidNode(const Vector<dim> &config,
 }
 
 /*!
-*  \brief         Expands the openList of the A* algorithm from the childes of the passed Node
-*  \author        Sascha Kaden
-*  \param[in]     current node
-*  \param[in,out] open list
-*  \param[in,out] closed list
-*  \param[in]     DistanceMetric
-*  \date          2016-08-09
+*  \brief      Return the number of nearest neighbors k = e * (1 + 1/dim) * log(n) for a graph with n nodes, which keeps
+*  the asymptotic optimality of PRM* and RRT*.
+*  \author     Sascha Kaden
+*  \param[in]  number of nodes n
+*  \param[out] number of nearest neighbors k
+*  \date       2017-11-22
 */
 template <unsigned int dim>
-static void expandNode(const std::shared_ptr<Node<dim>> currentNode, std::vector<std::shared_ptr<Node<dim>>> &openList,
-                       std::vector<std::shared_ptr<Node<dim>>> &closedList, const std::shared_ptr<DistanceMetric<dim>> &metric) {
-    double dist, edgeCost;
-    auto successors = currentNode->getChildNodes();
-    if (currentNode->getParentNode())
-        successors.push_back(currentNode->getParentNode());
-
-    for (auto &successor : successors) {
-        if (util::contains(closedList, successor))
-            continue;
-
-        edgeCost = metric->calcDist(currentNode, successor);
-        dist = currentNode->getCost() + edgeCost;
-
-        if (util::contains(openList, successor) && dist >= successor->getCost())
-            continue;
-
-        successor->setQueryParent(currentNode, edgeCost);
-        successor->setCost(dist);
-        if (!util::contains(openList, successor))
-            openList.push_back(successor);
-    }
+static size_t getKNearestCount(const size_t numNodes) {
+    if (numNodes < 2)
+        return 1;
+    return static_cast<size_t>(std::ceil(std::exp(1.0) * (1.0 + 1.0 / dim) * std::log(static_cast<double>(numNodes))));
 }
 
 /*!
-*  \brief      A* algorithm to find best path
-*  \details    Query parents of all nodes has to be cleared at the Graph.
+*  \brief      A* algorithm to find the best path between the source and the target Node
+*  \details    The heuristic is the distance of the metric to the target, which is admissible if the edge costs are
+*  computed by the same metric. Closed Nodes are reopened, if a shorter way to them is found. The Nodes need unique ids
+*  (set by the Graph), the state of the query is stored inside of the scratch buffer and the Nodes are not modified.
+*  Edges to a temporary target, which can't be stored at the Nodes of a shared roadmap, are passed as target edges.
 *  \author     Sascha Kaden
 *  \param[in]  source Node (start)
-*  \param[in]  goal Node (goal)
-*  \param[in]  DistanceMetric
-*  \param[out] result of algorithm
-*  \date       2016-08-09
+*  \param[in]  target Node (goal)
+*  \param[in]  DistanceMetric, a final metric type is called without virtual dispatch
+*  \param[in]  scratch buffer of the query, cleared after the search
+*  \param[in]  additional edges (Node, cost) to the target
+*  \param[out] Nodes of the path beginning with the source, empty if no path was found
+*  \date       2017-11-28
 */
-template <unsigned int dim>
-static bool aStar(const std::shared_ptr<Node<dim>> sourceNode, const std::shared_ptr<Node<dim>> targetNode,
-                  const std::shared_ptr<DistanceMetric<dim>> &metric) {
-    std::vector<std::shared_ptr<Node<dim>>> openList, closedList;
-
-    auto edges = sourceNode->getChildEdges();
-    if (sourceNode->getParentEdge().first)
-        edges.push_back(sourceNode->getParentEdge());
-
-    for (size_t i = 0; i < edges.size(); ++i) {
-        edges[i].first->setCost(edges[i].second);
-        edges[i].first->setQueryParent(sourceNode, metric->calcDist(edges[i].first, sourceNode));
-        openList.push_back(edges[i].first);
+template <unsigned int dim, class Metric = DistanceMetric<dim>>
+static std::vector<std::shared_ptr<Node<dim>>>
+aStar(const std::shared_ptr<Node<dim>> &sourceNode, const std::shared_ptr<Node<dim>> &targetNode,
+      const std::shared_ptr<Metric> &metric, AStarScratch<dim> &scratch,
+      const std::vector<std::pair<std::shared_ptr<Node<dim>>, double>> &targetEdges =
+          std::vector<std::pair<std::shared_ptr<Node<dim>>, double>>()) {
+    std::vector<std::shared_ptr<Node<dim>>> path;
+    if (!sourceNode || !targetNode)
+        return path;
+
+    scratch.clear();
+    if (!scratch.addNode(sourceNode) || !scratch.addNode(targetNode)) {
+        Logging::error("A* needs Nodes with unique ids", "aStar");
+        scratch.clear();
+        return path;
     }
-    closedList.push_back(sourceNode);
 
-    int count = 0;
-    std::shared_ptr<Node<dim>> currentNode;
-    while (!openList.empty()) {
-        currentNode = util::removeMinFromList(openList);
+    for (auto &edge : targetEdges) {
+        if (!scratch.addNode(edge.first)) {
+            Logging::error("A* needs Nodes with unique ids", "aStar");
+            scratch.clear();
+            return path;
+        }
+        scratch.setTargetEdge(edge.first->getId(), edge.second);
+    }
 
-        if (currentNode == targetNode)
-            return true;
+    const Vector<dim> target = targetNode->getValues();
+    scratch.updateOpen(sourceNode->getId(), 0, metric->calcDist(sourceNode->getValues(), target), INVALID_NODE_ID);
+    while (!scratch.emptyOpen()) {
+        const NodeId currentId = scratch.popOpen();
+        if (currentId == targetNode->getId()) {
+            path = scratch.getPath(currentId);
+            break;
+        }
+        scratch.setClosed(currentId, true);
+
+        const auto currentNode = scratch.getNode(currentId);
+        const double currentCost = scratch.getCost(currentId);
+        auto expand = [&](const std::shared_ptr<Node<dim>> &successor, const double edgeCost) {
+            if (!scratch.addNode(successor)) {
+                Logging::error("A* needs Nodes with unique ids", "aStar");
+                return;
+            }
+            const NodeId id = successor->getId();
+            const double cost = currentCost + edgeCost;
+            if (cost >= scratch.getCost(id))
+                return;
+
+            scratch.setClosed(id, false);
+            scratch.updateOpen(id, cost, cost + metric->calcDist(successor->getValues(), target), currentId);
+        };
+
+        for (auto &child : currentNode->getChildEdges())
+            expand(child.first, child.second);
+        auto parentEdge = currentNode->getParentEdge();
+        if (parentEdge.first)
+            expand(parentEdge.first, parentEdge.second);
+        if (scratch.getTargetEdge(currentId) < std::numeric_limits<double>::max())
+            expand(targetNode, scratch.getTargetEdge(currentId));
+    }
 
-        closedList.push_back(currentNode);
-        ++count;
+    scratch.clear();
+    return path;
+}
 
-        expandNode<dim>(currentNode, openList, closedList, metric);
-    }
-    return false;
+/*!
+*  \brief      A* algorithm to find the best path between the source and the target Node
+*  \details    Uses a scratch buffer per thread, see aStar with the scratch buffer parameter.
+*  \author     Sascha Kaden
+*  \param[in]  source Node (start)
+*  \param[in]  target Node (goal)
+*  \param[in]  DistanceMetric, a final metric type is called without virtual dispatch
+*  \param[out] Nodes of the path beginning with the source, empty if no path was found
+*  \date       2017-11-28
+*/
+template <unsigned int dim, class Metric = DistanceMetric<dim>>
+static std::vector<std::shared_ptr<Node<dim>>> aStar(const std::shared_ptr<Node<dim>> &sourceNode,
+                                                     const std::shared_ptr<Node<dim>> &targetNode,
+                                                     const std::shared_ptr<Metric> &metric) {
+    static thread_local AStarScratch<dim> scratch;
+    return aStar<dim, Metric>(sourceNode, targetNode, metric, scratch);
+}
+
+template <unsigned int dim>
+using AStarFunction = std::function<std::vector<std::shared_ptr<Node<dim>>>(
+    const std::shared_ptr<Node<dim>> &, const std::shared_ptr<Node<dim>> &, AStarScratch<dim> &,
+    const std::vector<std::pair<std::shared_ptr<Node<dim>>, double>> &)>;
+
+/*!
+*  \brief      Bind the A* search to the passed metric
+*  \author     Sascha Kaden
+*  \param[in]  DistanceMetric
+*  \param[out] A* search (source, target, scratch buffer, target edges)
+*  \date       2017-12-18
+*/
+template <unsigned int dim, class Metric>
+static AStarFunction<dim> bindAStar(const std::shared_ptr<Metric> &metric) {
+    return [metric](const std::shared_ptr<Node<dim>> &sourceNode, const std::shared_ptr<Node<dim>> &targetNode,
+                    AStarScratch<dim> &scratch,
+                    const std::vector<std::pair<std::shared_ptr<Node<dim>>, double>> &targetEdges) {
+        return aStar<dim, Metric>(sourceNode, targetNode, metric, scratch, targetEdges);
+    };
+}
+
+/*!
+*  \brief      Bind the A* search to the final type of the passed metric
+*  \details    The type of the metric is resolved once, the returned search calls the metric without virtual dispatch.
+*  Unknown metric types fall back to the virtual DistanceMetric interface.
+*  \author     Sascha Kaden
+*  \param[in]  DistanceMetric
+*  \param[out] A* search (source, target, scratch buffer, target edges)
+*  \date       2017-12-18
+*/
+template <unsigned int dim>
+static AStarFunction<dim> makeAStar(const std::shared_ptr<DistanceMetric<dim>> &metric) {
+    if (auto typed = std::dynamic_pointer_cast<L2Metric<dim>>(metric))
+        return bindAStar<dim>(typed);
+    if (auto typed = std::dynamic_pointer_cast<L1Metric<dim>>(metric))
+        return bindAStar<dim>(typed);
+    if (auto typed = std::dynamic_pointer_cast<InfMetric<dim>>(metric))
+        return bindAStar<dim>(typed);
+    if (auto typed = std::dynamic_pointer_cast<WeightedL2Metric<dim>>(metric))
+        return bindAStar<dim>(typed);
+    if (auto typed = std::dynamic_pointer_cast<WeightedL1Metric<dim>>(metric))
+        return bindAStar<dim>(typed);
+    if (auto typed = std::dynamic_pointer_cast<WeightedInfMetric<dim>>(metric))
+        return bindAStar<dim>(typed);
+    return bindAStar<dim>(metric);
+}
+
+/*!
+*  \brief      A* algorithm with a search bound by makeAStar
+*  \details    Uses a scratch buffer per thread, see aStar with the scratch buffer parameter.
+*  \author     Sascha Kaden
+*  \param[in]  source Node (start)
+*  \param[in]  target Node (goal)
+*  \param[in]  A* search of makeAStar
+*  \param[out] Nodes of the path beginning with the source, empty if no path was found
+*  \date       2017-12-18
+*/
+template <unsigned int dim>
+static std::vector<std::shared_ptr<Node<dim>>> aStar(const std::shared_ptr<Node<dim>> &sourceNode,
+                                                     const std::shared_ptr<Node<dim>> &targetNode,
+                                                     const AStarFunction<dim> &search) {
+    static thread_local AStarScratch<dim> scratch;
+    return search(sourceNode, targetNode, scratch, std::vector<std::pair<std::shared_ptr<Node<dim>>, double>>());
 }
 
 } /* namespace util */
@@ -0,0 +1,490 @@
+//-------------------------------------------------------------------------//
+//
+// Copyright 2017 Sascha Kaden
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-------------------------------------------------------------------------//
+
+
+#ifndef UTILSIMD_HPP
+#define UTILSIMD_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define IPPP_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace ippp {
+namespace util {
+
+/*!
+* \brief   Number of points inside of one structure of arrays block, the coordinates of a block are stored as
+* block[axis * simdBlockSize + lane].
+*/
+constexpr unsigned int simdBlockSize = 8;
+
+/*!
+* \brief   Simplified distance kernels of the blocks, weighted metrics pass their weights, the others pass ones.
+*/
+enum class SimdMetric { L1, L2, Inf };
+
+/*!
+* \brief   Maximum number of blocks, which are passed to one call of a block distance kernel.
+*/
+constexpr unsigned int simdBlocksPerCall = 32;
+
+/*!
+* \brief   Computes the simplified distances of the query to the points of consecutive blocks, dists has to hold
+* numBlocks * simdBlockSize values.
+*/
+using BlockDistanceFunction = void (*)(const double *blocks, size_t numBlocks, const double *query, const double *weights,
+                                       unsigned int dim, double *dists);
+
+/*!
+*  \brief      Scalar kernel of the block distances, the loop over the lanes can be vectorized by the compiler.
+*  \author     Sascha Kaden
+*  \param[in]  blocks of points
+*  \param[in]  number of blocks
+*  \param[in]  query point
+*  \param[in]  weights
+*  \param[in]  dimension
+*  \param[out] simplified distances
+*  \date       2017-11-26
+*/
+template <SimdMetric metric>
+static void blockDistancesScalar(const double *blocks, const size_t numBlocks, const double *query, const double *weights,
+                                 const unsigned int dim, double *dists) {
+    for (size_t blockIndex = 0; blockIndex < numBlocks; ++blockIndex) {
+        const double *block = blocks + blockIndex * dim * simdBlockSize;
+        double *blockDists = dists + blockIndex * simdBlockSize;
+        for (unsigned int lane = 0; lane < simdBlockSize; ++lane)
+            blockDists[lane] = 0;
+        for (unsigned int axis = 0; axis < dim; ++axis) {
+            const double *values = block + axis * simdBlockSize;
+            for (unsigned int lane = 0; lane < simdBlockSize; ++lane) {
+                double diff = (values[lane] - query[axis]) * weights[axis];
+                if (metric == SimdMetric::L2)
+                    blockDists[lane] += diff * diff;
+                else if (metric == SimdMetric::L1)
+                    blockDists[lane] += std::abs(diff);
+                else
+                    blockDists[lane] = std::max(blockDists[lane], std::abs(diff));
+            }
+        }
+    }
+}
+
+#ifdef IPPP_SIMD_X86
+/*!
+*  \brief      AVX2 kernel of the block distances, two registers hold the eight lanes.
+*  \author     Sascha Kaden
+*  \param[in]  blocks of points
+*  \param[in]  number of blocks
+*  \param[in]  query point
+*  \param[in]  weights
+*  \param[in]  dimension
+*  \param[out] simplified distances
+*  \date       2017-11-26
+*/
+template <SimdMetric metric>
+__attribute__((target("avx2"))) static void blockDistancesAvx2(const double *blocks, const size_t numBlocks,
+                                                                const double *query, const double *weights,
+                                                                const unsigned int dim, double *dists) {
+    const __m256d signMask = _mm256_set1_pd(-0.0);
+    for (size_t blockIndex = 0; blockIndex < numBlocks; ++blockIndex) {
+        const double *block = blocks + blockIndex * dim * simdBlockSize;
+        __m256d low = _mm256_setzero_pd();
+        __m256d high = _mm256_setzero_pd();
+        for (unsigned int axis = 0; axis < dim; ++axis) {
+            const double *values = block + axis * simdBlockSize;
+            const __m256d q = _mm256_set1_pd(query[axis]);
+            const __m256d w = _mm256_set1_pd(weights[axis]);
+            __m256d diffLow = _mm256_mul_pd(_mm256_sub_pd(_mm256_loadu_pd(values), q), w);
+            __m256d diffHigh = _mm256_mul_pd(_mm256_sub_pd(_mm256_loadu_pd(values + 4), q), w);
+            if (metric == SimdMetric::L2) {
+                low = _mm256_add_pd(low, _mm256_mul_pd(diffLow, diffLow));
+                high = _mm256_add_pd(high, _mm256_mul_pd(diffHigh, diffHigh));
+            } else if (metric == SimdMetric::L1) {
+                low = _mm256_add_pd(low, _mm256_andnot_pd(signMask, diffLow));
+                high = _mm256_add_pd(high, _mm256_andnot_pd(signMask, diffHigh));
+            } else {
+                low = _mm256_max_pd(low, _mm256_andnot_pd(signMask, diffLow));
+                high = _mm256_max_pd(high, _mm256_andnot_pd(signMask, diffHigh));
+            }
+        }
+        _mm256_storeu_pd(dists + blockIndex * simdBlockSize, low);
+        _mm256_storeu_pd(dists + blockIndex * simdBlockSize + 4, high);
+    }
+}
+
+/*!
+*  \brief      AVX-512 kernel of the block distances, one register holds the eight lanes.
+*  \author     Sascha Kaden
+*  \param[in]  blocks of points
+*  \param[in]  number of blocks
+*  \param[in]  query point
+*  \param[in]  weights
+*  \param[in]  dimension
+*  \param[out] simplified distances
+*  \date       2017-11-26
+*/
+template <SimdMetric metric>
+__attribute__((target("avx512f"))) static void blockDistancesAvx512(const double *blocks, const size_t numBlocks,
+                                                                     const double *query, const double *weights,
+                                                                     const unsigned int dim, double *dists) {
+    for (size_t blockIndex = 0; blockIndex < numBlocks; ++blockIndex) {
+        const double *block = blocks + blockIndex * dim * simdBlockSize;
+        __m512d sum = _mm512_setzero_pd();
+        for (unsigned int axis = 0; axis < dim; ++axis) {
+            __m512d diff = _mm512_mul_pd(
+                _mm512_sub_pd(_mm512_loadu_pd(block + axis * simdBlockSize), _mm512_set1_pd(query[axis])),
+                _mm512_set1_pd(weights[axis]));
+            if (metric == SimdMetric::L2)
+                sum = _mm512_fmadd_pd(diff, diff, sum);
+            else if (metric == SimdMetric::L1)
+                sum = _mm512_add_pd(sum, _mm512_abs_pd(diff));
+            else
+                sum = _mm512_max_pd(sum, _mm512_abs_pd(diff));
+        }
+        _mm512_storeu_pd(dists + blockIndex * simdBlockSize, sum);
+    }
+}
+#endif
+
+/*!
+*  \brief      Returns the fastest block distance kernel of the metric, which is supported by the running CPU.
+*  \details    AVX-512 and AVX2 kernels are only available with GCC or Clang on x86, otherwise the scalar kernel is used.
+*  \author     Sascha Kaden
+*  \param[in]  metric kernel
+*  \param[out] block distance function
+*  \date       2017-11-26
+*/
+template <SimdMetric metric>
+static BlockDistanceFunction getBlockDistanceFunction() {
+#ifdef IPPP_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return &blockDistancesAvx512<metric>;
+    if (__builtin_cpu_supports("avx2"))
+        return &blockDistancesAvx2<metric>;
+#endif
+    return &blockDistancesScalar<metric>;
+}
+
+/*!
+*  \brief      Returns the scalar block distance kernel of the metric.
+*  \author     Sascha Kaden
+*  \param[in]  metric kernel
+*  \param[out] block distance function
+*  \date       2017-11-26
+*/
+template <SimdMetric metric>
+static BlockDistanceFunction getScalarBlockDistanceFunction() {
+    return &blockDistancesScalar<metric>;
+}
+
+/*!
+* \brief   Number of coefficients of one triangle inside of a triangle block, the vertex p3 and the gradients of the
+* barycentric coordinates alpha and beta. A block stores them as block[coefficient * simdBlockSize + lane].
+*/
+constexpr unsigned int triangleCoefficients = 6;
+
+/*!
+* \brief   Returns true if the point lies inside of one triangle of the consecutive triangle blocks.
+*/
+using TriangleBlockFunction = bool (*)(const double *blocks, size_t numBlocks, double x, double y);
+
+/*!
+*  \brief      Scalar kernel of the point in triangle test, the loop over the lanes can be vectorized by the compiler.
+*  \details    The barycentric coordinates are alpha = ax * (x - x3) + ay * (y - y3), beta accordingly and
+*  gamma = 1 - alpha - beta, the point is inside if all of them are larger than 0.
+*  \author     Sascha Kaden
+*  \param[in]  triangle blocks
+*  \param[in]  number of blocks
+*  \param[in]  x
+*  \param[in]  y
+*  \param[out] true if the point is inside of a triangle
+*  \date       2017-12-09
+*/
+static bool trianglesContainScalar(const double *blocks, const size_t numBlocks, const double x, const double y) {
+    for (size_t blockIndex = 0; blockIndex < numBlocks; ++blockIndex) {
+        const double *block = blocks + blockIndex * triangleCoefficients * simdBlockSize;
+        bool inside = false;
+        for (unsigned int lane = 0; lane < simdBlockSize; ++lane) {
+            double dx = x - block[lane];
+            double dy = y - block[simdBlockSize + lane];
+            double alpha = block[2 * simdBlockSize + lane] * dx + block[3 * simdBlockSize + lane] * dy;
+            double beta = block[4 * simdBlockSize + lane] * dx + block[5 * simdBlockSize + lane] * dy;
+            inside |= alpha > 0 && beta > 0 && 1 - alpha - beta > 0;
+        }
+        if (inside)
+            return true;
+    }
+    return false;
+}
+
+#ifdef IPPP_SIMD_X86
+/*!
+*  \brief      AVX2 kernel of the point in triangle test, two registers hold the eight lanes.
+*  \author     Sascha Kaden
+*  \param[in]  triangle blocks
+*  \param[in]  number of blocks
+*  \param[in]  x
+*  \param[in]  y
+*  \param[out] true if the point is inside of a triangle
+*  \date       2017-12-09
+*/
+__attribute__((target("avx2"))) static bool trianglesContainAvx2(const double *blocks, const size_t numBlocks,
+                                                                  const double x, const double y) {
+    const __m256d px = _mm256_set1_pd(x);
+    const __m256d py = _mm256_set1_pd(y);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one = _mm256_set1_pd(1);
+    for (size_t blockIndex = 0; blockIndex < numBlocks; ++blockIndex) {
+        const double *block = blocks + blockIndex * triangleCoefficients * simdBlockSize;
+        for (unsigned int half = 0; half < simdBlockSize; half += 4) {
+            __m256d dx = _mm256_sub_pd(px, _mm256_loadu_pd(block + half));
+            __m256d dy = _mm256_sub_pd(py, _mm256_loadu_pd(block + simdBlockSize + half));
+            __m256d alpha = _mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(block + 2 * simdBlockSize + half), dx),
+                                          _mm256_mul_pd(_mm256_loadu_pd(block + 3 * simdBlockSize + half), dy));
+            __m256d beta = _mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(block + 4 * simdBlockSize + half), dx),
+                                         _mm256_mul_pd(_mm256_loadu_pd(block + 5 * simdBlockSize + half), dy));
+            __m256d gamma = _mm256_sub_pd(_mm256_sub_pd(one, alpha), beta);
+            __m256d inside = _mm256_and_pd(_mm256_and_pd(_mm256_cmp_pd(alpha, zero, _CMP_GT_OQ),
+                                                         _mm256_cmp_pd(beta, zero, _CMP_GT_OQ)),
+                                           _mm256_cmp_pd(gamma, zero, _CMP_GT_OQ));
+            if (_mm256_movemask_pd(inside))
+                return true;
+        }
+    }
+    return false;
+}
+
+/*!
+*  \brief      AVX-512 kernel of the point in triangle test, one register holds the eight lanes.
+*  \author     Sascha Kaden
+*  \param[in]  triangle blocks
+*  \param[in]  number of blocks
+*  \param[in]  x
+*  \param[in]  y
+*  \param[out] true if the point is inside of a triangle
+*  \date       2017-12-09
+*/
+__attribute__((target("avx512f"))) static bool trianglesContainAvx512(const double *blocks, const size_t numBlocks,
+                                                                       const double x, const double y) {
+    const __m512d px = _mm512_set1_pd(x);
+    const __m512d py = _mm512_set1_pd(y);
+    const __m512d zero = _mm512_setzero_pd();
+    const __m512d one = _mm512_set1_pd(1);
+    for (size_t blockIndex = 0; blockIndex < numBlocks; ++blockIndex) {
+        const double *block = blocks + blockIndex * triangleCoefficients * simdBlockSize;
+        __m512d dx = _mm512_sub_pd(px, _mm512_loadu_pd(block));
+        __m512d dy = _mm512_sub_pd(py, _mm512_loadu_pd(block + simdBlockSize));
+        __m512d alpha = _mm512_add_pd(_mm512_mul_pd(_mm512_loadu_pd(block + 2 * simdBlockSize), dx),
+                                      _mm512_mul_pd(_mm512_loadu_pd(block + 3 * simdBlockSize), dy));
+        __m512d beta = _mm512_add_pd(_mm512_mul_pd(_mm512_loadu_pd(block + 4 * simdBlockSize), dx),
+                                     _mm512_mul_pd(_mm512_loadu_pd(block + 5 * simdBlockSize), dy));
+        __m512d gamma = _mm512_sub_pd(_mm512_sub_pd(one, alpha), beta);
+        __mmask8 inside = _mm512_cmp_pd_mask(alpha, zero, _CMP_GT_OQ) & _mm512_cmp_pd_mask(beta, zero, _CMP_GT_OQ) &
+                          _mm512_cmp_pd_mask(gamma, zero, _CMP_GT_OQ);
+        if (inside)
+            return true;
+    }
+    return false;
+}
+#endif
+
+/*!
+*  \brief      Returns the fastest point in triangle kernel, which is supported by the running CPU.
+*  \author     Sascha Kaden
+*  \param[out] triangle block function
+*  \date       2017-12-09
+*/
+static TriangleBlockFunction getTriangleBlockFunction() {
+#ifdef IPPP_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return &trianglesContainAvx512;
+    if (__builtin_cpu_supports("avx2"))
+        return &trianglesContainAvx2;
+#endif
+    return &trianglesContainScalar;
+}
+
+/*!
+* \brief   Number of coefficients of one link transformation inside of a link block, the columns of the rotation
+* followed by the translation. A block stores them as block[coefficient * simdBlockSize + lane].
+*/
+constexpr unsigned int linkCoefficients = 12;
+
+/*!
+* \brief   Number of constant D-H parameters of one joint, sin(alpha), cos(alpha), a and d.
+*/
+constexpr unsigned int jointCoefficients = 4;
+
+/*!
+* \brief   Computes consecutive link blocks of a serial robot, the link block j + 1 is the link block j transformed by the
+* D-H transformation of joint j. links holds numJoints + 1 blocks, the first one has to be set by the caller.
+*/
+using LinkBlockFunction = void (*)(const double *joints, unsigned int numJoints, const double *sinQ, const double *cosQ,
+                                   double *links);
+
+/*!
+*  \brief      Scalar kernel of the link blocks, the loop over the lanes can be vectorized by the compiler.
+*  \details    With the columns r0, r1, r2 and the translation t of the previous link, the next link is u = cos(q) r0 +
+*  sin(q) r1, v = cos(q) r1 - sin(q) r0, (u, cos(alpha) v + sin(alpha) r2, cos(alpha) r2 - sin(alpha) v) and
+*  t + a u + d r2.
+*  \author     Sascha Kaden
+*  \param[in]  D-H constants of the joints
+*  \param[in]  number of joints
+*  \param[in]  sine of the joint angles, sinQ[joint * simdBlockSize + lane]
+*  \param[in]  cosine of the joint angles
+*  \param[in,out] link blocks
+*  \date       2017-12-12
+*/
+static void linkBlocksScalar(const double *joints, const unsigned int numJoints, const double *sinQ,
+                             const double *cosQ, double *links) {
+    constexpr unsigned int n = simdBlockSize;
+    for (unsigned int joint = 0; joint < numJoints; ++joint) {
+        const double *prev = links + joint * linkCoefficients * n;
+        double *next = links + (joint + 1) * linkCoefficients * n;
+        const double sinAlpha = joints[joint * jointCoefficients];
+        const double cosAlpha = joints[joint * jointCoefficients + 1];
+        const double a = joints[joint * jointCoefficients + 2];
+        const double d = joints[joint * jointCoefficients + 3];
+        for (unsigned int row = 0; row < 3; ++row) {
+            for (unsigned int lane = 0; lane < n; ++lane) {
+                double sq = sinQ[joint * n + lane];
+                double cq = cosQ[joint * n + lane];
+                double r0 = prev[row * n + lane];
+                double r1 = prev[(3 + row) * n + lane];
+                double r2 = prev[(6 + row) * n + lane];
+                double u = cq * r0 + sq * r1;
+                double v = cq * r1 - sq * r0;
+                next[row * n + lane] = u;
+                next[(3 + row) * n + lane] = cosAlpha * v + sinAlpha * r2;
+                next[(6 + row) * n + lane] = cosAlpha * r2 - sinAlpha * v;
+                next[(9 + row) * n + lane] = prev[(9 + row) * n + lane] + a * u + d * r2;
+            }
+        }
+    }
+}
+
+#ifdef IPPP_SIMD_X86
+/*!
+*  \brief      AVX2 kernel of the link blocks, two registers hold the eight lanes.
+*  \author     Sascha Kaden
+*  \param[in]  D-H constants of the joints
+*  \param[in]  number of joints
+*  \param[in]  sine of the joint angles, sinQ[joint * simdBlockSize + lane]
+*  \param[in]  cosine of the joint angles
+*  \param[in,out] link blocks
+*  \date       2017-12-12
+*/
+__attribute__((target("avx2"))) static void linkBlocksAvx2(const double *joints, const unsigned int numJoints,
+                                                            const double *sinQ, const double *cosQ, double *links) {
+    constexpr unsigned int n = simdBlockSize;
+    for (unsigned int joint = 0; joint < numJoints; ++joint) {
+        const double *prev = links + joint * linkCoefficients * n;
+        double *next = links + (joint + 1) * linkCoefficients * n;
+        const __m256d sinAlpha = _mm256_set1_pd(joints[joint * jointCoefficients]);
+        const __m256d cosAlpha = _mm256_set1_pd(joints[joint * jointCoefficients + 1]);
+        const __m256d a = _mm256_set1_pd(joints[joint * jointCoefficients + 2]);
+        const __m256d d = _mm256_set1_pd(joints[joint * jointCoefficients + 3]);
+        for (unsigned int half = 0; half < n; half += 4) {
+            const __m256d sq = _mm256_loadu_pd(sinQ + joint * n + half);
+            const __m256d cq = _mm256_loadu_pd(cosQ + joint * n + half);
+            for (unsigned int row = 0; row < 3; ++row) {
+                __m256d r0 = _mm256_loadu_pd(prev + row * n + half);
+                __m256d r1 = _mm256_loadu_pd(prev + (3 + row) * n + half);
+                __m256d r2 = _mm256_loadu_pd(prev + (6 + row) * n + half);
+                __m256d t = _mm256_loadu_pd(prev + (9 + row) * n + half);
+                __m256d u = _mm256_add_pd(_mm256_mul_pd(cq, r0), _mm256_mul_pd(sq, r1));
+                __m256d v = _mm256_sub_pd(_mm256_mul_pd(cq, r1), _mm256_mul_pd(sq, r0));
+                _mm256_storeu_pd(next + row * n + half, u);
+                _mm256_storeu_pd(next + (3 + row) * n + half,
+                                 _mm256_add_pd(_mm256_mul_pd(cosAlpha, v), _mm256_mul_pd(sinAlpha, r2)));
+                _mm256_storeu_pd(next + (6 + row) * n + half,
+                                 _mm256_sub_pd(_mm256_mul_pd(cosAlpha, r2), _mm256_mul_pd(sinAlpha, v)));
+                _mm256_storeu_pd(next + (9 + row) * n + half,
+                                 _mm256_add_pd(t, _mm256_add_pd(_mm256_mul_pd(a, u), _mm256_mul_pd(d, r2))));
+            }
+        }
+    }
+}
+
+/*!
+*  \brief      AVX-512 kernel of the link blocks, one register holds the eight lanes.
+*  \author     Sascha Kaden
+*  \param[in]  D-H constants of the joints
+*  \param[in]  number of joints
+*  \param[in]  sine of the joint angles, sinQ[joint * simdBlockSize + lane]
+*  \param[in]  cosine of the joint angles
+*  \param[in,out] link blocks
+*  \date       2017-12-12
+*/
+__attribute__((target("avx512f"))) static void linkBlocksAvx512(const double *joints, const unsigned int numJoints,
+                                                                 const double *sinQ, const double *cosQ,
+                                                                 double *links) {
+    constexpr unsigned int n = simdBlockSize;
+    for (unsigned int joint = 0; joint < numJoints; ++joint) {
+        const double *prev = links + joint * linkCoefficients * n;
+        double *next = links + (joint + 1) * linkCoefficients * n;
+        const __m512d sinAlpha = _mm512_set1_pd(joints[joint * jointCoefficients]);
+        const __m512d cosAlpha = _mm512_set1_pd(joints[joint * jointCoefficients + 1]);
+        const __m512d a = _mm512_set1_pd(joints[joint * jointCoefficients + 2]);
+        const __m512d d = _mm512_set1_pd(joints[joint * jointCoefficients + 3]);
+        const __m512d sq = _mm512_loadu_pd(sinQ + joint * n);
+        const __m512d cq = _mm512_loadu_pd(cosQ + joint * n);
+        for (unsigned int row = 0; row < 3; ++row) {
+            __m512d r0 = _mm512_loadu_pd(prev + row * n);
+            __m512d r1 = _mm512_loadu_pd(prev + (3 + row) * n);
+            __m512d r2 = _mm512_loadu_pd(prev + (6 + row) * n);
+            __m512d t = _mm512_loadu_pd(prev + (9 + row) * n);
+            __m512d u = _mm512_fmadd_pd(cq, r0, _mm512_mul_pd(sq, r1));
+            __m512d v = _mm512_fmsub_pd(cq, r1, _mm512_mul_pd(sq, r0));
+            _mm512_storeu_pd(next + row * n, u);
+            _mm512_storeu_pd(next + (3 + row) * n, _mm512_fmadd_pd(cosAlpha, v, _mm512_mul_pd(sinAlpha, r2)));
+            _mm512_storeu_pd(next + (6 + row) * n, _mm512_fmsub_pd(cosAlpha, r2, _mm512_mul_pd(sinAlpha, v)));
+            _mm512_storeu_pd(next + (9 + row) * n, _mm512_fmadd_pd(a, u, _mm512_fmadd_pd(d, r2, t)));
+        }
+    }
+}
+#endif
+
+/*!
+*  \brief      Returns the fastest link block kernel, which is supported by the running CPU.
+*  \author     Sascha Kaden
+*  \param[out] link block function
+*  \date       2017-12-12
+*/
+static LinkBlockFunction getLinkBlockFunction() {
+#ifdef IPPP_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return &linkBlocksAvx512;
+    if (__builtin_cpu_supports("avx2"))
+        return &linkBlocksAvx2;
+#endif
+    return &linkBlocksScalar;
+}
+
+} /* namespace util */
+} /* namespace ippp */
+
+#endif /* UTILSIMD_HPP */
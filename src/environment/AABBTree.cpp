@@ -0,0 +1,150 @@
+//-------------------------------------------------------------------------//
+//
+// Copyright 2017 Sascha Kaden
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-------------------------------------------------------------------------//
+
+#include <ippp/environment/AABBTree.h>
+
+#include <algorithm>
+#include <numeric>
+
+namespace ippp {
+
+/*!
+*  \brief      Standard constructor of the class AABBTree, creates an empty tree.
+*  \author     Sascha Kaden
+*  \date       2017-12-01
+*/
+AABBTree::AABBTree() {
+}
+
+/*!
+*  \brief      Constructor of the class AABBTree, builds the tree from the passed AABBs.
+*  \author     Sascha Kaden
+*  \param[in]  AABBs of the obstacles
+*  \date       2017-12-01
+*/
+AABBTree::AABBTree(const std::vector<AABB> &aabbs) {
+    build(aabbs);
+}
+
+/*!
+*  \brief      Builds the tree from the passed AABBs, the indices of the query results are the indices of the vector.
+*  \details    The nodes are split at the median of the AABB centers along the longest axis.
+*  \author     Sascha Kaden
+*  \param[in]  AABBs of the obstacles
+*  \date       2017-12-01
+*/
+void AABBTree::build(const std::vector<AABB> &aabbs) {
+    m_nodes.clear();
+    m_aabbs.clear();
+    m_indices.resize(aabbs.size());
+    std::iota(m_indices.begin(), m_indices.end(), 0);
+    if (aabbs.empty())
+        return;
+
+    std::vector<Vector3> centers;
+    centers.reserve(aabbs.size());
+    for (auto &aabb : aabbs)
+        centers.push_back(aabb.center());
+
+    m_nodes.reserve(2 * aabbs.size() / m_leafSize + 1);
+    buildNode(aabbs, centers, 0, aabbs.size());
+
+    m_aabbs.reserve(aabbs.size());
+    for (auto &index : m_indices)
+        m_aabbs.push_back(aabbs[index]);
+}
+
+/*!
+*  \brief      Appends the indices of all obstacles, whose AABB intersects the passed AABB.
+*  \author     Sascha Kaden
+*  \param[in]  query AABB
+*  \param[out] indices of the obstacles
+*  \date       2017-12-01
+*/
+void AABBTree::query(const AABB &aabb, std::vector<size_t> &indices) const {
+    forEachCandidate(aabb, [&indices](const size_t index) {
+        indices.push_back(index);
+        return false;
+    });
+}
+
+/*!
+*  \brief      Return the number of AABBs inside of the tree
+*  \author     Sascha Kaden
+*  \param[out] number of AABBs
+*  \date       2017-12-01
+*/
+size_t AABBTree::size() const {
+    return m_indices.size();
+}
+
+/*!
+*  \brief      Return true, if the tree contains no AABB
+*  \author     Sascha Kaden
+*  \param[out] empty
+*  \date       2017-12-01
+*/
+bool AABBTree::empty() const {
+    return m_indices.empty();
+}
+
+/*!
+*  \brief      Creates the node of the index range and recursively its children.
+*  \author     Sascha Kaden
+*  \param[in]  AABBs of the obstacles
+*  \param[in]  centers of the AABBs
+*  \param[in]  first index of the range
+*  \param[in]  end of the range
+*  \param[out] index of the created node
+*  \date       2017-12-01
+*/
+size_t AABBTree::buildNode(const std::vector<AABB> &aabbs, const std::vector<Vector3> &centers, const size_t begin,
+                           const size_t end) {
+    size_t nodeIndex = m_nodes.size();
+    m_nodes.push_back(TreeNode());
+
+    AABB nodeAABB(aabbs[m_indices[begin]]);
+    AABB centerBounding(centers[m_indices[begin]], centers[m_indices[begin]]);
+    for (size_t i = begin + 1; i < end; ++i) {
+        nodeAABB.extend(aabbs[m_indices[i]]);
+        centerBounding.extend(centers[m_indices[i]]);
+    }
+    m_nodes[nodeIndex].aabb = nodeAABB;
+
+    if (end - begin <= m_leafSize) {
+        m_nodes[nodeIndex].leaf = true;
+        m_nodes[nodeIndex].left = begin;
+        m_nodes[nodeIndex].right = end - begin;
+        return nodeIndex;
+    }
+
+    Vector3::Index axis;
+    centerBounding.sizes().maxCoeff(&axis);
+    size_t middle = begin + (end - begin) / 2;
+    std::nth_element(m_indices.begin() + begin, m_indices.begin() + middle, m_indices.begin() + end,
+                     [&centers, axis](const size_t a, const size_t b) { return centers[a][axis] < centers[b][axis]; });
+
+    size_t left = buildNode(aabbs, centers, begin, middle);
+    size_t right = buildNode(aabbs, centers, middle, end);
+    m_nodes[nodeIndex].leaf = false;
+    m_nodes[nodeIndex].left = left;
+    m_nodes[nodeIndex].right = right;
+    return nodeIndex;
+}
+
+} /* namespace ippp */
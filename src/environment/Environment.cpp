@@ -92,6 +92,8 @@ Environment::~Environment() = default;
 */
 void Environment::addObstacle(const std::shared_ptr<ModelContainer> &model) {
     m_obstacles.push_back(model);
+    m_obstacleAABBs.push_back(model ? model->getAABB() : AABB());
+    m_obstacleTreeDirty = true;
 }
 
 /*!
@@ -101,8 +103,11 @@ void Environment::addObstacle(const std::shared_ptr<ModelContainer> &model) {
 *  \date       2017-05-17
 */
 void Environment::addObstacles(const std::vector<std::shared_ptr<ModelContainer>> &models) {
-    for (auto &model : models)
+    for (auto &model : models) {
         m_obstacles.push_back(model);
+        m_obstacleAABBs.push_back(model ? model->getAABB() : AABB());
+    }
+    m_obstacleTreeDirty = true;
 }
 
 /*!
@@ -140,6 +145,32 @@ size_t Environment::getObstacleNum() const {
     return m_obstacles.size();
 }
 
+/*!
+*  \brief      Return the AABBs of the obstacles, the index equals the index of the obstacle
+*  \author     Sascha Kaden
+*  \param[out] list of obstacle AABBs
+*  \date       2017-12-01
+*/
+std::vector<AABB> Environment::getObstacleAABBs() const {
+    return m_obstacleAABBs;
+}
+
+/*!
+*  \brief      Return the broadphase of the obstacles, it is shared by all collision detections.
+*  \details    Adding obstacles only marks the tree as outdated, it is build once at the next call.
+*  \author     Sascha Kaden
+*  \param[out] AABBTree of the obstacles
+*  \date       2017-12-01
+*/
+const AABBTree &Environment::getObstacleTree() const {
+    std::lock_guard<std::mutex> lock(m_obstacleTreeMutex);
+    if (m_obstacleTreeDirty) {
+        m_obstacleTree.build(m_obstacleAABBs);
+        m_obstacleTreeDirty = false;
+    }
+    return m_obstacleTree;
+}
+
 /*!
 *  \brief      Add robot to the Environment
 *  \author     Sascha Kaden
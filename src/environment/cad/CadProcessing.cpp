@@ -18,6 +18,8 @@
 
 #include <ippp/environment/cad/CadProcessing.h>
 
+#include <algorithm>
+#include <functional>
 #include <numeric>
 #include <fstream>
 #include <iostream>
@@ -222,6 +224,94 @@ AABB computeAABB(const std::vector<Triangle2D> &triangles) {
     return computeAABB(generateMesh(triangles));
 }
 
+/*!
+*  \brief      Compute the two level sphere hierarchy of the mesh.
+*  \details    The mesh is cut into slabs of equal width along the longest axis of its AABB. Every triangle is clipped
+*  to the slabs it crosses and each slab gets the sphere around the AABB center of its clipped polygons. Spheres are
+*  convex, so enclosing the corners of a clipped polygon encloses the whole polygon. Meshes without faces get only the
+*  root sphere as leaf.
+*  \author     Sascha Kaden
+*  \param[in]  mesh
+*  \param[in]  maximal number of leaf spheres
+*  \param[out] BoundingSpheres
+*  \date       2017-12-13
+*/
+BoundingSpheres computeBoundingSpheres(const Mesh &mesh, const size_t numLeaves) {
+    BoundingSpheres spheres;
+    if (mesh.vertices.empty())
+        return spheres;
+
+    // padding against the rounding of the transformations
+    auto pad = [](double radius) { return radius * (1 + 1e-9) + 1e-9; };
+
+    AABB aabb = computeAABB(mesh.vertices);
+    spheres.center = aabb.center();
+    spheres.radius = 0;
+    for (auto &vertex : mesh.vertices)
+        spheres.radius = std::max(spheres.radius, (vertex - spheres.center).norm());
+    spheres.radius = pad(spheres.radius);
+
+    size_t numSlabs = numLeaves < BoundingSpheres::maxLeaves ? numLeaves : BoundingSpheres::maxLeaves;
+    Eigen::Index axis;
+    double length = aabb.sizes().maxCoeff(&axis);
+    if (mesh.faces.empty() || numSlabs <= 1 || length <= 0) {
+        spheres.centers[0] = spheres.center;
+        spheres.radii[0] = spheres.radius;
+        spheres.numLeaves = 1;
+        return spheres;
+    }
+
+    // calls func with the corners of the triangle clipped to the slab
+    double width = length / numSlabs;
+    auto forEachCorner = [&](const Vector3i &face, const size_t slab, const std::function<void(const Vector3 &)> &func) {
+        double lower = aabb.min()[axis] + slab * width;
+        double upper = (slab + 1 == numSlabs) ? aabb.max()[axis] : lower + width;
+        for (unsigned int i = 0; i < 3; ++i) {
+            const Vector3 &p = mesh.vertices[face[i]];
+            const Vector3 &q = mesh.vertices[face[(i + 1) % 3]];
+            if (p[axis] >= lower && p[axis] <= upper)
+                func(p);
+            for (double plane : {lower, upper}) {
+                if ((p[axis] - plane) * (q[axis] - plane) < 0) {
+                    double t = (plane - p[axis]) / (q[axis] - p[axis]);
+                    Vector3 point = p + t * (q - p);
+                    point[axis] = plane;
+                    func(point);
+                }
+            }
+        }
+    };
+    auto getSlab = [&](const double value) {
+        return std::min(numSlabs - 1, static_cast<size_t>(std::max(0.0, (value - aabb.min()[axis]) / width)));
+    };
+
+    std::vector<AABB> slabAABBs(numSlabs);
+    std::vector<double> slabRadii(numSlabs, 0);
+    for (unsigned int pass = 0; pass < 2; ++pass) {
+        for (auto &face : mesh.faces) {
+            double min = std::min({mesh.vertices[face[0]][axis], mesh.vertices[face[1]][axis], mesh.vertices[face[2]][axis]});
+            double max = std::max({mesh.vertices[face[0]][axis], mesh.vertices[face[1]][axis], mesh.vertices[face[2]][axis]});
+            for (size_t slab = getSlab(min); slab <= getSlab(max); ++slab) {
+                if (pass == 0)
+                    forEachCorner(face, slab, [&](const Vector3 &point) { slabAABBs[slab].extend(point); });
+                else
+                    forEachCorner(face, slab, [&](const Vector3 &point) {
+                        slabRadii[slab] = std::max(slabRadii[slab], (point - slabAABBs[slab].center()).norm());
+                    });
+            }
+        }
+    }
+
+    for (size_t slab = 0; slab < numSlabs; ++slab) {
+        if (slabAABBs[slab].isEmpty())
+            continue;
+        spheres.centers[spheres.numLeaves] = slabAABBs[slab].center();
+        spheres.radii[spheres.numLeaves] = pad(slabRadii[slab]);
+        ++spheres.numLeaves;
+    }
+    return spheres;
+}
+
 } /* namespace cad */
 
 } /* namespace ippp */
@@ -17,6 +17,7 @@
 //-------------------------------------------------------------------------//
 
 #include <ippp/util/Logging.h>
+#include <ippp/environment/cad/CadProcessing.h>
 #include <ippp/environment/model/ModelContainer.h>
 
 namespace ippp {
@@ -47,4 +48,23 @@ AABB ModelContainer::getAABB() const {
     return m_mesh.aabb;
 }
 
+/*!
+*  \brief      Compute and store the bounding spheres of the current mesh, has to be called after the mesh was changed.
+*  \author     Sascha Kaden
+*  \date       2017-12-15
+*/
+void ModelContainer::updateBoundingSpheres() {
+    m_boundingSpheres = cad::computeBoundingSpheres(m_mesh);
+}
+
+/*!
+*  \brief      Return the stored bounding spheres of the model.
+*  \param[out] BoundingSpheres
+*  \author     Sascha Kaden
+*  \date       2017-12-13
+*/
+const BoundingSpheres &ModelContainer::getBoundingSpheres() const {
+    return m_boundingSpheres;
+}
+
 } /* namespace ippp */
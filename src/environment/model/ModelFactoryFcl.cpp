@@ -46,6 +46,7 @@ std::shared_ptr<ModelContainer> ModelFactoryFcl::createModel(const std::string &
         return nullptr;
     }
     fclModel->m_mesh.aabb = cad::computeAABB(fclModel->m_mesh);
+    fclModel->updateBoundingSpheres();
 
     std::vector<fcl::Vec3f> vertices;
     std::vector<fcl::Triangle> triangles;
@@ -78,6 +79,7 @@ std::vector<std::shared_ptr<ModelContainer>> ModelFactoryFcl::createModels(const
         std::shared_ptr<ModelFcl> fclModel(new ModelFcl());
         fclModel->m_mesh = mesh;
         fclModel->m_mesh.aabb = cad::computeAABB(fclModel->m_mesh);
+        fclModel->updateBoundingSpheres();
 
         std::vector<fcl::Vec3f> vertices;
         std::vector<fcl::Triangle> triangles;
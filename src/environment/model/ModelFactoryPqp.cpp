@@ -50,6 +50,7 @@ std::shared_ptr<ModelContainer> ModelFactoryPqp::createModel(const std::string &
         return nullptr;
     }
     pqpModel->m_mesh.aabb = cad::computeAABB(pqpModel->m_mesh);
+    pqpModel->updateBoundingSpheres();
 
     // create PQP model
     pqpModel->m_pqpModel.BeginModel();
@@ -92,6 +93,7 @@ std::vector<std::shared_ptr<ModelContainer>> ModelFactoryPqp::createModels(const
         std::shared_ptr<ModelPqp> pqpModel(new ModelPqp());
         pqpModel->m_mesh = mesh;
         pqpModel->m_mesh.aabb = cad::computeAABB(pqpModel->m_mesh);
+        pqpModel->updateBoundingSpheres();
 
         // create PQP model
         pqpModel->m_pqpModel.BeginModel();
@@ -49,6 +49,7 @@ std::shared_ptr<ModelContainer> ModelFactoryTriangle2D::createModel(const std::s
     for (auto vertex : triangleModel->m_mesh.vertices)
         vertex[2] = 0;
     triangleModel->m_mesh.aabb = cad::computeAABB(triangleModel->m_mesh);
+    triangleModel->updateBoundingSpheres();
     triangleModel->m_triangles = cad::generateTriangles(triangleModel->m_mesh);
 
     return triangleModel;
@@ -72,6 +73,7 @@ std::vector<std::shared_ptr<ModelContainer>> ModelFactoryTriangle2D::createModel
         for (auto vertex : triangleModel->m_mesh.vertices)
             vertex[2] = 0;
         triangleModel->m_mesh.aabb = cad::computeAABB(mesh);
+        triangleModel->updateBoundingSpheres();
         triangleModel->m_triangles = cad::generateTriangles(triangleModel->m_mesh);
         models.push_back(triangleModel);
     }
@@ -110,6 +112,7 @@ std::shared_ptr<ModelContainer> ModelFactoryTriangle2D::createModel(const std::v
     std::shared_ptr<ModelTriangle2D> triangleModel(new ModelTriangle2D());
     triangleModel->m_triangles = triangles;
     triangleModel->m_mesh = cad::generateMesh(triangles);
+    triangleModel->updateBoundingSpheres();
     return triangleModel;
 }
 
@@ -47,6 +47,7 @@ void ModelFcl::transformModel(const Transform &T) {
 
     cad::transformVertices(T, m_mesh.vertices);
     m_mesh.aabb = cad::computeAABB(m_mesh);
+    updateBoundingSpheres();
 
     updateFclModel();
 }
@@ -65,6 +66,7 @@ void ModelFcl::transformModel(const Vector6 &config) {
 
     cad::transformVertices(config, m_mesh.vertices);
     m_mesh.aabb = cad::computeAABB(m_mesh);
+    updateBoundingSpheres();
 
     updateFclModel();
 }
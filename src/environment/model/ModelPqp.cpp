@@ -55,6 +55,7 @@ void ModelPqp::transformModel(const Vector6 &config) {
     }
     cad::transformVertices(config, m_mesh.vertices);
     m_mesh.aabb = cad::computeAABB(m_mesh);
+    updateBoundingSpheres();
 
     updatePqpModel();
 }
@@ -71,6 +72,7 @@ void ModelPqp::transformModel(const Transform &T) {
     }
     cad::transformVertices(T, m_mesh.vertices);
     m_mesh.aabb = cad::computeAABB(m_mesh);
+    updateBoundingSpheres();
 
     updatePqpModel();
 }
@@ -42,6 +42,7 @@ void ModelTriangle2D::transformModel(const Transform &T) {
 
     m_mesh = cad::generateMesh(m_triangles);
     m_mesh.aabb = cad::computeAABB(m_mesh);
+    updateBoundingSpheres();
 }
 
 void ModelTriangle2D::transformModel(const Vector6 &config) {
@@ -52,6 +53,7 @@ void ModelTriangle2D::transformModel(const Vector6 &config) {
 
     m_mesh = cad::generateMesh(m_triangles);
     m_mesh.aabb = cad::computeAABB(m_mesh);
+    updateBoundingSpheres();
 }
 
 } /* namespace ippp */
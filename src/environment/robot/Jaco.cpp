@@ -33,6 +33,8 @@ Jaco::Jaco() : SerialRobot("Jaco", 6, std::make_pair(util::Vecd(0, 42, 17, 0, 0,
     m_alpha = util::Vecd(util::pi() / 2, util::pi(), util::pi() / 2, 0.95993f, 0.95993f, util::pi());
     m_a = util::Vecd(0, 410, 0, 0, 0, 0);
     m_d = util::Vecd(275.5f, 0, -9.8f, -249.18224f, -83.76448f, -210.58224f);
+    m_dhScale = util::Vecd(-1, 1, 1, 1, 1, 1);
+    m_dhOffset = util::Vecd(0, -util::halfPi(), util::halfPi(), 0, -util::pi(), util::pi());
 
     ModelFactoryPqp modelFactoryPqp;
     m_baseModel = modelFactoryPqp.createModel("meshes/Jaco/jaco2_link_base.dae");
@@ -69,10 +71,10 @@ std::vector<Transform> Jaco::getJointTrafos(const VectorX &angles)  const {
     // transform form jaco physical angles to dh angles
     Vector6 dhAngles = convertRealToDH(angles);
 
-    std::vector<Transform> trafos;
+    std::vector<Transform> trafos(6);
     // create transformation matrizes
     for (size_t i = 0; i < 6; ++i)
-        trafos.push_back(getTrafo(m_alpha[i], m_a[i], m_d[i], dhAngles[i]));
+        trafos[i] = getTrafo(m_alpha[i], m_a[i], m_d[i], dhAngles[i]);
     return trafos;
 }
 
@@ -85,14 +87,7 @@ std::vector<Transform> Jaco::getJointTrafos(const VectorX &angles)  const {
 *  \date       2016-07-14
 */
 Vector6 Jaco::convertRealToDH(const Vector6 &realAngles) const{
-    Vector6 dhAngles(realAngles);
-    dhAngles[0] = -realAngles[0];
-    dhAngles[1] = realAngles[1] - util::halfPi();
-    dhAngles[2] = realAngles[2] + util::halfPi();
-    dhAngles[4] = realAngles[4] - util::pi();
-    dhAngles[5] = realAngles[5] + util::pi();
-
-    return dhAngles;
+    return m_dhScale.cwiseProduct(realAngles) + m_dhOffset;
 }
 
 } /* namespace ippp */
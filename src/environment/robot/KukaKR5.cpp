@@ -38,6 +38,7 @@ KukaKR5::KukaKR5()
     m_alpha = util::degToRad<6>(m_alpha);
     m_a = util::Vecd(180, 600, 120, 0, 0, 0);
     m_d = util::Vecd(400, 0, 0, 620, 0, 115);
+    m_dhScale = VectorX::Constant(6, util::pi() / 180);
 
     ModelFactoryPqp modelFactoryPqp;
     m_baseModel = modelFactoryPqp.createModel("meshes/KukaKR5/link0.stl");
@@ -69,7 +70,7 @@ KukaKR5::KukaKR5()
 *  \param[out] euclidean position Vec
 *  \date       2016-10-22
 */
-Transform KukaKR5::directKinematic(const Vector6 &angles)  const {
+Transform KukaKR5::directKinematic(const VectorX &angles)  const {
     std::vector<Transform> trafos = getJointTrafos(angles);
 
     return getTcp(trafos);
@@ -82,8 +83,9 @@ Transform KukaKR5::directKinematic(const Vector6 &angles)  const {
 *  \param[out] vector of transformation matrizes
 *  \date       2016-10-22
 */
-std::vector<Transform> KukaKR5::getJointTrafos(const Vector6 &angles)  const {
-    Vector6 rads = util::degToRad<6>(angles);
+std::vector<Transform> KukaKR5::getJointTrafos(const VectorX &angles)  const {
+    // the angles are passed in degree
+    VectorX rads = m_dhScale.cwiseProduct(angles);
 
     std::vector<Transform> trafos;
     for (size_t i = 0; i < 6; ++i)
@@ -18,6 +18,7 @@
 
 #include <ippp/environment/robot/RobotBase.h>
 
+#include <cmath>
 #include <utility>
 
 namespace ippp {
@@ -50,6 +51,7 @@ RobotBase::RobotBase(const std::string &name, const unsigned int dim, RobotCateg
         Logging::error("DoF Types have not the size of the robot dimension", this);
     assert(dim == m_dofTypes.size());
     m_baseModel = nullptr;
+    m_pose = Transform::Identity();
 }
 
 /*!
@@ -85,6 +87,48 @@ Transform RobotBase::getPose() const {
     return m_pose;
 }
 
+/*!
+*  \brief      Return an upper bound of the distance, which any point of the robot moves along the linear
+*  interpolation between the configurations.
+*  \details    Positional dofs move all points by their distance, rotational dofs by the angle times the radius of the
+*  base model around its origin.
+*  \author     Sascha Kaden
+*  \param[in]  source configuration
+*  \param[in]  target configuration
+*  \param[out] motion bound
+*  \date       2017-12-08
+*/
+double RobotBase::getMotionBound(const VectorX &source, const VectorX &target) const {
+    double position = 0;
+    double rotation = 0;
+    for (unsigned int i = 0; i < m_dim; ++i) {
+        double delta = target[i] - source[i];
+        if (m_dofTypes[i] == DofType::planarPos || m_dofTypes[i] == DofType::volumetricPos ||
+            m_dofTypes[i] == DofType::position)
+            position += delta * delta;
+        else
+            rotation += std::abs(delta);
+    }
+    return std::sqrt(position) + rotation * getModelRadius(m_baseModel);
+}
+
+/*!
+*  \brief      Return the maximal distance of the model to the origin of its frame, estimated by its AABB.
+*  \author     Sascha Kaden
+*  \param[in]  model
+*  \param[out] radius
+*  \date       2017-12-08
+*/
+double RobotBase::getModelRadius(const std::shared_ptr<ModelContainer> &model) const {
+    if (!model || model->empty())
+        return 0;
+
+    AABB aabb = model->getAABB();
+    if (aabb.isEmpty())
+        return 0;
+    return aabb.min().cwiseAbs().cwiseMax(aabb.max().cwiseAbs()).norm();
+}
+
 /*!
 *  \brief      Load cad models from passed vector of strings and save them intern
 *  \author     Sascha Kaden
@@ -0,0 +1,205 @@
+//-------------------------------------------------------------------------//
+//
+// Copyright 2017 Sascha Kaden
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-------------------------------------------------------------------------//
+
+#include <ippp/environment/robot/SelfCollisionMatrix.h>
+
+#include <ippp/util/Logging.h>
+
+namespace ippp {
+
+/*!
+*  \brief      Standard constructor of the SelfCollisionMatrix, all pairs are unknown
+*  \author     Sascha Kaden
+*  \date       2017-12-14
+*/
+SelfCollisionMatrix::SelfCollisionMatrix() = default;
+
+/*!
+*  \brief      Constructor of the SelfCollisionMatrix, all pairs are set to sometimes colliding
+*  \author     Sascha Kaden
+*  \param[in]  number of models (base and joints)
+*  \date       2017-12-14
+*/
+SelfCollisionMatrix::SelfCollisionMatrix(const size_t numModels)
+    : m_numModels(numModels), m_pairs(numModels * numModels, PairCollision::sometimes) {
+}
+
+/*!
+*  \brief      Constructor of the SelfCollisionMatrix from the collision counts of sampled configurations
+*  \author     Sascha Kaden
+*  \param[in]  number of models (base and joints)
+*  \param[in]  collision counts of the pairs, counts[first * numModels + second]
+*  \param[in]  number of samples
+*  \date       2017-12-14
+*/
+SelfCollisionMatrix::SelfCollisionMatrix(const size_t numModels, const std::vector<size_t> &collisionCounts,
+                                         const size_t numSamples)
+    : SelfCollisionMatrix(numModels) {
+    if (collisionCounts.size() != numModels * numModels) {
+        Logging::error("Collision counts have not the size of the matrix", "SelfCollisionMatrix");
+        return;
+    }
+    if (numSamples == 0)
+        return;
+
+    for (size_t first = 0; first < numModels; ++first) {
+        for (size_t second = first + 1; second < numModels; ++second) {
+            size_t count = collisionCounts[first * numModels + second] + collisionCounts[second * numModels + first];
+            if (count == 0)
+                setPair(first, second, PairCollision::never);
+            else if (count >= numSamples)
+                setPair(first, second, PairCollision::always);
+        }
+    }
+}
+
+/*!
+*  \brief      Return the number of models
+*  \author     Sascha Kaden
+*  \param[out] number of models
+*  \date       2017-12-14
+*/
+size_t SelfCollisionMatrix::size() const {
+    return m_numModels;
+}
+
+/*!
+*  \brief      Return true if the matrix is empty
+*  \author     Sascha Kaden
+*  \param[out] true if empty
+*  \date       2017-12-14
+*/
+bool SelfCollisionMatrix::empty() const {
+    return m_numModels == 0;
+}
+
+/*!
+*  \brief      Set the collision behavior of the pair, the matrix stays symmetric
+*  \author     Sascha Kaden
+*  \param[in]  first model index
+*  \param[in]  second model index
+*  \param[in]  PairCollision
+*  \date       2017-12-14
+*/
+void SelfCollisionMatrix::setPair(const size_t first, const size_t second, const PairCollision collision) {
+    if (first >= m_numModels || second >= m_numModels) {
+        Logging::error("Model index out of range", "SelfCollisionMatrix");
+        return;
+    }
+    m_pairs[first * m_numModels + second] = collision;
+    m_pairs[second * m_numModels + first] = collision;
+}
+
+/*!
+*  \brief      Return the collision behavior of the pair, unknown pairs are sometimes colliding
+*  \author     Sascha Kaden
+*  \param[in]  first model index
+*  \param[in]  second model index
+*  \param[out] PairCollision
+*  \date       2017-12-14
+*/
+PairCollision SelfCollisionMatrix::getPair(const size_t first, const size_t second) const {
+    if (first >= m_numModels || second >= m_numModels)
+        return PairCollision::sometimes;
+    return m_pairs[first * m_numModels + second];
+}
+
+/*!
+*  \brief      Return true if the pair has to be checked by the collision detection
+*  \author     Sascha Kaden
+*  \param[in]  first model index
+*  \param[in]  second model index
+*  \param[out] true if the pair is checked
+*  \date       2017-12-14
+*/
+bool SelfCollisionMatrix::isPairChecked(const size_t first, const size_t second) const {
+    return getPair(first, second) != PairCollision::never;
+}
+
+/*!
+*  \brief      Serialize the matrix to one row of characters per model, n (never), s (sometimes) and a (always)
+*  \author     Sascha Kaden
+*  \param[out] serialized matrix
+*  \date       2017-12-14
+*/
+std::string SelfCollisionMatrix::toString() const {
+    std::string data;
+    for (size_t first = 0; first < m_numModels; ++first) {
+        if (first > 0)
+            data += ' ';
+        for (size_t second = 0; second < m_numModels; ++second) {
+            PairCollision collision = getPair(first, second);
+            data += collision == PairCollision::never ? 'n' : (collision == PairCollision::always ? 'a' : 's');
+        }
+    }
+    return data;
+}
+
+/*!
+*  \brief      Deserialize a matrix of toString, invalid or not symmetric data returns an empty matrix
+*  \author     Sascha Kaden
+*  \param[in]  serialized matrix
+*  \param[out] SelfCollisionMatrix
+*  \date       2017-12-14
+*/
+SelfCollisionMatrix SelfCollisionMatrix::fromString(const std::string &data) {
+    std::vector<std::string> rows;
+    std::string row;
+    for (char character : data) {
+        if (character == ' ') {
+            rows.push_back(row);
+            row.clear();
+        } else {
+            row += character;
+        }
+    }
+    if (!row.empty())
+        rows.push_back(row);
+
+    SelfCollisionMatrix matrix(rows.size());
+    for (size_t first = 0; first < rows.size(); ++first) {
+        if (rows[first].size() != rows.size()) {
+            Logging::error("Invalid matrix data", "SelfCollisionMatrix");
+            return SelfCollisionMatrix();
+        }
+        for (size_t second = 0; second < rows.size(); ++second) {
+            char character = rows[first][second];
+            if (character == 'n')
+                matrix.m_pairs[first * rows.size() + second] = PairCollision::never;
+            else if (character == 'a')
+                matrix.m_pairs[first * rows.size() + second] = PairCollision::always;
+            else if (character != 's') {
+                Logging::error("Invalid matrix data", "SelfCollisionMatrix");
+                return SelfCollisionMatrix();
+            }
+        }
+    }
+
+    // the collision detections only read one half, an asymmetric matrix would skip pairs depending on the order
+    for (size_t first = 0; first < rows.size(); ++first) {
+        for (size_t second = first + 1; second < rows.size(); ++second) {
+            if (matrix.getPair(first, second) != matrix.getPair(second, first)) {
+                Logging::error("Matrix data is not symmetric", "SelfCollisionMatrix");
+                return SelfCollisionMatrix();
+            }
+        }
+    }
+    return matrix;
+}
+
+} /* namespace ippp */
@@ -18,6 +18,9 @@
 
 #include <ippp/environment/robot/SerialRobot.h>
 
+#include <algorithm>
+#include <cmath>
+
 #include <ippp/environment/cad/CadImportExport.h>
 #include <ippp/environment/cad/CadProcessing.h>
 
@@ -35,6 +38,8 @@ SerialRobot::SerialRobot(const std::string &name, const unsigned int dim, const
                          const std::vector<DofType> &dofTypes)
     : RobotBase(name, dim, RobotCategory::serial, boundary, dofTypes) {
     m_baseOffset = Matrix4::Identity(4, 4);
+    m_dhScale = VectorX::Ones(dim);
+    m_dhOffset = VectorX::Zero(dim);
 }
 
 /*!
@@ -48,6 +53,38 @@ Transform SerialRobot::getTransformation(const VectorX &config) const {
     return getTcp(this->getJointTrafos(config));
 }
 
+/*!
+*  \brief      Return an upper bound of the distance, which any point of the links moves along the linear
+*  interpolation between the joint angles.
+*  \details    A joint rotates the following links around its axis, they move at most by the angle times their
+*  radius around the axis. The radius is bounded by the D-H offsets of the joints and the radius of the link models,
+*  the angles are scaled by the D-H scale of the robot.
+*  \author     Sascha Kaden
+*  \param[in]  source angles
+*  \param[in]  target angles
+*  \param[out] motion bound
+*  \date       2017-12-08
+*/
+double SerialRobot::getMotionBound(const VectorX &source, const VectorX &target) const {
+    // the length of the D-H translations doesn't depend on the joint angle
+    std::vector<Transform> jointTrafos = getJointTrafos(source);
+    size_t nbJoints = std::min(jointTrafos.size(), m_joints.size());
+
+    double bound = 0;
+    for (size_t i = 0; i < nbJoints; ++i) {
+        // the model of link k is placed at the frame of joint k - 1
+        double offset = 0;
+        double radius = 0;
+        for (size_t k = i + 1; k < nbJoints; ++k) {
+            offset += jointTrafos[k - 1].translation().norm();
+            radius = std::max(radius, offset + getModelRadius(m_joints[k].getModel()));
+        }
+        // the joint rotates by the scaled angle difference, e.g. degree of the KukaKR5
+        bound += std::abs(m_dhScale[i] * (target[i] - source[i])) * radius;
+    }
+    return bound;
+}
+
 /*!
 *  \brief      Create transformation matrix from the passed D-H parameter and the joint angle
 *  \author     Sascha Kaden
@@ -58,29 +95,25 @@ Transform SerialRobot::getTransformation(const VectorX &config) const {
 *  \param[out] Transform
 *  \date       2016-07-07
 */
-Transform SerialRobot::getTrafo(double alpha, double a, double /*d*/, double q) const {
-    // double sinAlpha = sin(alpha);
-    // double cosAlpha = cos(alpha);
-    // double sinQ = sin(q);
-    // double cosQ = cos(q);
-
-    // Matrix4 T = Matrix4::Zero(4, 4);
-    // T(0, 0) = cosQ;
-    // T(0, 1) = -sinQ * cosAlpha;
-    // T(0, 2) = sinQ * sinAlpha;
-    // T(0, 3) = a * cosQ;
-    // T(1, 0) = sinQ;
-    // T(1, 1) = cosQ * cosAlpha;
-    // T(1, 2) = -cosQ * sinAlpha;
-    // T(1, 3) = a * sinQ;
-    // T(2, 1) = sinAlpha;
-    // T(2, 2) = cosAlpha;
-    // T(2, 3) = d;
-    // T(3, 3) = 1;
+Transform SerialRobot::getTrafo(double alpha, double a, double d, double q) const {
+    double sinAlpha = std::sin(alpha);
+    double cosAlpha = std::cos(alpha);
+    double sinQ = std::sin(q);
+    double cosQ = std::cos(q);
 
     Transform T;
-    T = Translation(Vector3(0, 0, 3)) * Eigen::AngleAxisd(q, Eigen::Vector3d::UnitZ()) * Translation(Vector3(a, 0, 0)) *
-        Eigen::AngleAxisd(alpha, Eigen::Vector3d::UnitX());
+    T(0, 0) = cosQ;
+    T(0, 1) = -sinQ * cosAlpha;
+    T(0, 2) = sinQ * sinAlpha;
+    T(0, 3) = a * cosQ;
+    T(1, 0) = sinQ;
+    T(1, 1) = cosQ * cosAlpha;
+    T(1, 2) = -cosQ * sinAlpha;
+    T(1, 3) = a * sinQ;
+    T(2, 0) = 0;
+    T(2, 1) = sinAlpha;
+    T(2, 2) = cosAlpha;
+    T(2, 3) = d;
 
     return T;
 }
@@ -204,6 +237,82 @@ size_t SerialRobot::getNbJoints() const {
     return m_joints.size();
 }
 
+/*!
+*  \brief      Return the D-H alpha parameters
+*  \author     Sascha Kaden
+*  \param[out] alpha parameters
+*  \date       2017-12-10
+*/
+VectorX SerialRobot::getAlpha() const {
+    return m_alpha;
+}
+
+/*!
+*  \brief      Return the D-H a parameters
+*  \author     Sascha Kaden
+*  \param[out] a parameters
+*  \date       2017-12-10
+*/
+VectorX SerialRobot::getA() const {
+    return m_a;
+}
+
+/*!
+*  \brief      Return the D-H d parameters
+*  \author     Sascha Kaden
+*  \param[out] d parameters
+*  \date       2017-12-10
+*/
+VectorX SerialRobot::getD() const {
+    return m_d;
+}
+
+/*!
+*  \brief      Return the scale of the conversion from the joint angles to the D-H angles
+*  \details    The D-H angle of a joint is scale * angle + offset.
+*  \author     Sascha Kaden
+*  \param[out] scales
+*  \date       2017-12-10
+*/
+VectorX SerialRobot::getDHScale() const {
+    return m_dhScale;
+}
+
+/*!
+*  \brief      Return the offset of the conversion from the joint angles to the D-H angles
+*  \author     Sascha Kaden
+*  \param[out] offsets
+*  \date       2017-12-10
+*/
+VectorX SerialRobot::getDHOffset() const {
+    return m_dhOffset;
+}
+
+/*!
+*  \brief      Set the self collision matrix of the base and joint models.
+*  \details    The matrix has to contain the base and all joints, otherwise it is ignored.
+*  \author     Sascha Kaden
+*  \param[in]  SelfCollisionMatrix
+*  \date       2017-12-14
+*/
+void SerialRobot::setSelfCollisionMatrix(const SelfCollisionMatrix &matrix) {
+    if (!matrix.empty() && matrix.size() != getDim() + 1) {
+        Logging::error("Self collision matrix has not the size of the models", this);
+        return;
+    }
+    m_selfCollisionMatrix = matrix;
+}
+
+/*!
+*  \brief      Return the self collision matrix, empty if none was set.
+*  \author     Sascha Kaden
+*  \param[out] SelfCollisionMatrix
+*  \date       2017-12-14
+*/
+SelfCollisionMatrix SerialRobot::getSelfCollisionMatrix() const {
+    return m_selfCollisionMatrix;
+}
+
 /*!
 *  \brief      Saves the configuration of the robot by obj files in the working directory
 *  \author     Sascha Kaden
@@ -74,9 +74,9 @@ Transform SerialRobot2D::directKinematic(const VectorX &angles) const {
 *  \date       2016-10-22
 */
 std::vector<Transform> SerialRobot2D::getJointTrafos(const VectorX &angles) const {
-    std::vector<Transform> trafos;
+    std::vector<Transform> trafos(getDim());
     for (size_t i = 0; i < getDim(); ++i)
-        trafos.push_back(getTrafo(m_alpha[i], m_a[i], m_d[i], angles[i]));
+        trafos[i] = getTrafo(m_alpha[i], m_a[i], m_d[i], angles[i]);
     return trafos;
 }
 
@@ -48,6 +48,8 @@ bool EnvironmentConfigurator::saveConfig(const std::string &filePath) {
     json["MaxWorkspaceBound"] = vectorToString<3>(topRight);
     json["FactoryType"] = static_cast<int>(m_factoryType);
     json["RobotType"] = static_cast<int>(m_robotType);
+    if (!m_selfCollisionMatrix.empty())
+        json["SelfCollisionMatrix"] = m_selfCollisionMatrix.toString();
 
     return saveJson(filePath, json);
 }
@@ -74,6 +76,9 @@ bool EnvironmentConfigurator::loadConfig(const std::string &filePath) {
     m_workspceBounding = AABB(bottomLeft, topRight);
     m_factoryType = static_cast<FactoryType>(json["FactoryType"].get<int>());
     m_robotType = static_cast<RobotType>(json["RobotType"].get<int>());
+    m_selfCollisionMatrix = SelfCollisionMatrix();
+    if (json.count("SelfCollisionMatrix"))
+        m_selfCollisionMatrix = SelfCollisionMatrix::fromString(json["SelfCollisionMatrix"].get<std::string>());
 
     return true;
 }
@@ -138,6 +143,16 @@ void EnvironmentConfigurator::setRobotType(const RobotType robotType, const std:
     m_robotFile = robotFile;
 }
 
+/*!
+*  \brief      Sets the SelfCollisionMatrix, which is passed to created serial robots.
+*  \author     Sascha Kaden
+*  \param[in]  SelfCollisionMatrix
+*  \date       2017-12-14
+*/
+void EnvironmentConfigurator::setSelfCollisionMatrix(const SelfCollisionMatrix &matrix) {
+    m_selfCollisionMatrix = matrix;
+}
+
 /*!
 *  \brief      Returns the created Environment with the specified options.
 *  \author     Sascha Kaden
@@ -176,6 +191,10 @@ std::shared_ptr<Environment> EnvironmentConfigurator::getEnvironment() {
             tempMax[i] = max[i];
         }
         m_robot = std::make_shared<PointRobot>(std::make_pair(tempMin, tempMax));
+    } else if (m_robotType == RobotType::Jaco) {
+        m_robot = std::make_shared<Jaco>();
+    } else if (m_robotType == RobotType::Kuka) {
+        m_robot = std::make_shared<KukaKR5>();
     } else if (m_robotType == RobotType::Serial2D) {
         m_robot = std::make_shared<SerialRobot2D>();
     } else if (m_robotType == RobotType::Mobile) {
@@ -198,6 +217,10 @@ std::shared_ptr<Environment> EnvironmentConfigurator::getEnvironment() {
         m_robot = std::make_shared<TriangleRobot2D>(robotModel, std::make_pair(tempMin, tempMax));
     }
 
+    // the loaded matrix belongs to the configured serial robot, whichever type it is
+    if (m_robot && m_robot->getRobotCategory() == RobotCategory::serial && !m_selfCollisionMatrix.empty())
+        std::static_pointer_cast<SerialRobot>(m_robot)->setSelfCollisionMatrix(m_selfCollisionMatrix);
+
     if (m_robot)
         m_environment->addRobot(m_robot);
 
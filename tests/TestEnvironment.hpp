@@ -0,0 +1,101 @@
+//-------------------------------------------------------------------------//
+//
+// Copyright 2017 Sascha Kaden
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-------------------------------------------------------------------------//
+
+#ifndef TESTENVIRONMENT_HPP
+#define TESTENVIRONMENT_HPP
+
+#include <ippp/environment/Environment.h>
+#include <ippp/environment/cad/CadProcessing.h>
+#include <ippp/environment/model/PointModel.h>
+#include <ippp/environment/robot/PointRobot.h>
+
+namespace ippp {
+namespace test {
+
+/*!
+*  \brief      Create a planar model out of the triangle fan of the passed corners
+*  \author     Sascha Kaden
+*  \param[in]  corners of the convex polygon
+*  \param[out] model
+*  \date       2017-12-15
+*/
+inline std::shared_ptr<PointModel> createPolygon(const std::vector<Vector2> &corners) {
+    auto model = std::make_shared<PointModel>();
+    for (auto &corner : corners)
+        model->m_mesh.vertices.push_back(Vector3(corner[0], corner[1], 0));
+    for (int i = 1; i + 1 < static_cast<int>(corners.size()); ++i)
+        model->m_mesh.faces.push_back(Vector3i(0, i, i + 1));
+    model->m_mesh.aabb = cad::computeAABB(model->m_mesh);
+    return model;
+}
+
+/*!
+*  \brief      Create a planar rectangle model out of two triangles
+*  \author     Sascha Kaden
+*  \param[in]  minimum corner
+*  \param[in]  maximum corner
+*  \param[out] model
+*  \date       2017-12-15
+*/
+inline std::shared_ptr<PointModel> createRectangle(const Vector2 &min, const Vector2 &max) {
+    return createPolygon({min, Vector2(max[0], min[1]), max, Vector2(min[0], max[1])});
+}
+
+/*!
+*  \brief      Create a planar Environment of 100 x 100 with a PointRobot and the passed obstacles
+*  \author     Sascha Kaden
+*  \param[in]  obstacles
+*  \param[out] Environment
+*  \date       2017-12-15
+*/
+inline std::shared_ptr<Environment> createPointEnvironment(
+    const std::vector<std::shared_ptr<ModelContainer>> &obstacles = std::vector<std::shared_ptr<ModelContainer>>()) {
+    auto robot = std::make_shared<PointRobot>(std::make_pair(Vector2(0, 0), Vector2(100, 100)));
+    auto environment = std::make_shared<Environment>(2, AABB(Vector3(0, 0, 0), Vector3(100, 100, 100)), robot);
+    environment->addObstacles(obstacles);
+    return environment;
+}
+
+/*!
+*  \brief      Create the planar Environment with one triangle obstacle in the center
+*  \author     Sascha Kaden
+*  \param[out] Environment
+*  \date       2017-12-15
+*/
+inline std::shared_ptr<Environment> createTriangleEnvironment() {
+    return createPointEnvironment({createPolygon({Vector2(40, 40), Vector2(60, 40), Vector2(50, 60)})});
+}
+
+/*!
+*  \brief      Create the planar Environment with a grid of 4 x 4 square obstacles
+*  \author     Sascha Kaden
+*  \param[out] Environment
+*  \date       2017-12-15
+*/
+inline std::shared_ptr<Environment> createGridEnvironment() {
+    std::vector<std::shared_ptr<ModelContainer>> obstacles;
+    for (double x = 10; x < 90; x += 20)
+        for (double y = 10; y < 90; y += 20)
+            obstacles.push_back(createRectangle(Vector2(x, y), Vector2(x + 10, y + 10)));
+    return createPointEnvironment(obstacles);
+}
+
+} /* namespace test */
+} /* namespace ippp */
+
+#endif /* TESTENVIRONMENT_HPP */
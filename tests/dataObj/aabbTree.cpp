@@ -0,0 +1,105 @@
+//-------------------------------------------------------------------------//
+//
+// Copyright 2017 Sascha Kaden
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-------------------------------------------------------------------------//
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include <ippp/environment/AABBTree.h>
+#include <ippp/environment/Environment.h>
+#include <ippp/environment/model/PointModel.h>
+
+using namespace ippp;
+
+TEST(AABBTREE, empty) {
+    AABBTree tree;
+    EXPECT_TRUE(tree.empty());
+    std::vector<size_t> indices;
+    tree.query(AABB(Vector3(0, 0, 0), Vector3(1, 1, 1)), indices);
+    EXPECT_TRUE(indices.empty());
+}
+
+TEST(AABBTREE, query) {
+    std::srand(42);
+    std::vector<AABB> aabbs;
+    for (size_t i = 0; i < 500; ++i) {
+        Vector3 min = Vector3::Random() * 100;
+        aabbs.push_back(AABB(min, min + Vector3::Random().cwiseAbs() * 10));
+    }
+    AABBTree tree(aabbs);
+    EXPECT_EQ(aabbs.size(), tree.size());
+
+    for (size_t i = 0; i < 100; ++i) {
+        Vector3 min = Vector3::Random() * 100;
+        AABB query(min, min + Vector3::Random().cwiseAbs() * 20);
+
+        std::vector<size_t> indices;
+        tree.query(query, indices);
+        std::sort(indices.begin(), indices.end());
+        std::vector<size_t> expected;
+        for (size_t j = 0; j < aabbs.size(); ++j)
+            if (aabbs[j].intersects(query))
+                expected.push_back(j);
+        EXPECT_EQ(expected, indices);
+
+        // the traversal stops at the first accepted candidate
+        size_t calls = 0;
+        bool found = tree.forEachCandidate(query, [&calls](const size_t) {
+            ++calls;
+            return true;
+        });
+        EXPECT_EQ(!expected.empty(), found);
+        EXPECT_EQ(expected.empty() ? 0 : 1, calls);
+    }
+}
+
+TEST(AABBTREE, environment) {
+    // the Environment builds the broadphase of its obstacles for all collision detections
+    Environment environment(3, AABB(Vector3(-100, -100, -100), Vector3(100, 100, 100)));
+    EXPECT_TRUE(environment.getObstacleTree().empty());
+
+    std::vector<std::shared_ptr<ModelContainer>> obstacles;
+    for (size_t i = 0; i < 10; ++i) {
+        auto obstacle = std::make_shared<PointModel>();
+        obstacle->m_mesh.aabb = AABB(Vector3(i * 10, 0, 0), Vector3(i * 10 + 5, 5, 5));
+        obstacles.push_back(obstacle);
+    }
+    environment.addObstacles(obstacles);
+    auto obstacle = std::make_shared<PointModel>();
+    obstacle->m_mesh.aabb = AABB(Vector3(0, 50, 0), Vector3(5, 55, 5));
+    environment.addObstacle(obstacle);
+
+    EXPECT_EQ(environment.getObstacleTree().size(), 11);
+    EXPECT_EQ(environment.getObstacleAABBs().size(), 11);
+    std::vector<size_t> indices;
+    environment.getObstacleTree().query(AABB(Vector3(31, 1, 1), Vector3(42, 2, 2)), indices);
+    std::sort(indices.begin(), indices.end());
+    EXPECT_EQ(indices, std::vector<size_t>({3, 4}));
+    indices.clear();
+    environment.getObstacleTree().query(AABB(Vector3(1, 51, 1), Vector3(2, 52, 2)), indices);
+    EXPECT_EQ(indices, std::vector<size_t>({10}));
+
+    // obstacles added after a query are part of the next query
+    obstacle = std::make_shared<PointModel>();
+    obstacle->m_mesh.aabb = AABB(Vector3(0, 80, 0), Vector3(5, 85, 5));
+    environment.addObstacle(obstacle);
+    EXPECT_EQ(environment.getObstacleTree().size(), 12);
+    indices.clear();
+    environment.getObstacleTree().query(AABB(Vector3(1, 81, 1), Vector3(2, 82, 2)), indices);
+    EXPECT_EQ(indices, std::vector<size_t>({11}));
+}
@@ -138,3 +138,64 @@ TEST(GRAPH, RS) {
     NNS<8>();
     NNS<9>();
 }
+
+template <unsigned int dim>
+void arenaStorage() {
+    auto metric = std::make_shared<L2Metric<dim>>();
+    auto neighborFinder = std::make_shared<KDTree<dim, std::shared_ptr<Node<dim>>>>(metric);
+
+    Graph<dim> graph(0, neighborFinder, NodeStorage::Arena);
+    EXPECT_EQ(graph.getNodeStorage(), NodeStorage::Arena);
+    std::vector<std::shared_ptr<Node<dim>>> nodes;
+    for (int i = 0; i < 10000; i += 5) {
+        auto node = graph.makeNode(Vector<dim>::Constant(dim, 1, i));
+        EXPECT_EQ(node.use_count(), 0);
+        if (!nodes.empty())
+            node->setParent(nodes.back(), metric->calcDist(node->getValues(), nodes.back()->getValues()));
+        nodes.push_back(node);
+        graph.addNode(node);
+    }
+    EXPECT_EQ(graph.nodeSize(), nodes.size());
+    EXPECT_EQ(graph.edgeSize(), nodes.size() - 1);
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        EXPECT_EQ(nodes[i]->getId(), i);
+        EXPECT_EQ(graph.getNode(i), nodes[i]);
+    }
+    EXPECT_EQ(nodes[1], graph.getNearestNode(nodes[0]));
+    EXPECT_EQ(nodes[1]->getParentNode(), nodes[0]);
+
+    // child edges inside of the arena are stored as index/cost pairs
+    for (size_t i = 1; i < nodes.size(); ++i)
+        nodes[i - 1]->addChild(nodes[i], nodes[i]->getParentEdge().second, EdgeState::Unknown);
+    auto edges = nodes[0]->getChildEdges();
+    ASSERT_EQ(1, edges.size());
+    EXPECT_EQ(nodes[1], edges[0].first);
+    EXPECT_EQ(nodes[1]->getParentEdge().second, edges[0].second);
+    EXPECT_EQ(EdgeState::Unknown, nodes[0]->getChildState(nodes[1]));
+    EXPECT_EQ(EdgeState::Invalid, nodes[0]->getChildState(nodes[2]));
+    nodes[0]->setChildState(nodes[1], EdgeState::Invalid);
+    EXPECT_EQ(0, nodes[0]->getChildSize());
+    EXPECT_TRUE(nodes[0]->isInvalidChild(nodes[1]));
+    EXPECT_EQ(nodes[1], nodes[0]->getInvalidChildren()[0]);
+    EXPECT_EQ(nodes.back(), nodes[nodes.size() - 2]->getChildNodes()[0]);
+}
+
+TEST(GRAPH, arenaStorage) {
+    arenaStorage<2>();
+    arenaStorage<3>();
+    arenaStorage<6>();
+    arenaStorage<7>();
+}
+
+TEST(GRAPH, arenaLifetime) {
+    auto metric = std::make_shared<L2Metric<2>>();
+    auto neighborFinder = std::make_shared<KDTree<2, std::shared_ptr<Node<2>>>>(metric);
+    {
+        Graph<2> graph(0, neighborFinder, NodeStorage::Arena);
+        for (int i = 0; i < 100; ++i)
+            graph.addNode(graph.makeNode(Vector2(i, i)));
+        EXPECT_EQ(100, neighborFinder->searchKNearest(Vector2(0.5, 0), 200).size());
+    }
+    // the Graph clears its NeighborFinder before the arena is released
+    EXPECT_TRUE(neighborFinder->searchKNearest(Vector2(0.5, 0), 200).empty());
+}
@@ -16,6 +16,8 @@
 //
 //-------------------------------------------------------------------------//
 
+#include <thread>
+
 #include <gtest/gtest.h>
 
 #include <ippp/dataObj/Node.hpp>
@@ -124,3 +126,56 @@ TEST(NODE, children) {
     testParent<8>();
     testParent<9>();
 }
+
+template <unsigned int dim>
+void testChildState() {
+    Node<dim> node(Vector<dim>::Zero());
+    auto validChild = std::make_shared<Node<dim>>(Vector<dim>::Constant(1));
+    auto lazyChild = std::make_shared<Node<dim>>(Vector<dim>::Constant(2));
+    auto noChild = std::make_shared<Node<dim>>(Vector<dim>::Constant(3));
+
+    node.addChild(validChild, 1);
+    node.addChild(lazyChild, 2, EdgeState::Unknown);
+    EXPECT_EQ(EdgeState::Valid, node.getChildState(validChild));
+    EXPECT_EQ(EdgeState::Unknown, node.getChildState(lazyChild));
+    EXPECT_EQ(EdgeState::Invalid, node.getChildState(noChild));
+
+    node.setChildState(lazyChild, EdgeState::Valid);
+    EXPECT_EQ(EdgeState::Valid, node.getChildState(lazyChild));
+
+    // invalid edges are moved to the invalid children
+    node.setChildState(lazyChild, EdgeState::Invalid);
+    EXPECT_FALSE(node.isChild(lazyChild));
+    EXPECT_TRUE(node.isInvalidChild(lazyChild));
+    EXPECT_EQ(1, node.getChildSize());
+    EXPECT_EQ(validChild, node.getChildEdges()[0].first);
+    EXPECT_EQ(EdgeState::Valid, node.getChildState(validChild));
+}
+
+TEST(NODE, childState) {
+    testChildState<2>();
+    testChildState<3>();
+    testChildState<6>();
+}
+
+TEST(NODE, concurrentChildren) {
+    // the child edges are returned as copies, while other threads add children
+    auto node = std::make_shared<Node<2>>(Vector2(0, 0));
+    std::vector<std::shared_ptr<Node<2>>> children;
+    for (int i = 0; i < 1000; ++i)
+        children.push_back(std::make_shared<Node<2>>(Vector2(i, i)));
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 4; ++t) {
+        threads.push_back(std::thread([&, t]() {
+            for (size_t i = t; i < children.size(); i += 4) {
+                node->addChild(children[i], static_cast<double>(i));
+                for (auto &edge : node->getChildEdges())
+                    EXPECT_EQ(edge.first->getValue(0), edge.second);
+            }
+        }));
+    }
+    for (auto &thread : threads)
+        thread.join();
+    EXPECT_EQ(children.size(), node->getChildSize());
+}
@@ -16,6 +16,9 @@
 //
 //-------------------------------------------------------------------------//
 
+#include <set>
+#include <thread>
+
 #include <gtest/gtest.h>
 
 #include <ippp/Core.h>
@@ -24,6 +27,8 @@
 #include <ippp/ui/ModuleConfigurator.hpp>
 #include <ippp/ui/EnvironmentConfigurator.h>
 
+#include "../TestEnvironment.hpp"
+
 using namespace ippp;
 
 TEST(MAIN, clearWorkspace2D) {
@@ -115,3 +120,127 @@ TEST(MAIN, clearWorkspace2D) {
         }
     }
 }
+
+TEST(MAIN, frozenRoadmap) {
+    Logging::setLogLevel(LogLevel::off);
+    const unsigned int dim = 2;
+
+    EnvironmentConfigurator environmentConfig;
+    AABB workspaceBounding(Vector3(0, 0, 0), Vector3(100, 100, 100));
+    environmentConfig.setWorkspaceProperties(2, workspaceBounding);
+    environmentConfig.setRobotType(RobotType::Point);
+    auto environment = environmentConfig.getEnvironment();
+
+    ModuleConfigurator<dim> modulConfig;
+    modulConfig.setEnvironment(environment);
+    modulConfig.setCollisionType(CollisionType::Dim2);
+    modulConfig.setSamplerProperties("asldkf2o345;lfdnsa;f", 1);
+
+    PRM<dim> prm(environment, modulConfig.getPRMOptions(15), modulConfig.getGraph());
+    EXPECT_TRUE(prm.computePath(Vector2(5, 5), Vector2(95, 95), 500, 1));
+    prm.setFrozen(true);
+    EXPECT_FALSE(prm.expand(100, 1));
+    auto graph = modulConfig.getGraph();
+    size_t nodeSize = graph->nodeSize();
+    size_t edgeSize = graph->edgeSize();
+
+    const size_t numThreads = 4;
+    const size_t numQueries = 100;
+    std::vector<size_t> solved(numThreads, 0);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < numThreads; ++i) {
+        threads.push_back(std::thread([&, i]() {
+            for (size_t j = 0; j < numQueries; ++j) {
+                Vector2 start(5 + i, 5 + j * 0.5);
+                Vector2 goal(95 - i, 95 - j * 0.5);
+                auto path = prm.queryRoadmap(start, goal);
+                if (!path.empty() && path.front()->getValues() == start && path.back()->getValues() == goal)
+                    ++solved[i];
+            }
+        }));
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    for (auto &count : solved)
+        EXPECT_EQ(numQueries, count);
+    EXPECT_EQ(nodeSize, graph->nodeSize());
+    EXPECT_EQ(edgeSize, graph->edgeSize());
+
+    EXPECT_TRUE(prm.queryPath(Vector2(5, 5), Vector2(95, 95)));
+    EXPECT_EQ(nodeSize, graph->nodeSize());
+}
+
+TEST(MAIN, lazyPRM) {
+    Logging::setLogLevel(LogLevel::off);
+    const unsigned int dim = 2;
+
+    // the wall cuts all direct roadmap edges between start and goal, the lazy edges across it have to be removed
+    auto environment = test::createPointEnvironment({test::createRectangle(Vector2(45, 0), Vector2(55, 80))});
+
+    ModuleConfigurator<dim> modulConfig;
+    modulConfig.setEnvironment(environment);
+    modulConfig.setCollisionType(CollisionType::Dim2);
+    modulConfig.setSamplerProperties("asldkf2o345;lfdnsa;f", 1);
+
+    PRMOptions<dim> options = modulConfig.getPRMOptions(15);
+    options.setLazyValidation(true);
+    PRM<dim> prm(environment, options, modulConfig.getGraph());
+    ASSERT_TRUE(prm.computePath(Vector2(5, 5), Vector2(95, 95), 500, 1));
+
+    size_t invalidChildren = 0;
+    for (auto &node : prm.getGraphNodes()) {
+        invalidChildren += node->getInvalidChildren().size();
+        for (auto &child : node->getInvalidChildren())
+            EXPECT_FALSE(node->isChild(child));
+    }
+    EXPECT_GT(invalidChildren, 0);
+
+    auto collision = options.getCollisionDetection();
+    EXPECT_TRUE(collision->checkConfig(Vector2(50, 60)));
+    auto trajectory = options.getTrajectoryPlanner();
+    auto pathNodes = prm.getPathNodes();
+    for (auto node = pathNodes.begin(); node + 1 < pathNodes.end(); ++node)
+        EXPECT_TRUE(trajectory->checkTrajectory(*node, *(node + 1)));
+    for (auto &config : prm.getPath(1, 1))
+        EXPECT_FALSE(collision->checkConfig(config));
+}
+
+TEST(MAIN, replanConcurrentKDTree) {
+    Logging::setLogLevel(LogLevel::off);
+    const unsigned int dim = 2;
+
+    EnvironmentConfigurator environmentConfig;
+    AABB workspaceBounding(Vector3(0, 0, 0), Vector3(100, 100, 100));
+    environmentConfig.setWorkspaceProperties(2, workspaceBounding);
+    environmentConfig.setRobotType(RobotType::Point);
+    auto environment = environmentConfig.getEnvironment();
+
+    ModuleConfigurator<dim> modulConfig;
+    modulConfig.setEnvironment(environment);
+    modulConfig.setCollisionType(CollisionType::Dim2);
+    modulConfig.setSamplerProperties("asldkf2o345;lfdnsa;f", 1);
+    modulConfig.setNeighborFinderType(NeighborType::ConcurrentKDTree);
+
+    std::vector<NodeStorage> storages = {NodeStorage::Shared, NodeStorage::Arena};
+    for (auto &storage : storages) {
+        modulConfig.setGraphNodeStorage(storage);
+        modulConfig.resetModules();
+        RRT<dim> rrt(environment, modulConfig.getRRTOptions(15), modulConfig.getGraph());
+        ASSERT_TRUE(rrt.computePath(Vector2(5, 5), Vector2(95, 95), 300, 2));
+        // the new start creates a new tree, the nodes of the old tree may not be found anymore
+        rrt.computePath(Vector2(5, 95), Vector2(95, 5), 300, 2);
+        ASSERT_TRUE(rrt.expand(300, 2));
+        EXPECT_EQ(Vector2(5, 95), rrt.getInitNode()->getValues());
+
+        auto nodes = rrt.getGraphNodes();
+        std::set<Node<dim> *> graphNodes;
+        for (auto &node : nodes)
+            graphNodes.insert(node.get());
+        auto finder = modulConfig.getNeighborFinder();
+        auto foundNodes = finder->searchKNearest(Vector2(5, 5), nodes.size() + 10);
+        EXPECT_EQ(nodes.size(), foundNodes.size());
+        for (auto &node : foundNodes)
+            EXPECT_TRUE(graphNodes.count(node.get()));
+    }
+}
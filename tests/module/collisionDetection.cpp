@@ -0,0 +1,443 @@
+//-------------------------------------------------------------------------//
+//
+// Copyright 2017 Sascha Kaden
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-------------------------------------------------------------------------//
+
+#include <limits>
+
+#include <gtest/gtest.h>
+
+#include <ippp/environment/Environment.h>
+#include <ippp/environment/cad/CadProcessing.h>
+#include <ippp/environment/model/PointModel.h>
+#include <ippp/environment/robot/ForwardKinematics.hpp>
+#include <ippp/environment/robot/Jaco.h>
+#include <ippp/environment/robot/PointRobot.h>
+#include <ippp/environment/robot/SerialRobot2D.h>
+#include <ippp/modules/collisionDetection/CollisionDetection2D.hpp>
+#include <ippp/modules/collisionDetection/CollisionDetectionCache.hpp>
+#include <ippp/modules/collisionDetection/CollisionDetectionPqp.hpp>
+#include <ippp/modules/sampler/SamplerUniform.hpp>
+#include <ippp/ui/EnvironmentConfigurator.h>
+#include <ippp/util/UtilCollision.hpp>
+#include <ippp/util/UtilSimd.hpp>
+
+#include "../TestEnvironment.hpp"
+
+using namespace ippp;
+
+TEST(COLLISIONDETECTION, checkConfigs) {
+    Logging::setLogLevel(LogLevel::off);
+    CollisionDetection2D<2> collision(test::createGridEnvironment());
+
+    std::srand(42);
+    std::vector<Vector2> configs;
+    for (size_t i = 0; i < 1000; ++i)
+        configs.push_back(Vector2::Random().cwiseAbs() * 100);
+
+    for (size_t numThreads = 1; numThreads < 5; ++numThreads) {
+        std::vector<bool> validity = collision.checkConfigs(configs, numThreads);
+        ASSERT_EQ(configs.size(), validity.size());
+        for (size_t i = 0; i < configs.size(); ++i)
+            EXPECT_EQ(!collision.checkConfig(configs[i]), validity[i]);
+    }
+
+    EXPECT_TRUE(collision.checkConfigs(std::vector<Vector2>()).empty());
+    EXPECT_FALSE(collision.checkConfigs(std::vector<Vector2>({Vector2(12, 15)}))[0]);
+    EXPECT_TRUE(collision.checkConfigs(std::vector<Vector2>({Vector2(5, 5)}))[0]);
+}
+
+TEST(COLLISIONDETECTION, cache) {
+    Logging::setLogLevel(LogLevel::off);
+    auto environment = test::createGridEnvironment();
+    auto collision = std::make_shared<CollisionDetection2D<2>>(environment);
+    CollisionDetectionCache<2> cache(collision, environment, 1e-6, 2000);
+
+    std::srand(42);
+    std::vector<Vector2> configs;
+    for (size_t i = 0; i < 1000; ++i)
+        configs.push_back(Vector2::Random().cwiseAbs() * 100);
+
+    for (auto &config : configs)
+        EXPECT_EQ(collision->checkConfig(config), cache.checkConfig(config));
+    EXPECT_EQ(0, cache.getHits());
+    EXPECT_EQ(configs.size(), cache.getMisses());
+
+    std::vector<bool> validity = cache.checkConfigs(configs, 4);
+    for (size_t i = 0; i < configs.size(); ++i)
+        EXPECT_EQ(!collision->checkConfig(configs[i]), validity[i]);
+    EXPECT_EQ(configs.size(), cache.getHits());
+
+    cache.resetCounters();
+    cache.clear();
+    cache.checkConfig(configs[0]);
+    EXPECT_EQ(0, cache.getHits());
+    EXPECT_EQ(1, cache.getMisses());
+
+    // the misses of a trajectory are checked in one batch, only valid batches are cached
+    std::vector<Vector2> freeConfigs, blockedConfigs;
+    for (auto &config : configs)
+        if (!collision->checkConfig(config))
+            freeConfigs.push_back(config);
+    blockedConfigs = freeConfigs;
+    blockedConfigs.push_back(Vector2(12, 15));
+    cache.resetCounters();
+    cache.clear();
+    EXPECT_TRUE(cache.checkTrajectory(blockedConfigs));
+    EXPECT_EQ(blockedConfigs.size(), cache.getMisses());
+    EXPECT_FALSE(cache.checkTrajectory(freeConfigs));
+    EXPECT_EQ(0, cache.getHits());
+    EXPECT_FALSE(cache.checkTrajectory(freeConfigs));
+    EXPECT_EQ(freeConfigs.size(), cache.getHits());
+    EXPECT_TRUE(cache.checkTrajectory(blockedConfigs));
+    EXPECT_EQ(2 * freeConfigs.size(), cache.getHits());
+
+    // bounded cache, evicted configurations are recomputed with the same result
+    CollisionDetectionCache<2> smallCache(collision, environment, 1e-6, 32);
+    for (size_t round = 0; round < 2; ++round)
+        for (auto &config : configs)
+            EXPECT_EQ(collision->checkConfig(config), smallCache.checkConfig(config));
+    EXPECT_LT(smallCache.getHits(), configs.size());
+    EXPECT_EQ(2 * configs.size(), smallCache.getHits() + smallCache.getMisses());
+}
+
+TEST(COLLISIONDETECTION, triangleKernels) {
+    // blocks of random triangles in the SoA layout of CollisionDetection2D
+    std::srand(42);
+    const size_t numBlocks = 16;
+    std::vector<double> blocks;
+    for (size_t block = 0; block < numBlocks; ++block) {
+        std::vector<double> coefficients(util::triangleCoefficients * util::simdBlockSize);
+        for (unsigned int lane = 0; lane < util::simdBlockSize; ++lane) {
+            Vector2 p1 = Vector2::Random() * 10, p2 = Vector2::Random() * 10, p3 = Vector2::Random() * 10;
+            double denominator = (p2[1] - p3[1]) * (p1[0] - p3[0]) + (p3[0] - p2[0]) * (p1[1] - p3[1]);
+            std::vector<double> triangle = {p3[0], p3[1], (p2[1] - p3[1]) / denominator, (p3[0] - p2[0]) / denominator,
+                                            (p3[1] - p1[1]) / denominator, (p1[0] - p3[0]) / denominator};
+            for (unsigned int coefficient = 0; coefficient < util::triangleCoefficients; ++coefficient)
+                coefficients[coefficient * util::simdBlockSize + lane] = triangle[coefficient];
+        }
+        blocks.insert(blocks.end(), coefficients.begin(), coefficients.end());
+    }
+
+    auto kernel = util::getTriangleBlockFunction();
+    for (size_t i = 0; i < 10000; ++i) {
+        Vector2 point = Vector2::Random() * 12;
+        for (size_t num = 1; num <= numBlocks; num *= 4)
+            EXPECT_EQ(util::trianglesContainScalar(blocks.data(), num, point[0], point[1]),
+                      kernel(blocks.data(), num, point[0], point[1]));
+    }
+}
+
+TEST(COLLISIONDETECTION, checkTrajectory2D) {
+    Logging::setLogLevel(LogLevel::off);
+    CollisionDetection2D<2> collision(test::createGridEnvironment());
+
+    // the squares are at [10 + 20i, 20 + 20i]
+    std::vector<Vector2> configs = {Vector2(5, 5), Vector2(25, 25), Vector2(45, 5)};
+    EXPECT_FALSE(collision.checkTrajectory(configs));
+    configs.push_back(Vector2(52, 53));
+    EXPECT_TRUE(collision.checkTrajectory(configs));
+    configs = {Vector2(5, 5), Vector2(105, 5)};
+    EXPECT_TRUE(collision.checkTrajectory(configs));
+
+    std::srand(42);
+    for (size_t i = 0; i < 1000; ++i) {
+        Vector2 config = Vector2::Random().cwiseAbs() * 100;
+        bool inSquare = std::fmod(config[0], 20) > 10 && std::fmod(config[1], 20) > 10 && config[0] < 90 && config[1] < 90;
+        EXPECT_EQ(inSquare, collision.checkConfig(config));
+    }
+}
+
+template <unsigned int dim>
+void testForwardKinematics(SerialRobot &robot) {
+    ForwardKinematics<dim> kinematics(robot);
+    std::array<Transform, dim> linkTrafos;
+    std::array<Transform, dim> jointTrafos;
+    std::srand(42);
+    for (size_t i = 0; i < 100; ++i) {
+        Vector<dim> config = Vector<dim>::Random() * util::pi();
+        auto expectedLinks = robot.getLinkTrafos(config);
+        auto expectedJoints = robot.getJointTrafos(config);
+        kinematics.computeLinkTrafos(config, linkTrafos);
+        kinematics.computeJointTrafos(config, jointTrafos);
+        for (unsigned int j = 0; j < dim; ++j) {
+            EXPECT_TRUE(expectedLinks[j].matrix().isApprox(linkTrafos[j].matrix(), 1e-9));
+            EXPECT_TRUE(expectedJoints[j].matrix().isApprox(jointTrafos[j].matrix(), 1e-9));
+        }
+    }
+}
+
+TEST(COLLISIONDETECTION, forwardKinematics) {
+    Logging::setLogLevel(LogLevel::off);
+    SerialRobot2D serialRobot2D;
+    serialRobot2D.setPose(util::Vecd(10, 20, 30, 0.1, 0.2, 0.3));
+    testForwardKinematics<5>(serialRobot2D);
+
+    Jaco jaco;
+    jaco.setBaseOffset(util::Vecd(0, 0, 50, 0, 0, util::halfPi()));
+    testForwardKinematics<6>(jaco);
+}
+
+TEST(COLLISIONDETECTION, forwardKinematicsCache) {
+    Logging::setLogLevel(LogLevel::off);
+    Jaco jaco;
+    ForwardKinematics<6> kinematics(jaco);
+    ForwardKinematicsCache<6> cache(kinematics);
+
+    // edge with the first joints fixed, followed by a jump
+    std::vector<Vector6> configs;
+    for (double t = 0; t <= 1; t += 0.1)
+        configs.push_back(util::Vecd(1, 2, 3, t, 2 * t, 3 * t));
+    configs.push_back(util::Vecd(0, 0, 0, 0, 0, 0));
+    configs.push_back(configs.back());
+
+    std::vector<std::array<Transform, 6>, Eigen::aligned_allocator<std::array<Transform, 6>>> batchTrafos;
+    kinematics.computeLinkTrafos(configs, batchTrafos);
+    ASSERT_EQ(configs.size(), batchTrafos.size());
+
+    std::array<Transform, 6> linkTrafos;
+    for (size_t i = 0; i < configs.size(); ++i) {
+        kinematics.computeLinkTrafos(configs[i], linkTrafos);
+        auto &cachedTrafos = cache.computeLinkTrafos(configs[i]);
+        for (unsigned int j = 0; j < 6; ++j) {
+            EXPECT_TRUE(linkTrafos[j].matrix().isApprox(batchTrafos[i][j].matrix(), 1e-12));
+            EXPECT_TRUE(linkTrafos[j].matrix().isApprox(cachedTrafos[j].matrix(), 1e-12));
+        }
+    }
+
+    EXPECT_EQ(6u, ForwardKinematics<6>::getFirstChangedLink(configs[0], configs[0]));
+    EXPECT_EQ(4u, ForwardKinematics<6>::getFirstChangedLink(configs[0], configs[1]));
+    EXPECT_EQ(1u, ForwardKinematics<6>::getFirstChangedLink(configs[1], configs.back()));
+}
+
+TEST(COLLISIONDETECTION, forwardKinematicsBatch) {
+    Logging::setLogLevel(LogLevel::off);
+    Jaco jaco;
+    jaco.setPose(util::Vecd(10, 20, 30, 0.1, 0.2, 0.3));
+    ForwardKinematics<6> kinematics(jaco);
+
+    // random configurations, which share no joint, and an edge with the first three joints fixed
+    std::srand(42);
+    std::vector<Vector6> randomConfigs;
+    for (size_t i = 0; i < 21; ++i)
+        randomConfigs.push_back(Vector6::Random() * util::pi());
+    std::vector<Vector6> edgeConfigs;
+    for (double t = 0; t <= 1; t += 0.05)
+        edgeConfigs.push_back(util::Vecd(1, 2, 3, t, 2 * t, 3 * t));
+
+    std::vector<std::array<Transform, 6>, Eigen::aligned_allocator<std::array<Transform, 6>>> batchTrafos;
+    std::array<Transform, 6> linkTrafos;
+    for (auto &configs : {randomConfigs, edgeConfigs}) {
+        kinematics.computeLinkTrafos(configs, batchTrafos);
+        ASSERT_EQ(configs.size(), batchTrafos.size());
+        for (size_t i = 0; i < configs.size(); ++i) {
+            kinematics.computeLinkTrafos(configs[i], linkTrafos);
+            for (unsigned int j = 0; j < 6; ++j)
+                EXPECT_TRUE(linkTrafos[j].matrix().isApprox(batchTrafos[i][j].matrix(), 1e-12));
+        }
+    }
+
+    // dispatched kernel against the scalar kernel
+    const unsigned int numJoints = 5;
+    std::vector<double> joints(numJoints * util::jointCoefficients);
+    std::vector<double> sinQ(numJoints * util::simdBlockSize), cosQ(numJoints * util::simdBlockSize);
+    std::vector<double> links((numJoints + 1) * util::linkCoefficients * util::simdBlockSize);
+    for (auto &value : joints)
+        value = std::rand() / static_cast<double>(RAND_MAX);
+    for (size_t i = 0; i < sinQ.size(); ++i) {
+        double q = 2 * util::pi() * std::rand() / RAND_MAX;
+        sinQ[i] = std::sin(q);
+        cosQ[i] = std::cos(q);
+    }
+    for (size_t i = 0; i < util::linkCoefficients * util::simdBlockSize; ++i)
+        links[i] = std::rand() / static_cast<double>(RAND_MAX);
+    std::vector<double> scalarLinks(links);
+    util::linkBlocksScalar(joints.data(), numJoints, sinQ.data(), cosQ.data(), scalarLinks.data());
+    util::getLinkBlockFunction()(joints.data(), numJoints, sinQ.data(), cosQ.data(), links.data());
+    for (size_t i = 0; i < links.size(); ++i)
+        EXPECT_NEAR(scalarLinks[i], links[i], 1e-12);
+}
+
+TEST(COLLISIONDETECTION, boundingSpheres) {
+    // long box along the x axis out of 12 triangles
+    PointModel model;
+    model.m_mesh.vertices = {Vector3(0, 0, 0),  Vector3(10, 0, 0), Vector3(10, 1, 0), Vector3(0, 1, 0),
+                             Vector3(0, 0, 1),  Vector3(10, 0, 1), Vector3(10, 1, 1), Vector3(0, 1, 1)};
+    model.m_mesh.faces = {Vector3i(0, 1, 2), Vector3i(0, 2, 3), Vector3i(4, 5, 6), Vector3i(4, 6, 7),
+                          Vector3i(0, 1, 5), Vector3i(0, 5, 4), Vector3i(3, 2, 6), Vector3i(3, 6, 7),
+                          Vector3i(0, 3, 7), Vector3i(0, 7, 4), Vector3i(1, 2, 6), Vector3i(1, 6, 5)};
+    // the spheres are stored at the model and only computed by the update
+    EXPECT_GT(0, model.getBoundingSpheres().radius);
+    model.updateBoundingSpheres();
+    BoundingSpheres spheres = model.getBoundingSpheres();
+    ASSERT_GT(spheres.numLeaves, 1u);
+
+    // every point of a triangle lies inside of the root and of one leaf sphere
+    std::srand(42);
+    for (auto &face : model.m_mesh.faces) {
+        for (size_t i = 0; i < 100; ++i) {
+            Vector3 weights = Vector3::Random().cwiseAbs();
+            weights /= weights.sum();
+            Vector3 point = weights[0] * model.m_mesh.vertices[face[0]] + weights[1] * model.m_mesh.vertices[face[1]] +
+                            weights[2] * model.m_mesh.vertices[face[2]];
+            EXPECT_LE((point - spheres.center).norm(), spheres.radius);
+            bool inside = false;
+            for (size_t leaf = 0; leaf < spheres.numLeaves; ++leaf)
+                inside |= (point - spheres.centers[leaf]).norm() <= spheres.radii[leaf];
+            EXPECT_TRUE(inside);
+        }
+    }
+
+    // the leaves separate a crossing box, which overlaps the root sphere only
+    ippp::Transform T = util::poseVecToTransform(util::Vecd(1, 3.5, 0, 0, 0, util::halfPi()));
+    EXPECT_TRUE(util::spheresOverlap(spheres, util::transformSpheres(spheres, Transform::Identity())));
+    EXPECT_FALSE(util::spheresOverlap(spheres, util::transformSpheres(spheres, T)));
+    EXPECT_FALSE(util::spheresOverlap(spheres, util::transformSpheres(spheres, util::poseVecToTransform(util::Vecd(0, 20, 0, 0, 0, 0)))));
+    EXPECT_TRUE(util::spheresOverlap(spheres, AABB(Vector3(9, 0, 0), Vector3(12, 1, 1))));
+    EXPECT_FALSE(util::spheresOverlap(spheres, AABB(Vector3(0, 3, 0), Vector3(1, 4, 1))));
+    EXPECT_TRUE(util::spheresOverlap(BoundingSpheres(), spheres));
+}
+
+TEST(COLLISIONDETECTION, selfCollisionMatrix) {
+    Logging::setLogLevel(LogLevel::off);
+    // three models, pair (0,1) collided at all samples, pair (0,2) at some, pair (1,2) never
+    std::vector<size_t> counts = {0, 10, 4, 0, 0, 0, 0, 0, 0};
+    SelfCollisionMatrix matrix(3, counts, 10);
+    EXPECT_EQ(matrix.size(), 3u);
+    EXPECT_EQ(matrix.getPair(0, 1), PairCollision::always);
+    EXPECT_EQ(matrix.getPair(1, 0), PairCollision::always);
+    EXPECT_EQ(matrix.getPair(2, 0), PairCollision::sometimes);
+    EXPECT_EQ(matrix.getPair(1, 2), PairCollision::never);
+    EXPECT_FALSE(matrix.isPairChecked(2, 1));
+    EXPECT_TRUE(matrix.isPairChecked(0, 1));
+    EXPECT_TRUE(matrix.isPairChecked(0, 5));
+    EXPECT_TRUE(SelfCollisionMatrix().isPairChecked(1, 2));
+
+    SelfCollisionMatrix loaded = SelfCollisionMatrix::fromString(matrix.toString());
+    EXPECT_EQ(loaded.toString(), matrix.toString());
+    EXPECT_EQ(loaded.getPair(1, 2), PairCollision::never);
+    EXPECT_TRUE(SelfCollisionMatrix::fromString("nss sn").empty());
+    EXPECT_TRUE(SelfCollisionMatrix::fromString("nx xn").empty());
+    EXPECT_TRUE(SelfCollisionMatrix::fromString("nn sn").empty());
+    EXPECT_FALSE(SelfCollisionMatrix::fromString("ss ss").empty());
+
+    // the robot only accepts matrices of its base and joint models
+    SerialRobot2D serialRobot2D;
+    serialRobot2D.setSelfCollisionMatrix(matrix);
+    EXPECT_TRUE(serialRobot2D.getSelfCollisionMatrix().empty());
+    SelfCollisionMatrix robotMatrix(6);
+    robotMatrix.setPair(1, 4, PairCollision::never);
+    serialRobot2D.setSelfCollisionMatrix(robotMatrix);
+    EXPECT_EQ(serialRobot2D.getSelfCollisionMatrix().toString(), robotMatrix.toString());
+}
+
+std::shared_ptr<ModelContainer> createPqpRectangle(const Vector2 &min, const Vector2 &max) {
+    auto model = std::make_shared<ModelPqp>();
+    model->m_mesh.vertices = {Vector3(min[0], min[1], 0), Vector3(max[0], min[1], 0), Vector3(max[0], max[1], 0),
+                              Vector3(min[0], max[1], 0)};
+    model->m_mesh.faces = {Vector3i(0, 1, 2), Vector3i(0, 2, 3)};
+    model->m_mesh.aabb = cad::computeAABB(model->m_mesh);
+    model->updateBoundingSpheres();
+
+    model->m_pqpModel.BeginModel();
+    for (size_t i = 0; i < model->m_mesh.faces.size(); ++i) {
+        PQP_REAL p[3][3];
+        for (size_t j = 0; j < 3; ++j)
+            for (size_t k = 0; k < 3; ++k)
+                p[j][k] = model->m_mesh.vertices[model->m_mesh.faces[i][j]][k];
+        model->m_pqpModel.AddTri(p[0], p[1], p[2], static_cast<int>(i));
+    }
+    model->m_pqpModel.EndModel();
+    return model;
+}
+
+TEST(COLLISIONDETECTION, selfCollisionMatrixSampling) {
+    Logging::setLogLevel(LogLevel::off);
+    const unsigned int dim = 5;
+    // the links are bars from the previous joint over the own joint, neighboring models overlap at their joint
+    std::shared_ptr<SerialRobot2D> robot(new SerialRobot2D());
+    robot->setBaseModel(createPqpRectangle(Vector2(-5, -5), Vector2(5, 5)));
+    std::vector<Joint> joints;
+    for (unsigned int i = 0; i < dim; ++i)
+        joints.push_back(Joint(-util::pi(), util::pi(), createPqpRectangle(Vector2(-105, -1), Vector2(5, 1))));
+    robot->setJoints(joints);
+    std::shared_ptr<Environment> environment(new Environment(2, AABB(Vector3(-1000, -1000, -1000), Vector3(1000, 1000, 1000)), robot));
+    CollisionDetectionPqp<dim> collision(environment);
+
+    // the sample count overload draws uniform samples inside of the robot boundaries
+    SamplerUniform<dim> sampler(environment, "selfCollision");
+    std::vector<Vector<dim>> configs;
+    for (size_t i = 0; i < 100; ++i)
+        configs.push_back(sampler.getSample());
+    SelfCollisionMatrix matrix = collision.computeSelfCollisionMatrix(100, "selfCollision");
+    EXPECT_EQ(collision.computeSelfCollisionMatrix(configs).toString(), matrix.toString());
+    ASSERT_FALSE(matrix.empty());
+    ASSERT_EQ(dim + 1, matrix.size());
+    for (size_t first = 0; first <= dim; ++first) {
+        for (size_t second = 0; second <= dim; ++second)
+            EXPECT_EQ(matrix.getPair(first, second), matrix.getPair(second, first));
+        if (first < dim) {
+            EXPECT_EQ(PairCollision::always, matrix.getPair(first, first + 1));
+            EXPECT_TRUE(matrix.isPairChecked(first, first + 1));
+        }
+    }
+
+    // the configurator passes the matrix to every created serial robot
+    SelfCollisionMatrix jacoMatrix(7);
+    jacoMatrix.setPair(1, 4, PairCollision::never);
+    EnvironmentConfigurator configurator;
+    configurator.setWorkspaceProperties(3, AABB(Vector3(-1000, -1000, -1000), Vector3(1000, 1000, 1000)));
+    configurator.setSelfCollisionMatrix(jacoMatrix);
+    for (auto robotType : {RobotType::Jaco, RobotType::Kuka}) {
+        configurator.setRobotType(robotType);
+        auto serialRobot = std::static_pointer_cast<SerialRobot>(configurator.getEnvironment()->getRobot());
+        EXPECT_EQ(jacoMatrix.toString(), serialRobot->getSelfCollisionMatrix().toString());
+    }
+}
+
+TEST(COLLISIONDETECTION, obstacleDistancePruning) {
+    // model at the origin, obstacles at distance 5, 2 and 10 in x direction
+    AABB model(Vector3(-1, -1, -1), Vector3(1, 1, 1));
+    std::vector<AABB> obstacles = {AABB(Vector3(6, -1, -1), Vector3(7, 1, 1)), AABB(Vector3(3, -1, -1), Vector3(4, 1, 1)),
+                                   AABB(Vector3(11, -1, -1), Vector3(12, 1, 1))};
+    std::vector<size_t> calls;
+    auto distance = [&](const size_t i) {
+        calls.push_back(i);
+        return std::sqrt(model.squaredExteriorDistance(obstacles[i])) + 0.5;
+    };
+
+    // the third obstacle is farther away than the second distance and is skipped
+    double minDist = std::numeric_limits<double>::max();
+    EXPECT_FALSE(util::updateObstacleDistance(model, obstacles, distance, minDist));
+    EXPECT_NEAR(2.5, minDist, 1e-12);
+    EXPECT_EQ(std::vector<size_t>({0, 1}), calls);
+
+    // with a smaller known distance, no obstacle has to be computed
+    calls.clear();
+    minDist = 1;
+    EXPECT_FALSE(util::updateObstacleDistance(model, obstacles, distance, minDist));
+    EXPECT_TRUE(calls.empty());
+
+    // the search stops at the first collision
+    calls.clear();
+    minDist = std::numeric_limits<double>::max();
+    EXPECT_TRUE(util::updateObstacleDistance(model, obstacles, [&](const size_t i) {
+        calls.push_back(i);
+        return i == 0 ? 0.0 : 1.0;
+    }, minDist));
+    EXPECT_EQ(0, minDist);
+    EXPECT_EQ(std::vector<size_t>({0}), calls);
+}
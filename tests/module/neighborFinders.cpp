@@ -16,6 +16,10 @@
 //
 //-------------------------------------------------------------------------//
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
 #include <gtest/gtest.h>
 
 #include <ippp/modules/distanceMetrics/InfMetric.hpp>
@@ -25,7 +29,11 @@
 #include <ippp/modules/distanceMetrics/WeightedL1Metric.hpp>
 #include <ippp/modules/distanceMetrics/WeightedL2Metric.hpp>
 #include <ippp/modules/neighborFinders/BruteForceNF.hpp>
+#include <ippp/modules/neighborFinders/ConcurrentKDTree.hpp>
 #include <ippp/modules/neighborFinders/KDTree.hpp>
+#include <ippp/modules/neighborFinders/SimdBruteForceNF.hpp>
+#include <ippp/modules/neighborFinders/StaticKDTree.hpp>
+#include <ippp/util/UtilList.hpp>
 
 using namespace ippp;
 
@@ -42,6 +50,9 @@ void testConstructor() {
     for (auto &metric : metrics) {
         auto finder1 = std::make_shared<KDTree<dim, std::shared_ptr<Node<dim>>>>(metric);
         auto finder2 = std::make_shared<BruteForceNF<dim, std::shared_ptr<Node<dim>>>>(metric);
+        auto finder3 = std::make_shared<StaticKDTree<dim, std::shared_ptr<Node<dim>>>>(metric);
+        auto finder4 = std::make_shared<ConcurrentKDTree<dim, std::shared_ptr<Node<dim>>>>(metric);
+        auto finder5 = std::make_shared<SimdBruteForceNF<dim, std::shared_ptr<Node<dim>>>>(metric);
     }
 }
 
@@ -55,3 +66,475 @@ TEST(NEIGHBORFINDERS, constructor) {
     testConstructor<8>();
     testConstructor<9>();
 }
+
+template <unsigned int dim>
+void testStaticKDTree() {
+    std::vector<std::shared_ptr<DistanceMetric<dim>>> metrics;
+    metrics.push_back(std::make_shared<L1Metric<dim>>());
+    metrics.push_back(std::make_shared<L2Metric<dim>>());
+    metrics.push_back(std::make_shared<InfMetric<dim>>());
+    metrics.push_back(std::make_shared<WeightedL1Metric<dim>>(Vector<dim>::LinSpaced(1, 2)));
+    metrics.push_back(std::make_shared<WeightedL2Metric<dim>>(Vector<dim>::LinSpaced(1, 2)));
+    metrics.push_back(std::make_shared<WeightedInfMetric<dim>>(Vector<dim>::LinSpaced(1, 2)));
+
+    std::srand(42);
+    std::vector<std::shared_ptr<Node<dim>>> nodes;
+    for (size_t i = 0; i < 1000; ++i)
+        nodes.push_back(std::make_shared<Node<dim>>(Vector<dim>::Random() * 100));
+
+    for (auto &metric : metrics) {
+        BruteForceNF<dim, std::shared_ptr<Node<dim>>> bruteForce(metric);
+        StaticKDTree<dim, std::shared_ptr<Node<dim>>> tree(metric);
+        for (size_t i = 0; i < 900; ++i) {
+            bruteForce.addNode(nodes[i]->getValues(), nodes[i]);
+            tree.addNode(nodes[i]->getValues(), nodes[i]);
+        }
+        std::vector<std::shared_ptr<Node<dim>>> sortedNodes(nodes.begin(), nodes.begin() + 900);
+        tree.rebaseSorted(sortedNodes);
+        // the last nodes are inside of the unsorted list of the static tree
+        for (size_t i = 900; i < nodes.size(); ++i) {
+            bruteForce.addNode(nodes[i]->getValues(), nodes[i]);
+            tree.addNode(nodes[i]->getValues(), nodes[i]);
+        }
+        EXPECT_EQ(tree.size(), nodes.size());
+
+        for (size_t i = 0; i < 50; ++i) {
+            Vector<dim> config = Vector<dim>::Random() * 100;
+            EXPECT_EQ(bruteForce.searchNearestNeighbor(config), tree.searchNearestNeighbor(config));
+            EXPECT_EQ(bruteForce.searchNearestNeighbor(nodes[i]->getValues()),
+                      tree.searchNearestNeighbor(nodes[i]->getValues()));
+
+            auto expected = bruteForce.searchRange(config, 40);
+            auto result = tree.searchRange(config, 40);
+            EXPECT_EQ(expected.size(), result.size());
+            for (auto &node : expected)
+                EXPECT_TRUE(util::contains(result, node));
+        }
+    }
+}
+
+TEST(NEIGHBORFINDERS, staticKDTree) {
+    testStaticKDTree<2>();
+    testStaticKDTree<3>();
+    testStaticKDTree<6>();
+    testStaticKDTree<7>();
+}
+
+template <unsigned int dim>
+void testKNearest() {
+    std::vector<std::shared_ptr<DistanceMetric<dim>>> metrics;
+    metrics.push_back(std::make_shared<L2Metric<dim>>());
+    metrics.push_back(std::make_shared<WeightedL2Metric<dim>>(Vector<dim>::LinSpaced(1, 2)));
+
+    std::srand(42);
+    std::vector<std::shared_ptr<Node<dim>>> nodes;
+    for (size_t i = 0; i < 1000; ++i)
+        nodes.push_back(std::make_shared<Node<dim>>(Vector<dim>::Random() * 100));
+
+    for (auto &metric : metrics) {
+        std::vector<std::shared_ptr<NeighborFinder<dim, std::shared_ptr<Node<dim>>>>> finders;
+        finders.push_back(std::make_shared<KDTree<dim, std::shared_ptr<Node<dim>>>>(metric));
+        finders.push_back(std::make_shared<StaticKDTree<dim, std::shared_ptr<Node<dim>>>>(metric));
+        finders.push_back(std::make_shared<ConcurrentKDTree<dim, std::shared_ptr<Node<dim>>>>(metric));
+        BruteForceNF<dim, std::shared_ptr<Node<dim>>> bruteForce(metric);
+        for (auto &node : nodes) {
+            bruteForce.addNode(node->getValues(), node);
+            for (auto &finder : finders)
+                finder->addNode(node->getValues(), node);
+        }
+        finders[1]->rebaseSorted(nodes);
+
+        for (auto &finder : finders) {
+            EXPECT_TRUE(finder->searchKNearest(nodes[0]->getValues(), 0).empty());
+            EXPECT_EQ(finder->searchKNearest(nodes[0]->getValues(), 2000).size(), nodes.size() - 1);
+
+            for (size_t i = 0; i < 20; ++i) {
+                Vector<dim> config = Vector<dim>::Random() * 100;
+                auto expected = bruteForce.searchKNearest(config, 10);
+                auto result = finder->searchKNearest(config, 10);
+                ASSERT_EQ(expected.size(), 10);
+                EXPECT_EQ(expected, result);
+                EXPECT_EQ(bruteForce.searchNearestNeighbor(config), result.front());
+
+                // the query node is not part of the result
+                result = finder->searchKNearest(nodes[i]->getValues(), 5);
+                EXPECT_FALSE(util::contains(result, nodes[i]));
+                EXPECT_EQ(bruteForce.searchKNearest(nodes[i]->getValues(), 5), result);
+            }
+
+            // approximate search, the found neighbors are at most (1 + epsilon) times farther away
+            const double epsilon = 0.5;
+            finder->setApproximation(epsilon);
+            EXPECT_EQ(finder->getApproximation(), epsilon);
+            for (size_t i = 0; i < 20; ++i) {
+                Vector<dim> config = Vector<dim>::Random() * 100;
+                auto expected = bruteForce.searchKNearest(config, 10);
+                auto result = finder->searchKNearest(config, 10);
+                ASSERT_EQ(expected.size(), result.size());
+                for (size_t j = 0; j < result.size(); ++j)
+                    EXPECT_LE(metric->calcDist(config, result[j]->getValues()),
+                              (1 + epsilon) * metric->calcDist(config, expected[j]->getValues()) + EPSILON);
+
+                auto nearest = finder->searchNearestNeighbor(config);
+                EXPECT_LE(metric->calcDist(config, nearest->getValues()),
+                          (1 + epsilon) * metric->calcDist(config, expected.front()->getValues()) + EPSILON);
+            }
+            finder->setApproximation(-1);
+            EXPECT_EQ(finder->getApproximation(), 0);
+        }
+    }
+}
+
+TEST(NEIGHBORFINDERS, kNearest) {
+    testKNearest<2>();
+    testKNearest<3>();
+    testKNearest<6>();
+    testKNearest<7>();
+}
+
+template <unsigned int dim>
+void testConcurrentKDTree() {
+    const size_t numThreads = 8;
+    const size_t nodesPerThread = 2000;
+    auto metric = std::make_shared<L2Metric<dim>>();
+
+    std::srand(42);
+    std::vector<std::shared_ptr<Node<dim>>> nodes;
+    std::vector<Vector<dim>> queries;
+    for (size_t i = 0; i < numThreads * nodesPerThread; ++i) {
+        nodes.push_back(std::make_shared<Node<dim>>(Vector<dim>::Random() * 100));
+        queries.push_back(Vector<dim>::Random() * 100);
+    }
+
+    // all threads insert and search at the same time
+    ConcurrentKDTree<dim, std::shared_ptr<Node<dim>>> tree(metric);
+    std::vector<size_t> failedSearches(numThreads, 0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < numThreads; ++t) {
+        threads.push_back(std::thread([&, t]() {
+            for (size_t i = t * nodesPerThread; i < (t + 1) * nodesPerThread; ++i) {
+                tree.addNode(nodes[i]->getValues(), nodes[i]);
+                if (tree.searchNearestNeighbor(queries[i]) == nullptr || tree.searchKNearest(queries[i], 3).empty())
+                    ++failedSearches[t];
+                tree.searchRange(queries[i], 10);
+            }
+        }));
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    for (auto &failed : failedSearches)
+        EXPECT_EQ(failed, 0);
+    EXPECT_EQ(tree.size(), nodes.size());
+
+    BruteForceNF<dim, std::shared_ptr<Node<dim>>> bruteForce(metric, nodes);
+    for (size_t i = 0; i < 50; ++i) {
+        EXPECT_EQ(bruteForce.searchNearestNeighbor(queries[i]), tree.searchNearestNeighbor(queries[i]));
+        EXPECT_EQ(bruteForce.searchKNearest(queries[i], 10), tree.searchKNearest(queries[i], 10));
+
+        auto expected = bruteForce.searchRange(queries[i], 30);
+        auto result = tree.searchRange(queries[i], 30);
+        EXPECT_EQ(expected.size(), result.size());
+        for (auto &node : expected)
+            EXPECT_TRUE(util::contains(result, node));
+    }
+}
+
+TEST(NEIGHBORFINDERS, concurrentKDTree) {
+    testConcurrentKDTree<2>();
+    testConcurrentKDTree<3>();
+    testConcurrentKDTree<6>();
+}
+
+template <unsigned int dim>
+void testKDTreeRebalance() {
+    auto metric = std::make_shared<L2Metric<dim>>();
+
+    // sorted insertion, without rebalancing the tree would be a list
+    std::srand(42);
+    std::vector<std::shared_ptr<Node<dim>>> nodes;
+    for (size_t i = 0; i < 6000; ++i)
+        nodes.push_back(std::make_shared<Node<dim>>(Vector<dim>::Constant(i * 0.1) + Vector<dim>::Random()));
+
+    KDTree<dim, std::shared_ptr<Node<dim>>> tree(metric);
+    for (auto &node : nodes)
+        tree.addNode(node->getValues(), node);
+    EXPECT_EQ(tree.size(), nodes.size());
+
+    BruteForceNF<dim, std::shared_ptr<Node<dim>>> bruteForce(metric, nodes);
+    for (size_t i = 0; i < 50; ++i) {
+        Vector<dim> config = Vector<dim>::Random() * 300 + Vector<dim>::Constant(300);
+        EXPECT_EQ(bruteForce.searchNearestNeighbor(config), tree.searchNearestNeighbor(config));
+        EXPECT_EQ(bruteForce.searchKNearest(config, 10), tree.searchKNearest(config, 10));
+    }
+
+    // other threads search, while the sorted insertion rebuilds subtrees
+    KDTree<dim, std::shared_ptr<Node<dim>>> sharedTree(metric);
+    sharedTree.addNode(nodes[0]->getValues(), nodes[0]);
+    std::atomic<bool> inserting(true);
+    std::vector<size_t> failedSearches(2, 0);
+    std::vector<std::thread> searchThreads;
+    for (size_t t = 0; t < failedSearches.size(); ++t) {
+        searchThreads.push_back(std::thread([&, t]() {
+            for (size_t i = t; inserting; i += failedSearches.size()) {
+                const Vector<dim> config = nodes[i % nodes.size()]->getValues() + Vector<dim>::Constant(0.5);
+                if (sharedTree.searchNearestNeighbor(config) == nullptr || sharedTree.searchKNearest(config, 3).empty())
+                    ++failedSearches[t];
+                sharedTree.searchRange(config, 1);
+            }
+        }));
+    }
+    for (size_t i = 1; i < nodes.size(); ++i)
+        sharedTree.addNode(nodes[i]->getValues(), nodes[i]);
+    inserting = false;
+    for (auto &thread : searchThreads)
+        thread.join();
+    for (auto &failed : failedSearches)
+        EXPECT_EQ(failed, 0);
+    for (size_t i = 0; i < 50; ++i) {
+        Vector<dim> config = Vector<dim>::Random() * 300 + Vector<dim>::Constant(300);
+        EXPECT_EQ(bruteForce.searchNearestNeighbor(config), sharedTree.searchNearestNeighbor(config));
+    }
+
+    // rebuild in the background, while new nodes are added
+    KDTree<dim, std::shared_ptr<Node<dim>>> backgroundTree(metric);
+    backgroundTree.setBackgroundRebuild(true);
+    for (size_t i = 0; i < 2000; ++i)
+        backgroundTree.addNode(nodes[i]->getValues(), nodes[i]);
+    std::vector<std::shared_ptr<Node<dim>>> rebaseNodes(nodes.begin(), nodes.begin() + 4000);
+    backgroundTree.rebaseSorted(rebaseNodes);
+    for (size_t i = 4000; i < nodes.size(); ++i) {
+        backgroundTree.addNode(nodes[i]->getValues(), nodes[i]);
+        EXPECT_NE(backgroundTree.searchNearestNeighbor(nodes[i]->getValues()), nullptr);
+    }
+    backgroundTree.waitForRebuild();
+    EXPECT_FALSE(backgroundTree.isRebuilding());
+    EXPECT_EQ(backgroundTree.size(), nodes.size());
+    for (size_t i = 0; i < 50; ++i) {
+        Vector<dim> config = Vector<dim>::Random() * 300 + Vector<dim>::Constant(300);
+        EXPECT_EQ(bruteForce.searchNearestNeighbor(config), backgroundTree.searchNearestNeighbor(config));
+        EXPECT_EQ(bruteForce.searchKNearest(config, 10), backgroundTree.searchKNearest(config, 10));
+    }
+
+    // large scapegoats of the sorted insertion are rebuild in the background, while other threads search
+    KDTree<dim, std::shared_ptr<Node<dim>>> sortedTree(metric);
+    sortedTree.setBackgroundRebuild(true);
+    inserting = true;
+    failedSearches.assign(2, 0);
+    searchThreads.clear();
+    sortedTree.addNode(nodes[0]->getValues(), nodes[0]);
+    for (size_t t = 0; t < failedSearches.size(); ++t) {
+        searchThreads.push_back(std::thread([&, t]() {
+            for (size_t i = t; inserting; i += failedSearches.size()) {
+                const Vector<dim> config = nodes[i % nodes.size()]->getValues() + Vector<dim>::Constant(0.5);
+                if (sortedTree.searchNearestNeighbor(config) == nullptr)
+                    ++failedSearches[t];
+            }
+        }));
+    }
+    for (size_t i = 1; i < nodes.size(); ++i)
+        sortedTree.addNode(nodes[i]->getValues(), nodes[i]);
+    inserting = false;
+    for (auto &thread : searchThreads)
+        thread.join();
+    for (auto &failed : failedSearches)
+        EXPECT_EQ(failed, 0);
+    sortedTree.waitForRebuild();
+    EXPECT_EQ(sortedTree.size(), nodes.size());
+    for (size_t i = 0; i < 50; ++i) {
+        Vector<dim> config = Vector<dim>::Random() * 300 + Vector<dim>::Constant(300);
+        EXPECT_EQ(bruteForce.searchNearestNeighbor(config), sortedTree.searchNearestNeighbor(config));
+        EXPECT_EQ(bruteForce.searchKNearest(config, 10), sortedTree.searchKNearest(config, 10));
+    }
+
+    // a rebase during a running rebuild replaces its result
+    KDTree<dim, std::shared_ptr<Node<dim>>> resetTree(metric);
+    resetTree.setBackgroundRebuild(true);
+    for (auto &node : nodes)
+        resetTree.addNode(node->getValues(), node);
+    std::vector<std::shared_ptr<Node<dim>>> resetNodes(nodes.begin(), nodes.begin() + 100);
+    resetTree.rebaseSorted(resetNodes);
+    resetTree.waitForRebuild();
+    EXPECT_EQ(resetTree.size(), resetNodes.size());
+    BruteForceNF<dim, std::shared_ptr<Node<dim>>> resetBruteForce(metric, resetNodes);
+    for (size_t i = 0; i < 50; ++i) {
+        Vector<dim> config = Vector<dim>::Random() * 300 + Vector<dim>::Constant(300);
+        EXPECT_EQ(resetBruteForce.searchNearestNeighbor(config), resetTree.searchNearestNeighbor(config));
+    }
+}
+
+TEST(NEIGHBORFINDERS, kdTreeRebalance) {
+    testKDTreeRebalance<2>();
+    testKDTreeRebalance<3>();
+    testKDTreeRebalance<6>();
+}
+
+template <unsigned int dim>
+void testBatchSearch() {
+    auto metric = std::make_shared<L2Metric<dim>>();
+
+    std::srand(42);
+    std::vector<std::shared_ptr<Node<dim>>> nodes;
+    for (size_t i = 0; i < 2000; ++i)
+        nodes.push_back(std::make_shared<Node<dim>>(Vector<dim>::Random() * 100));
+    std::vector<Vector<dim>> queries;
+    for (size_t i = 0; i < 200; ++i)
+        queries.push_back(Vector<dim>::Random() * 100);
+    // positions of nodes and duplicates inside of the batch
+    for (size_t i = 0; i < 20; ++i) {
+        queries.push_back(nodes[i]->getValues());
+        queries.push_back(nodes[i]->getValues());
+    }
+
+    std::vector<std::shared_ptr<NeighborFinder<dim, std::shared_ptr<Node<dim>>>>> finders;
+    finders.push_back(std::make_shared<KDTree<dim, std::shared_ptr<Node<dim>>>>(metric));
+    finders.push_back(std::make_shared<StaticKDTree<dim, std::shared_ptr<Node<dim>>>>(metric));
+    finders.push_back(std::make_shared<ConcurrentKDTree<dim, std::shared_ptr<Node<dim>>>>(metric));
+    finders.push_back(std::make_shared<BruteForceNF<dim, std::shared_ptr<Node<dim>>>>(metric));
+    finders.push_back(std::make_shared<SimdBruteForceNF<dim, std::shared_ptr<Node<dim>>>>(metric));
+    for (auto &finder : finders) {
+        EXPECT_TRUE(finder->searchNearestNeighbors(std::vector<Vector<dim>>()).empty());
+        for (auto &node : nodes)
+            finder->addNode(node->getValues(), node);
+
+        auto result = finder->searchNearestNeighbors(queries);
+        ASSERT_EQ(result.size(), queries.size());
+        for (size_t i = 0; i < queries.size(); ++i)
+            EXPECT_EQ(finder->searchNearestNeighbor(queries[i]), result[i]);
+    }
+}
+
+TEST(NEIGHBORFINDERS, batchSearch) {
+    testBatchSearch<2>();
+    testBatchSearch<3>();
+    testBatchSearch<6>();
+}
+
+template <unsigned int dim>
+void testSimdBruteForce() {
+    std::vector<std::shared_ptr<DistanceMetric<dim>>> metrics;
+    metrics.push_back(std::make_shared<L1Metric<dim>>());
+    metrics.push_back(std::make_shared<L2Metric<dim>>());
+    metrics.push_back(std::make_shared<InfMetric<dim>>());
+    metrics.push_back(std::make_shared<WeightedL1Metric<dim>>(Vector<dim>::LinSpaced(0.5, 2)));
+    metrics.push_back(std::make_shared<WeightedL2Metric<dim>>(Vector<dim>::LinSpaced(0.5, 2)));
+    metrics.push_back(std::make_shared<WeightedInfMetric<dim>>(Vector<dim>::LinSpaced(0.5, 2)));
+
+    // size is no multiple of the block size
+    std::srand(42);
+    std::vector<std::shared_ptr<Node<dim>>> nodes;
+    for (size_t i = 0; i < 1003; ++i)
+        nodes.push_back(std::make_shared<Node<dim>>(Vector<dim>::Random() * 100));
+
+    for (auto &metric : metrics) {
+        BruteForceNF<dim, std::shared_ptr<Node<dim>>> bruteForce(metric, nodes);
+        SimdBruteForceNF<dim, std::shared_ptr<Node<dim>>> simd(metric);
+        for (auto &node : nodes)
+            simd.addNode(node->getValues(), node);
+        EXPECT_EQ(simd.size(), nodes.size());
+
+        for (size_t i = 0; i < 50; ++i) {
+            Vector<dim> config = Vector<dim>::Random() * 100;
+            EXPECT_EQ(bruteForce.searchNearestNeighbor(config), simd.searchNearestNeighbor(config));
+            EXPECT_EQ(bruteForce.searchNearestNeighbor(nodes[i]->getValues()), simd.searchNearestNeighbor(nodes[i]->getValues()));
+            EXPECT_EQ(bruteForce.searchKNearest(config, 10), simd.searchKNearest(config, 10));
+
+            auto expected = bruteForce.searchRange(config, 50);
+            auto result = simd.searchRange(config, 50);
+            EXPECT_EQ(expected.size(), result.size());
+            for (auto &node : expected)
+                EXPECT_TRUE(util::contains(result, node));
+        }
+
+        // only nodes at exactly the query position are skipped
+        KDTree<dim, std::shared_ptr<Node<dim>>> kdTree(metric, nodes);
+        Vector<dim> nearConfig = nodes[0]->getValues();
+        nearConfig[0] += 1e-9;
+        EXPECT_EQ(bruteForce.searchNearestNeighbor(nearConfig), nodes[0]);
+        EXPECT_EQ(simd.searchNearestNeighbor(nearConfig), nodes[0]);
+        EXPECT_EQ(kdTree.searchNearestNeighbor(nearConfig), nodes[0]);
+        EXPECT_NE(bruteForce.searchNearestNeighbor(nodes[0]->getValues()), nodes[0]);
+        EXPECT_NE(simd.searchNearestNeighbor(nodes[0]->getValues()), nodes[0]);
+        EXPECT_NE(kdTree.searchNearestNeighbor(nodes[0]->getValues()), nodes[0]);
+    }
+}
+
+TEST(NEIGHBORFINDERS, simdBruteForce) {
+    testSimdBruteForce<2>();
+    testSimdBruteForce<3>();
+    testSimdBruteForce<6>();
+    testSimdBruteForce<7>();
+    testSimdBruteForce<9>();
+}
+
+template <util::SimdMetric metric>
+void testBlockDistanceKernel() {
+    const unsigned int dim = 7;
+    const size_t numBlocks = 3;
+    std::vector<double> blocks(numBlocks * dim * util::simdBlockSize);
+    for (auto &value : blocks)
+        value = std::rand() % 2000 / 10.0 - 100;
+    Vector<dim> query = Vector<dim>::Random() * 100;
+    Vector<dim> weights = Vector<dim>::LinSpaced(0.5, 2);
+
+    double expected[numBlocks * util::simdBlockSize];
+    double result[numBlocks * util::simdBlockSize];
+    util::getScalarBlockDistanceFunction<metric>()(blocks.data(), numBlocks, query.data(), weights.data(), dim, expected);
+    util::getBlockDistanceFunction<metric>()(blocks.data(), numBlocks, query.data(), weights.data(), dim, result);
+    for (unsigned int lane = 0; lane < numBlocks * util::simdBlockSize; ++lane)
+        EXPECT_NEAR(expected[lane], result[lane], 1e-9);
+}
+
+TEST(NEIGHBORFINDERS, simdKernels) {
+    testBlockDistanceKernel<util::SimdMetric::L1>();
+    testBlockDistanceKernel<util::SimdMetric::L2>();
+    testBlockDistanceKernel<util::SimdMetric::Inf>();
+}
+
+template <unsigned int dim, class Metric>
+void testMetricPolicy(const std::shared_ptr<Metric> &metric) {
+    std::srand(7);
+    std::vector<std::shared_ptr<Node<dim>>> nodes;
+    for (size_t i = 0; i < 500; ++i)
+        nodes.push_back(std::make_shared<Node<dim>>(Vector<dim>::Random() * 100));
+
+    // runtime polymorphic metric as reference
+    std::shared_ptr<DistanceMetric<dim>> dynamicMetric = metric;
+    BruteForceNF<dim, std::shared_ptr<Node<dim>>> bruteForce(dynamicMetric, nodes);
+    BruteForceNF<dim, std::shared_ptr<Node<dim>>, Metric> typedBruteForce(metric, nodes);
+    KDTree<dim, std::shared_ptr<Node<dim>>, Metric> typedTree(metric);
+    for (auto &node : nodes)
+        typedTree.addNode(node->getValues(), node);
+    StaticKDTree<dim, std::shared_ptr<Node<dim>>, Metric> typedStaticTree(metric, nodes);
+    ConcurrentKDTree<dim, std::shared_ptr<Node<dim>>, Metric> typedConcurrentTree(metric, nodes);
+
+    auto sorted = [](std::vector<std::shared_ptr<Node<dim>>> list) {
+        std::sort(list.begin(), list.end());
+        return list;
+    };
+    for (size_t i = 0; i < 20; ++i) {
+        Vector<dim> config = Vector<dim>::Random() * 100;
+        auto expected = bruteForce.searchNearestNeighbor(config);
+        EXPECT_EQ(expected, typedBruteForce.searchNearestNeighbor(config));
+        EXPECT_EQ(expected, typedTree.searchNearestNeighbor(config));
+        EXPECT_EQ(expected, typedStaticTree.searchNearestNeighbor(config));
+        EXPECT_EQ(expected, typedConcurrentTree.searchNearestNeighbor(config));
+        EXPECT_EQ(bruteForce.searchKNearest(config, 8), typedTree.searchKNearest(config, 8));
+        EXPECT_EQ(bruteForce.searchKNearest(config, 8), typedStaticTree.searchKNearest(config, 8));
+
+        auto range = sorted(bruteForce.searchRange(nodes[i]->getValues(), 40));
+        EXPECT_EQ(range, sorted(typedBruteForce.searchRange(nodes[i]->getValues(), 40)));
+        EXPECT_EQ(range, sorted(typedTree.searchRange(nodes[i]->getValues(), 40)));
+        EXPECT_EQ(range, sorted(typedStaticTree.searchRange(nodes[i]->getValues(), 40)));
+        EXPECT_EQ(range, sorted(typedConcurrentTree.searchRange(nodes[i]->getValues(), 40)));
+    }
+}
+
+TEST(NEIGHBORFINDERS, metricPolicy) {
+    testMetricPolicy<2>(std::make_shared<L1Metric<2>>());
+    testMetricPolicy<2>(std::make_shared<L2Metric<2>>());
+    testMetricPolicy<2>(std::make_shared<InfMetric<2>>());
+    testMetricPolicy<6>(std::make_shared<WeightedL1Metric<6>>(Vector6::LinSpaced(1, 2)));
+    testMetricPolicy<6>(std::make_shared<WeightedL2Metric<6>>(Vector6::LinSpaced(1, 2)));
+    testMetricPolicy<6>(std::make_shared<WeightedInfMetric<6>>(Vector6::LinSpaced(1, 2)));
+}
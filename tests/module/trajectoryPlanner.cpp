@@ -18,11 +18,19 @@
 
 #include <gtest/gtest.h>
 
+#include <ippp/environment/robot/PointRobot.h>
+#include <ippp/modules/collisionDetection/CollisionDetection2D.hpp>
+#include <ippp/modules/collisionDetection/CollisionDetectionAABB.hpp>
 #include <ippp/modules/collisionDetection/CollisionDetectionPqp.hpp>
+#include <ippp/modules/trajectoryPlanner/ConservativeTrajectory.hpp>
 #include <ippp/modules/trajectoryPlanner/LinearTrajectory.hpp>
+#include <ippp/modules/trajectoryPlanner/TrajectoryCache.hpp>
 #include <ippp/util/Utility.h>
+#include <ippp/environment/robot/KukaKR5.h>
 #include <ippp/environment/robot/MobileRobot.h>
 
+#include "../TestEnvironment.hpp"
+
 using namespace ippp;
 
 TEST(TRAJECTORY, computeTrajectory) {
@@ -65,3 +73,116 @@ TEST(TRAJECTORY, computeTrajectory) {
         dist -= 1 / goal.norm() * 0.1;
     }
 }
+
+TEST(TRAJECTORY, parallelValidation) {
+    Logging::setLogLevel(LogLevel::off);
+    const unsigned int dim = 2;
+    auto environment = test::createTriangleEnvironment();
+
+    std::shared_ptr<CollisionDetection<dim>> collision(new CollisionDetection2D<dim>(environment));
+    LinearTrajectory<dim> serial(collision, environment, 0.1);
+    LinearTrajectory<dim> parallel(collision, environment, 0.1);
+    parallel.setParallelValidation(4, 10);
+    EXPECT_EQ(4, parallel.getParallelThreads());
+    EXPECT_EQ(10, parallel.getParallelLength());
+
+    std::srand(42);
+    for (size_t i = 0; i < 200; ++i) {
+        Vector2 source = Vector2::Random().cwiseAbs() * 99 + Vector2(0.5, 0.5);
+        Vector2 target = Vector2::Random().cwiseAbs() * 99 + Vector2(0.5, 0.5);
+        EXPECT_EQ(serial.checkTrajectory(source, target), parallel.checkTrajectory(source, target));
+    }
+    EXPECT_FALSE(parallel.checkTrajectory(Vector2(10, 50), Vector2(90, 50)));
+    EXPECT_TRUE(parallel.checkTrajectory(Vector2(10, 10), Vector2(90, 10)));
+}
+
+TEST(TRAJECTORY, cache) {
+    Logging::setLogLevel(LogLevel::off);
+    const unsigned int dim = 2;
+    auto environment = test::createTriangleEnvironment();
+
+    std::shared_ptr<CollisionDetection<dim>> collision(new CollisionDetection2D<dim>(environment));
+    auto linear = std::make_shared<LinearTrajectory<dim>>(collision, environment, 0.1);
+    TrajectoryCache<dim> cache(linear, collision, environment, 1000);
+    EXPECT_EQ(linear->getPosRes(), cache.getPosRes());
+
+    std::srand(42);
+    std::vector<std::pair<Vector2, Vector2>> edges;
+    for (size_t i = 0; i < 200; ++i)
+        edges.push_back(std::make_pair(Vector2::Random().cwiseAbs() * 99 + Vector2(0.5, 0.5),
+                                       Vector2::Random().cwiseAbs() * 99 + Vector2(0.5, 0.5)));
+
+    for (auto &edge : edges)
+        EXPECT_EQ(linear->checkTrajectory(edge.first, edge.second), cache.checkTrajectory(edge.first, edge.second));
+    EXPECT_EQ(0, cache.getHits());
+    EXPECT_EQ(edges.size(), cache.getMisses());
+
+    // both directions share one entry
+    for (auto &edge : edges)
+        EXPECT_EQ(linear->checkTrajectory(edge.first, edge.second), cache.checkTrajectory(edge.second, edge.first));
+    EXPECT_EQ(edges.size(), cache.getHits());
+
+    // the Node overloads use the cache as well
+    Node<dim> source(Vector2(10, 50));
+    Node<dim> target(Vector2(90, 50));
+    EXPECT_FALSE(cache.checkTrajectory(source, target));
+    EXPECT_FALSE(cache.checkTrajectory(target, source));
+    EXPECT_EQ(edges.size() + 1, cache.getHits());
+
+    cache.clear();
+    cache.resetCounters();
+    EXPECT_FALSE(cache.checkTrajectory(source, target));
+    EXPECT_EQ(0, cache.getHits());
+    EXPECT_EQ(1, cache.getMisses());
+}
+
+TEST(TRAJECTORY, conservativeAdvancement) {
+    Logging::setLogLevel(LogLevel::off);
+    const unsigned int dim = 2;
+    std::shared_ptr<PointRobot> robot(new PointRobot(std::make_pair(Vector2(0, 0), Vector2(100, 100))));
+    robot->setBaseModel(test::createRectangle(Vector2(-0.05, -0.05), Vector2(0.05, 0.05)));
+    std::shared_ptr<Environment> environment(new Environment(2, AABB(Vector3(0, 0, 0), Vector3(100, 100, 100)), robot));
+    // thin wall and a block
+    environment->addObstacle(test::createRectangle(Vector2(50, 0), Vector2(50.05, 40)));
+    environment->addObstacle(test::createRectangle(Vector2(20, 60), Vector2(30, 80)));
+
+    EXPECT_NEAR(5, robot->getMotionBound(Vector2(0, 0), Vector2(3, 4)), 1e-9);
+
+    std::shared_ptr<CollisionDetection<dim>> collision(new CollisionDetectionAABB<dim>(environment));
+    ConservativeTrajectory<dim> conservative(collision, environment, 1, 0.1, 0.001);
+    LinearTrajectory<dim> linear(collision, environment, 0.01);
+    EXPECT_EQ(0.001, conservative.getMinClearance());
+
+    EXPECT_FALSE(conservative.checkTrajectory(Vector2(10, 20), Vector2(90, 20.3)));
+    EXPECT_TRUE(conservative.checkTrajectory(Vector2(10, 50), Vector2(90, 50)));
+    EXPECT_FALSE(conservative.checkTrajectory(Vector2(10, 70), Vector2(90, 70)));
+
+    // a certified edge is valid for the fine discrete check as well
+    std::srand(42);
+    for (size_t i = 0; i < 200; ++i) {
+        Vector2 source = Vector2::Random().cwiseAbs() * 99 + Vector2(0.5, 0.5);
+        Vector2 target = Vector2::Random().cwiseAbs() * 99 + Vector2(0.5, 0.5);
+        if (conservative.checkTrajectory(source, target))
+            EXPECT_TRUE(linear.checkTrajectory(source, target));
+    }
+
+    // the KukaKR5 angles are passed in degree, the motion bound has to scale them to radian
+    KukaKR5 kuka;
+    Vector6 kukaSource = Vector6::Zero();
+    Vector6 kukaTarget = util::Vecd(90, 0, 0, 0, 0, 0);
+    double radius = std::sqrt(180.0 * 180.0 + 400.0 * 400.0) + 600 + 120 + 620;
+    EXPECT_NEAR(util::halfPi() * radius, kuka.getMotionBound(kukaSource, kukaTarget), 1e-6);
+
+    // no origin of the link frames moves further than the bound
+    for (size_t i = 0; i < 50; ++i) {
+        kukaSource = Vector6::Random() * 180;
+        kukaTarget = Vector6::Random() * 180;
+        double bound = kuka.getMotionBound(kukaSource, kukaTarget);
+        auto startTrafos = kuka.getLinkTrafos(kukaSource);
+        for (double t = 0; t <= 1; t += 0.05) {
+            auto linkTrafos = kuka.getLinkTrafos(kukaSource + t * (kukaTarget - kukaSource));
+            for (size_t link = 0; link < linkTrafos.size(); ++link)
+                EXPECT_GE(bound + 1e-9, (linkTrafos[link].translation() - startTrafos[link].translation()).norm());
+        }
+    }
+}
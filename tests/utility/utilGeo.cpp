@@ -97,3 +97,15 @@ TEST(GEO, radToDeg) {
         EXPECT_TRUE(deg[i] >= temp2[i] - ippp::EPSILON);
     }
 }
+
+TEST(GEO, transformAABB) {
+    AABB aabb(ippp::Vector3(-1, -2, -3), ippp::Vector3(4, 5, 6));
+    for (double angle = 0; angle < 6.3; angle += 0.3) {
+        ippp::Transform T = util::poseVecToTransform(util::Vecd(1, 2, 3, angle, 2 * angle, 3 * angle));
+        AABB transformed = util::transformAABB(aabb, T);
+        for (int corner = 0; corner < 8; ++corner) {
+            ippp::Vector3 point = T * aabb.corner(static_cast<AABB::CornerType>(corner));
+            EXPECT_TRUE(transformed.exteriorDistance(point) < ippp::EPSILON);
+        }
+    }
+}
@@ -0,0 +1,153 @@
+//-------------------------------------------------------------------------//
+//
+// Copyright 2017 Sascha Kaden
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-------------------------------------------------------------------------//
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <ippp/modules/distanceMetrics/L2Metric.hpp>
+#include <ippp/modules/neighborFinders/KDTree.hpp>
+#include <ippp/util/UtilPlanner.hpp>
+
+using namespace ippp;
+
+// grid of nodes with edges to the 8 neighbors, the nodes of the blocked column have no edges except of the last row
+std::shared_ptr<Graph<2>> createGridGraph(const size_t size, const std::shared_ptr<L2Metric<2>> &metric) {
+    auto graph = std::make_shared<Graph<2>>(0, std::make_shared<KDTree<2, std::shared_ptr<Node<2>>>>(metric));
+    for (size_t x = 0; x < size; ++x)
+        for (size_t y = 0; y < size; ++y)
+            graph->addNode(std::make_shared<Node<2>>(Vector2(x + 0.1 * (y % 3), y + 0.1 * (x % 2))));
+
+    auto isBlocked = [size](size_t x, size_t y) { return x == size / 2 && y < size - 1; };
+    for (size_t x = 0; x < size; ++x) {
+        for (size_t y = 0; y < size; ++y) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                for (int dy = -1; dy <= 1; ++dy) {
+                    int nx = static_cast<int>(x) + dx;
+                    int ny = static_cast<int>(y) + dy;
+                    if ((dx == 0 && dy == 0) || nx < 0 || ny < 0 || nx >= static_cast<int>(size) || ny >= static_cast<int>(size))
+                        continue;
+                    if (isBlocked(x, y) || isBlocked(nx, ny))
+                        continue;
+                    auto node = graph->getNode(x * size + y);
+                    auto neighbor = graph->getNode(nx * size + ny);
+                    node->addChild(neighbor, metric->calcDist(node->getValues(), neighbor->getValues()));
+                }
+            }
+        }
+    }
+    return graph;
+}
+
+// reference costs by Dijkstra without heap
+std::vector<double> dijkstra(const std::shared_ptr<Graph<2>> &graph, const std::shared_ptr<Node<2>> &source) {
+    std::vector<double> costs(graph->nodeSize(), std::numeric_limits<double>::max());
+    std::vector<bool> done(graph->nodeSize(), false);
+    costs[source->getId()] = 0;
+    for (size_t i = 0; i < graph->nodeSize(); ++i) {
+        size_t best = graph->nodeSize();
+        for (size_t j = 0; j < graph->nodeSize(); ++j)
+            if (!done[j] && costs[j] < std::numeric_limits<double>::max() && (best == graph->nodeSize() || costs[j] < costs[best]))
+                best = j;
+        if (best == graph->nodeSize())
+            break;
+        done[best] = true;
+        for (auto &edge : graph->getNode(best)->getChildEdges())
+            costs[edge.first->getId()] = std::min(costs[edge.first->getId()], costs[best] + edge.second);
+    }
+    return costs;
+}
+
+double pathCost(const std::vector<std::shared_ptr<Node<2>>> &path, const std::shared_ptr<L2Metric<2>> &metric) {
+    double cost = 0;
+    for (size_t i = 1; i < path.size(); ++i) {
+        EXPECT_TRUE(path[i - 1]->isChild(path[i]));
+        cost += metric->calcDist(path[i - 1]->getValues(), path[i]->getValues());
+    }
+    return cost;
+}
+
+TEST(PLANNER, aStar) {
+    const size_t size = 15;
+    auto metric = std::make_shared<L2Metric<2>>();
+    auto graph = createGridGraph(size, metric);
+    auto source = graph->getNode(0);
+    auto costs = dijkstra(graph, source);
+
+    AStarScratch<2> scratch;
+    for (size_t i = 1; i < graph->nodeSize(); i += 7) {
+        auto target = graph->getNode(i);
+        auto path = util::aStar<2>(source, target, metric, scratch);
+        if (costs[i] == std::numeric_limits<double>::max()) {
+            EXPECT_TRUE(path.empty());
+            continue;
+        }
+        ASSERT_FALSE(path.empty());
+        EXPECT_EQ(path.front(), source);
+        EXPECT_EQ(path.back(), target);
+        EXPECT_NEAR(pathCost(path, metric), costs[i], 1e-9);
+    }
+
+    // the search bound to the final metric type finds the same paths
+    std::shared_ptr<DistanceMetric<2>> baseMetric = metric;
+    auto search = util::makeAStar<2>(baseMetric);
+    for (size_t i = 1; i < graph->nodeSize(); i += 7)
+        EXPECT_EQ(util::aStar<2>(source, graph->getNode(i), search), util::aStar<2>(source, graph->getNode(i), metric));
+
+    // the blocked nodes are not reachable
+    EXPECT_TRUE(util::aStar<2>(source, graph->getNode(size / 2 * size), metric).empty());
+    EXPECT_EQ(util::aStar<2>(source, source, metric).size(), 1);
+
+    // nodes without id can't be searched
+    auto node = std::make_shared<Node<2>>(Vector2(0, 0));
+    EXPECT_TRUE(util::aStar<2>(source, node, metric).empty());
+
+    // the nodes of the graph are not modified by the search
+    for (auto &graphNode : graph->getNodes()) {
+        EXPECT_EQ(graphNode->getQueryParentNode(), nullptr);
+        EXPECT_EQ(graphNode->getCost(), -1);
+    }
+}
+
+TEST(PLANNER, concurrentAStar) {
+    const size_t size = 20;
+    auto metric = std::make_shared<L2Metric<2>>();
+    auto graph = createGridGraph(size, metric);
+    auto costs = dijkstra(graph, graph->getNode(0));
+
+    std::vector<double> results(graph->nodeSize(), -1);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 4; ++t) {
+        threads.push_back(std::thread([&, t]() {
+            for (size_t i = t; i < graph->nodeSize(); i += 4) {
+                auto path = util::aStar<2>(graph->getNode(0), graph->getNode(i), metric);
+                if (!path.empty())
+                    results[i] = pathCost(path, metric);
+            }
+        }));
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    for (size_t i = 0; i < graph->nodeSize(); ++i) {
+        if (costs[i] == std::numeric_limits<double>::max())
+            EXPECT_EQ(results[i], -1);
+        else
+            EXPECT_NEAR(results[i], costs[i], 1e-9);
+    }
+}